@@ -21,6 +21,14 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdatomic.h>
+
+/* The substring search is vectorised on x86-64, where SSE2 is always */
+/* present, and AVX2 is used instead wherever the processor has it.   */
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SUBSTRING_SEARCH_IS_VECTORISED
+#endif
 
 
 #include "xsxml.h"
@@ -40,7 +48,8 @@ It does not cater to the following features:
 
 Though it can parse CDATA and character entity references.
 
-Also note that all alphabetic input and data are case-sensitive.
+Also note that all alphabetic input and data are case-sensitive, except 
+in the searches of an Xsxml_Occurrence_Query that ignore the case.
 */
 
 
@@ -68,6 +77,29 @@ Also note that all alphabetic input and data are case-sensitive.
 
 #define CHARACTER_ENTRY_REFERENCE_MAX_LENGTH    10
 
+#define STRING_ARENA_CHUNK_SIZE                 4096
+
+/* The estimated bookkeeping bytes of the allocator per allocation.       */
+#define ALLOCATION_OVERHEAD                     (2 * sizeof(size_t))
+
+/* The symbols of a pattern are the bytes, along with the start and the  */
+/* end of the text, which are read as symbols of their own.              */
+#define PATTERN_NUMBER_OF_SYMBOLS               258
+
+#define PATTERN_TEXT_START                      256
+
+#define PATTERN_TEXT_END                        257
+
+#define PATTERN_SYMBOL_SET_SIZE                 ((PATTERN_NUMBER_OF_SYMBOLS + 7) / 8)
+
+#define PATTERN_MAX_NFA_STATES                  4096
+
+#define PATTERN_MAX_DFA_STATES                  2048
+
+#define PATTERN_MAX_REPETITIONS                 255
+
+#define PATTERN_MAX_NESTING                     64
+
 
 typedef enum Xml_Data_Access_Mode
 {
@@ -82,7 +114,8 @@ typedef enum Xsxml_Parse_Mode
     XSXML_TAG, 
     XSXML_ATTRIBUTE_NAME, 
     XSXML_ATTRIBUTE_VALUE, 
-    XSXML_PCDATA_CONTENT
+    XSXML_PCDATA_CONTENT, 
+    XSXML_END_TAG
 
 } Xsxml_Parse_Mode;
 
@@ -91,11 +124,11 @@ typedef struct Xsxml_Char_File_IO
 {
     char *temporary_dir_path;
     char *temporary_file_name;
-    unsigned int node_i_value;
+    size_t node_i_value;
     char *property_term;
-    unsigned int node_j_value;
+    size_t node_j_value;
     char *data_str;
-    unsigned int data_int;
+    size_t data_int;
 
 } Xsxml_Char_File_IO;
 
@@ -108,9 +141,188 @@ typedef struct Xsxml_Private_Result
 } Xsxml_Private_Result;
 
 
-static const char *PROPERTY_NAMES_LIST[11] = 
+/* When parsing lazily, the characters of a content are not copied into */
+/* the word. Instead, the range of the content within the source is     */
+/* tracked here, while the word length is still kept up to date.        */
+typedef struct Xsxml_Lazy_Word
+{
+    int is_enabled;
+
+    size_t offset;
+    size_t end_offset;
+    size_t space_offset;
+
+    int ends_with_space;
+    int needs_decoding;
+
+    /* The number of characters of '<![CDATA[' matched thus far. */
+    int nested_cdata_i;
+    int has_nested_cdata;
+
+} Xsxml_Lazy_Word;
+
+
+/* Short strings are packed into fixed-size chunks, whereas long strings   */
+/* are allocated separately, and only tracked here so as to be freed.      */
+struct Xsxml_String_Arena
+{
+    char **chunk;
+    size_t number_of_chunks;
+    size_t chunk_used;
+
+    /* The size of the last chunk, which exceeds STRING_ARENA_CHUNK_SIZE */
+    /* only if the chunk has been reserved in bulk.                      */
+    size_t chunk_size;
+
+    char **long_string;
+    size_t number_of_long_strings;
+    size_t long_string_capacity;
+
+    /* The allocated sizes of the long strings. */
+    size_t *long_string_size;
+
+    /* The chunks and long strings kept for reuse whilst the object is   */
+    /* refilled by the xsxml_parse_into() function. They follow the ones */
+    /* in use within their lists.                                        */
+    size_t number_of_spare_chunks;
+    size_t number_of_spare_long_strings;
+
+    /* Set once a chunk of another size than STRING_ARENA_CHUNK_SIZE is */
+    /* reserved, after which the chunks are no longer reused.           */
+    int has_bulk_chunks;
+
+    /* The bytes allocated by the arena, whether used or not. */
+    size_t reserved_bytes;
+
+    /* The number of Xsxml objects, including snapshots, sharing the arena. */
+    atomic_size_t reference_count;
+
+};
+
+
+/* An open-addressing hash table that maps keys to identifiers (ids).     */
+/* The keys themselves are not stored; the caller compares them instead.  */
+struct Xsxml_Name_Table
+{
+    size_t capacity;
+    size_t number_of_entries;
+
+    /* The entry ids plus one (+1), where zero (0) denotes an empty slot. */
+    size_t *entry;
+    size_t *hash;
+
+};
+
+
+/* The state of an object being refilled by the xsxml_parse_into() function. */
+struct Xsxml_Parse_Context
+{
+    /* The nodes of the previous document, which are kept at their indices */
+    /* within the node array, to be reused in the same order.              */
+    size_t number_of_spare_nodes;
+
+    /* The node array grows geometrically, since it is reused as well. */
+    size_t node_capacity;
+
+};
+
+
+/* The nodes inserted since the last renumbering are appended to the node */
+/* array, which then grows geometrically, whereas the removed subtrees    */
+/* are unlinked at once, but only freed upon the next renumbering.        */
+struct Xsxml_Edit_State
+{
+    int is_out_of_order;
+
+    /* The nodes before this index have kept their indices and subtree */
+    /* ends since the last renumbering, and so are not renumbered.     */
+    size_t first_out_of_order_node;
+
+    size_t node_capacity;
+
+    Xsxml_Nodes **removed_subtree;
+    size_t number_of_removed_subtrees;
+    size_t removed_subtree_capacity;
+    size_t number_of_removed_nodes;
+
+};
+
+
+/* The nodes of an Xsxml object at the time of its latest snapshot, which */
+/* are shared by the object, until its next edit, and its snapshots.      */
+struct Xsxml_Shared_Version
+{
+    atomic_size_t reference_count;
+
+    Xsxml_Nodes **node;
+    size_t number_of_nodes;
+
+    /* The columnar form of the nodes, if built before the first snapshot. */
+    Xsxml_Columns *columns;
+
+};
+
+
+typedef enum Xsxml_Query_Axis
+{
+    XSXML_QUERY_AXIS_CHILD      = 0,    /* /  */
+    XSXML_QUERY_AXIS_DESCENDANT = 1     /* // */
+
+} Xsxml_Query_Axis;
+
+
+typedef enum Xsxml_Query_Predicate_Kind
+{
+    XSXML_QUERY_PREDICATE_ATTRIBUTE = 0,    /* [@name] or [@name='value'] */
+    XSXML_QUERY_PREDICATE_POSITION  = 1,    /* [n]                        */
+    XSXML_QUERY_PREDICATE_LAST      = 2     /* [last()]                   */
+
+} Xsxml_Query_Predicate_Kind;
+
+
+/* The strings point into the path of the query, and are not null-terminated. */
+struct Xsxml_Query_Predicate
+{
+    Xsxml_Query_Predicate_Kind kind;
+
+    const char *attribute_name;
+    size_t attribute_name_length;
+
+    /* NULL if the attribute may have any value. */
+    const char *attribute_value;
+    size_t attribute_value_length;
+
+    size_t position;
+
+};
+
+
+/* The predicates of a step are in the range                             */
+/* [ predicate_start, predicate_start + number_of_predicates ).          */
+struct Xsxml_Query_Step
+{
+    Xsxml_Query_Axis axis;
+
+    /* NULL if the step selects any tag name. */
+    const char *tag_name;
+    size_t tag_name_length;
+
+    size_t predicate_start;
+    size_t number_of_predicates;
+
+    int has_positional_predicates;
+
+};
+
+
+typedef int (*Xsxml_Name_Table_Equals)( const void *context, 
+                                        size_t id, 
+                                        const void *key);
+
+
+static const char *PROPERTY_NAMES_LIST[12] = 
 {
-    "nn", "l", "cN", "aN", "c", "an", "av", "a", "d", "ns", "ps"
+    "nn", "l", "cN", "aN", "c", "an", "av", "a", "d", "ns", "ps", "se"
 
 };
 
@@ -146,14 +358,23 @@ static int delete_char_file( const char *dir_path,
 }
 
 
+/* The word's capacity is doubled as needed, and kept across its resets, */
+/* so that it is only reallocated a few times within a whole parse.       */
 static void append_character_to_word( char **word, 
                                       const char character, 
-                                      int *word_len)
+                                      size_t *word_len, 
+                                      size_t *word_capacity)
 {
     /* The below code is just a test code for debugging purposes.     */
     /* printf("\n(%s), (%c), and %d\n", *word, character, *word_len); */
 
-    *word = (char *) realloc(*word, ++(*word_len) + 1);
+    /* The plus one (+1) is for the char array's null terminator. */
+    if (++(*word_len) + 1 > *word_capacity)
+    {
+        *word_capacity = 2 * ((*word_len) + 1);
+
+        *word = (char *) realloc(*word, *word_capacity);
+    }
 
     if (isalpha(character))
     {
@@ -165,14 +386,63 @@ static void append_character_to_word( char **word,
 }
 
 
-static void reset_word(char **word, int *word_len)
+static void reset_word(char **word, size_t *word_len)
 {
-    *word     = (char *) realloc(*word, 1);
    (*word)[0] = 0;
 
     *word_len = 0;
 }
 
+
+static void reset_lazy_word(Xsxml_Lazy_Word *lazy_word)
+{
+    lazy_word->ends_with_space  = 0;
+    lazy_word->needs_decoding   = 0;
+    lazy_word->nested_cdata_i   = 0;
+    lazy_word->has_nested_cdata = 0;
+}
+
+
+/* The content starts at the run offset, if the character is its first. */
+static void append_character_to_content( char **word, 
+                                         const char character, 
+                                         size_t *word_len, 
+                                         size_t *word_capacity, 
+                                         Xsxml_Lazy_Word *lazy_word, 
+                                         size_t run_offset, 
+                                         size_t source_offset, 
+                                         int needs_decoding)
+{
+    if (!lazy_word->is_enabled)
+    {
+        append_character_to_word(word, character, word_len, word_capacity);
+        return;
+    }
+
+    const char *NESTED_CDATA = "<![CDATA[";
+
+    if ((*word_len)++ == 0) lazy_word->offset = run_offset;
+
+    lazy_word->end_offset      = source_offset + 1;
+    lazy_word->space_offset    = source_offset;
+    lazy_word->ends_with_space = (character == ' ');
+
+    if (needs_decoding) lazy_word->needs_decoding = 1;
+
+    if (character == NESTED_CDATA[lazy_word->nested_cdata_i])
+    {
+        if (++lazy_word->nested_cdata_i == 9)
+        {
+            lazy_word->nested_cdata_i   = 0;
+            lazy_word->has_nested_cdata = 1;
+        }
+    }
+    else
+    {
+        lazy_word->nested_cdata_i = (character == '<') ? 1 : 0;
+    }
+}
+
 static int parse_cer(char **character_entry_reference)
 {
     const char *BASE_ENTITY_REFERENCES[2][5] = 
@@ -264,2214 +534,9312 @@ static int parse_cer(char **character_entry_reference)
 }
 
 
-static void xsxml_unset_node(Xsxml_Nodes **xsxml_node)
+static Xsxml_String_Arena *get_string_arena(Xsxml *xsxml_object)
 {
-    if ((*xsxml_node) != NULL)
+    if (xsxml_object->string_arena == NULL)
     {
-        if ((*xsxml_node)->node_name != NULL)
-        {
-            free((*xsxml_node)->node_name);
+        xsxml_object->string_arena = 
+        (Xsxml_String_Arena *) calloc(1, sizeof(Xsxml_String_Arena));
+
+        xsxml_object->string_arena->reserved_bytes = sizeof(Xsxml_String_Arena);
+
+        atomic_init(&xsxml_object->string_arena->reference_count, 1);
+
+        xsxml_object->memory_usage.number_of_allocations++;
+    }
+
+    return xsxml_object->string_arena;
+}
 
-            (*xsxml_node)->node_name = NULL;
-        }
 
-        for (unsigned int j = 0; j < (*xsxml_node)->number_of_contents; j++)
+char *xsxml_copy_string( Xsxml *xsxml_object, 
+                         const char *data, 
+                         size_t data_length)
+{
+    Xsxml_String_Arena *arena = get_string_arena(xsxml_object);
+
+    char *string;
+
+    if (data_length < XSXML_SHORT_STRING_SIZE)
+    {
+        /* The plus one (+1) is for the char array's null terminator. */
+        if ((arena->number_of_chunks == 0) 
+        ||  (arena->chunk_used + data_length + 1 > arena->chunk_size))
         {
-            if ((*xsxml_node)->content[j] != NULL)
+            if (arena->number_of_spare_chunks > 0)
             {
-                free((*xsxml_node)->content[j]);
+                /* The next spare chunk already follows the chunks in use. */
+                arena->number_of_spare_chunks--;
+                arena->number_of_chunks++;
+            }
+            else /* if (arena->number_of_spare_chunks == 0) */
+            {
+                arena->chunk = 
+                (char **) realloc( arena->chunk, 
+                                   (arena->number_of_chunks + 1) * sizeof(char *));
 
-                (*xsxml_node)->content[j] = NULL;
+                arena->chunk[arena->number_of_chunks++] = 
+                (char *) malloc(STRING_ARENA_CHUNK_SIZE);
             }
+
+            arena->chunk_used = 0;
+            arena->chunk_size = STRING_ARENA_CHUNK_SIZE;
+
+            arena->reserved_bytes += STRING_ARENA_CHUNK_SIZE + sizeof(char *);
+
+            /* The chunk list is allocated along with the first chunk. */
+            xsxml_object->memory_usage.number_of_allocations += 
+                (arena->number_of_chunks == 1) ? 2 : 1;
         }
 
-        for (unsigned int j = 0; j < (*xsxml_node)->number_of_attributes; j++)
+        string = &arena->chunk[arena->number_of_chunks - 1][arena->chunk_used];
+
+        arena->chunk_used += data_length + 1;
+    }
+    else /* if (data_length >= XSXML_SHORT_STRING_SIZE) */
+    {
+        const size_t k = arena->number_of_long_strings++;
+
+        if (arena->number_of_spare_long_strings > 0)
         {
-            if ((*xsxml_node)->attribute_name[j] != NULL)
+            /* The next spare long string is only grown if too short. */
+            arena->number_of_spare_long_strings--;
+
+            if (arena->long_string_size[k] < data_length + 1)
             {
-                free((*xsxml_node)->attribute_name[j]);
+                arena->long_string[k] = 
+                (char *) realloc(arena->long_string[k], data_length + 1);
 
-                (*xsxml_node)->attribute_name[j] = NULL;
+                arena->long_string_size[k] = data_length + 1;
             }
-
-            if ((*xsxml_node)->attribute_value[j] != NULL)
+        }
+        else /* if (arena->number_of_spare_long_strings == 0) */
+        {
+            if (k == arena->long_string_capacity)
             {
-                free((*xsxml_node)->attribute_value[j]);
+                /* The two lists are allocated along with the first string. */
+                if (arena->long_string_capacity == 0)
+                {
+                    xsxml_object->memory_usage.number_of_allocations += 2;
+                }
+
+                arena->reserved_bytes += 
+                    (arena->long_string_capacity + 1) * (sizeof(char *) + sizeof(size_t));
 
-                (*xsxml_node)->attribute_value[j] = NULL;
+                arena->long_string_capacity = 2 * arena->long_string_capacity + 1;
+
+                arena->long_string = 
+                (char **) realloc( arena->long_string, 
+                                   arena->long_string_capacity * sizeof(char *));
+
+                arena->long_string_size = 
+                (size_t *) realloc( arena->long_string_size, 
+                                    arena->long_string_capacity * sizeof(size_t));
             }
+
+            /* The plus one (+1) is for the char array's null terminator. */
+            arena->long_string     [k] = (char *) malloc(data_length + 1);
+            arena->long_string_size[k] = data_length + 1;
         }
 
-        (*xsxml_node)->ancestor         = NULL;
-        (*xsxml_node)->descendant       = NULL;
-        (*xsxml_node)->next_sibling     = NULL;
-        (*xsxml_node)->previous_sibling = NULL;
+        string = arena->long_string[k];
 
-        free(*xsxml_node);
+        arena->reserved_bytes += arena->long_string_size[k];
 
-        *xsxml_node = NULL;
+        xsxml_object->memory_usage.number_of_allocations++;
     }
+
+    memcpy(&string[0], &data[0], data_length);
+
+    string[data_length] = 0;
+
+    return string;
 }
 
 
-void xsxml_unset(Xsxml **xsxml_object)
+/* Adds a chunk of the given size to the string arena, and returns it.    */
+/* The whole chunk is marked as used, and is filled in by the caller, so   */
+/* that strings of any length can be stored in a single allocation.       */
+static char *reserve_string_arena_chunk( Xsxml *xsxml_object, 
+                                         size_t chunk_size)
 {
-    if (*xsxml_object != NULL)
-    {
-        if ((*xsxml_object)->result_message != NULL)
-        {
-            free((*xsxml_object)->result_message);
+    Xsxml_String_Arena *arena = get_string_arena(xsxml_object);
 
-            (*xsxml_object)->result_message = NULL;
-        }
+    arena->chunk = 
+    (char **) realloc( arena->chunk, 
+                       (arena->number_of_chunks + 1) * sizeof(char *));
 
-        for (unsigned int i = 0; i < (*xsxml_object)->number_of_nodes; i++)
-        {
-            xsxml_unset_node(&(*xsxml_object)->node[i]);
-        }
+    arena->chunk[arena->number_of_chunks++] = (char *) malloc(chunk_size);
 
-        free((*xsxml_object)->node);
+    arena->chunk_used = chunk_size;
+    arena->chunk_size = chunk_size;
 
-        (*xsxml_object)->node = NULL;
+    arena->has_bulk_chunks = 1;
 
-        free(*xsxml_object);
+    arena->reserved_bytes += chunk_size + sizeof(char *);
 
-        *xsxml_object = NULL;
+    xsxml_object->memory_usage.number_of_allocations += 
+        (arena->number_of_chunks == 1) ? 2 : 1;
+
+    return arena->chunk[arena->number_of_chunks - 1];
+}
+
+
+void xsxml_set_node_name( Xsxml *xsxml_object, 
+                          Xsxml_Nodes *xsxml_node, 
+                          const char *node_name, 
+                          size_t node_name_length)
+{
+    if (node_name_length < XSXML_SHORT_STRING_SIZE)
+    {
+        memcpy( &xsxml_node->node_name_inline[0], 
+                &node_name[0], 
+                node_name_length);
+
+        xsxml_node->node_name_inline[node_name_length] = 0;
+
+        xsxml_node->node_name = &xsxml_node->node_name_inline[0];
+    }
+    else /* if (node_name_length >= XSXML_SHORT_STRING_SIZE) */
+    {
+        xsxml_node->node_name = xsxml_copy_string( xsxml_object, 
+                                                   node_name, 
+                                                   node_name_length);
+
+        xsxml_object->memory_usage.name_bytes += node_name_length + 1;
     }
+
+    xsxml_node->node_name_length = node_name_length;
 }
 
 
-void xsxml_files_unset(Xsxml_Files **xsxml_files_object)
+/* The arena is only freed once the last object sharing it is unset. */
+static void xsxml_unset_string_arena(Xsxml_String_Arena **arena)
 {
-    if (*xsxml_files_object != NULL)
+    if (((*arena) != NULL) && (atomic_fetch_sub(&(*arena)->reference_count, 1) == 1))
     {
-        if ((*xsxml_files_object)->result_message != NULL)
+        for (size_t i = 0; i < (*arena)->number_of_chunks; i++)
         {
-            free((*xsxml_files_object)->result_message);
-
-            (*xsxml_files_object)->result_message = NULL;
+            free((*arena)->chunk[i]);
         }
 
-        if (((*xsxml_files_object)->node_file_name  != NULL) 
-        &&  ((*xsxml_files_object)->number_of_nodes != 0))
+        for (size_t i = 0; i < (*arena)->number_of_long_strings; i++)
         {
-            const size_t MAX_I_STR_LEN = (int)log10((*xsxml_files_object)->number_of_nodes) 
-                                       + 1;
-
-            /* The plus one (+2) denotes the two (2) periods (.).             */
-            const int FILE_NAME_PREFIX_LEN = NODE_FILE_NAME_SIZE + 2;
+            free((*arena)->long_string[i]);
+        }
 
-            /* The value four (4) values denotes the four periods (.) in      */
-            /* a file name, whereas the value two (2) denotes the maximum     */
-            /* length of alphabetical extension (.am, .av, .ps, and .ns).     */
-            const int MAX_FILE_NAME_LEN = MAX_ATTRIBUTES_POSSIBLE_N_DIGITS 
-                                        + FILE_NAME_PREFIX_LEN 
-                                        + MAX_I_STR_LEN 
-                                        + 4 
-                                        + 2;
+        free((*arena)->chunk);
+        free((*arena)->long_string);
+        free((*arena)->long_string_size);
 
-            char file_name_prefix [FILE_NAME_PREFIX_LEN];
+        free(*arena);
+    }
 
-            file_name_prefix [0] = '.';
-            file_name_prefix [ FILE_NAME_PREFIX_LEN - 1 ] = '.';
+    *arena = NULL;
+}
 
-            memcpy( &file_name_prefix[1], 
-                    &(*xsxml_files_object)->node_file_name[0], 
-                    NODE_FILE_NAME_SIZE);
 
-            for (unsigned int i = 0; i < (*xsxml_files_object)->number_of_nodes; i++)
-            {
-                size_t I_STR_LEN;
-                if (i == 0)
-                    I_STR_LEN = 1;
-                else
-                    I_STR_LEN = (int)log10(i) + 1;
+/* Marks all the strings of the arena as unused, whilst keeping its chunks */
+/* and long strings as spares, to be refilled in the same order.           */
+static void reset_string_arena(Xsxml *xsxml_object)
+{
+    Xsxml_String_Arena *arena = xsxml_object->string_arena;
 
-                /* The plus one (+1) is for the char array's null terminator. */
-                char file_name [MAX_FILE_NAME_LEN + 1];
+    arena->number_of_spare_chunks += arena->number_of_chunks;
+    arena->number_of_chunks        = 0;
 
-                file_name [MAX_FILE_NAME_LEN] = 0;
+    arena->number_of_spare_long_strings += arena->number_of_long_strings;
+    arena->number_of_long_strings        = 0;
 
-                memcpy( &file_name[0], 
-                        &file_name_prefix[0], 
-                        FILE_NAME_PREFIX_LEN);
+    arena->chunk_used = 0;
+    arena->chunk_size = 0;
 
-                sprintf(&file_name[FILE_NAME_PREFIX_LEN], "%d", i);
+    arena->reserved_bytes = sizeof(Xsxml_String_Arena) 
+                          + arena->long_string_capacity * (sizeof(char *) + sizeof(size_t));
 
-                int dummy_val;
+    /* The arena, and its two long string lists, if any. */
+    xsxml_object->memory_usage.number_of_allocations += 
+        (arena->long_string_capacity > 0) ? 3 : 1;
+}
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN] = '.';
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 0;
+/* Frees the spare chunks and long strings that have not been reused. */
+static void trim_string_arena(Xsxml_String_Arena *arena)
+{
+    for (size_t i = 0; i < arena->number_of_spare_chunks; i++)
+    {
+        free(arena->chunk[arena->number_of_chunks + i]);
+    }
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
+    for (size_t i = 0; i < arena->number_of_spare_long_strings; i++)
+    {
+        free(arena->long_string[arena->number_of_long_strings + i]);
+    }
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+    arena->number_of_spare_chunks       = 0;
+    arena->number_of_spare_long_strings = 0;
+}
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'd';
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+/* The 64-bit FNV-1a hash function. */
+static size_t hash_string(const char *string, size_t hash)
+{
+    if (hash == 0) hash = (size_t) 14695981039346656037ULL;
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'l';
+    while (*string != 0)
+    {
+        hash ^= (unsigned char) *string++;
+        hash *= (size_t) 1099511628211ULL;
+    }
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+    return hash;
+}
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 3] = 0;
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'N';
+static Xsxml_Name_Table *new_name_table(void)
+{
+    Xsxml_Name_Table *table = (Xsxml_Name_Table *) malloc(sizeof(Xsxml_Name_Table));
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+    table->capacity          = 16;
+    table->number_of_entries = 0;
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'c';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'N';
+    table->entry = (size_t *) calloc(table->capacity, sizeof(size_t));
+    table->hash  = (size_t *) malloc(table->capacity * sizeof(size_t));
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+    return table;
+}
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'p';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 's';
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
-
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'n';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 's';
-
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
-
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'n';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'n';
+static void xsxml_unset_name_table(Xsxml_Name_Table **table)
+{
+    if ((*table) != NULL)
+    {
+        free((*table)->entry);
+        free((*table)->hash);
 
-                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                file_name);
+        free(*table);
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 3] = '.';
+        *table = NULL;
+    }
+}
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'n';
 
-                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
-                {
-                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 4], "%d", j);
+static size_t name_table_find( const Xsxml_Name_Table *table, 
+                               size_t hash, 
+                               Xsxml_Name_Table_Equals equals, 
+                               const void *context, 
+                               const void *key)
+{
+    size_t slot = hash & (table->capacity - 1);
 
-                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                    file_name);
+    while (table->entry[slot] != 0)
+    {
+        if ((table->hash[slot] == hash) 
+        &&  equals(context, table->entry[slot] - 1, key))
+        {
+            return table->entry[slot] - 1;
+        }
 
-                    if (dummy_val == -1) break;
-                }
+        slot = (slot + 1) & (table->capacity - 1);
+    }
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'v';
+    return XSXML_NO_NODE;
+}
 
-                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
-                {
-                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 4], "%d", j);
 
-                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                    file_name);
+static void name_table_insert( Xsxml_Name_Table *table, 
+                               size_t hash, 
+                               size_t id)
+{
+    /* The table is kept at most half full. */
+    if (2 * (table->number_of_entries + 1) > table->capacity)
+    {
+        const size_t OLD_CAPACITY = table->capacity;
 
-                    if (dummy_val == -1) break;
-                }
+        size_t *old_entry = table->entry;
+        size_t *old_hash  = table->hash;
 
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'c';
-                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = '.';
+        table->capacity *= 2;
 
-                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
-                {
-                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 3], "%d", j);
+        table->entry = (size_t *) calloc(table->capacity, sizeof(size_t));
+        table->hash  = (size_t *) malloc(table->capacity * sizeof(size_t));
 
-                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
-                                                    file_name);
+        for (size_t i = 0; i < OLD_CAPACITY; i++)
+        {
+            if (old_entry[i] == 0) continue;
 
-                    if (dummy_val == -1) break;
-                }
-            }
+            size_t slot = old_hash[i] & (table->capacity - 1);
 
-            free((*xsxml_files_object)->node_file_name);
+            while (table->entry[slot] != 0) slot = (slot + 1) & (table->capacity - 1);
 
-            (*xsxml_files_object)->node_file_name = NULL;
+            table->entry[slot] = old_entry[i];
+            table->hash [slot] = old_hash[i];
         }
 
-        if ((*xsxml_files_object)->node_directory_path != NULL)
-        {
-            free((*xsxml_files_object)->node_directory_path);
+        free(old_entry);
+        free(old_hash);
+    }
 
-            (*xsxml_files_object)->node_directory_path = NULL;
-        }
+    size_t slot = hash & (table->capacity - 1);
 
-        free(*xsxml_files_object);
+    while (table->entry[slot] != 0) slot = (slot + 1) & (table->capacity - 1);
 
-        *xsxml_files_object = NULL;
-    }
+    table->entry[slot] = id + 1;
+    table->hash [slot] = hash;
+
+    table->number_of_entries++;
 }
 
 
-static int parse_sub_operation_ram_mode( Xsxml **xsxml_object, 
-                                         Xsxml_Parse_Mode parse_mode, 
-                                         unsigned int node_level, 
-                                         char *data)
+/* The node's strings belong to the string arena, and are not freed here. */
+static void xsxml_unset_node(Xsxml_Nodes **xsxml_node)
 {
-    const size_t DATA_LEN = strlen(data);
-
-    const size_t n = (*xsxml_object)->number_of_nodes;
-
-    if (parse_mode == XSXML_TAG)
+    if ((*xsxml_node) != NULL)
     {
-        if (node_level == 0)
-        {
-            if ((*xsxml_object)->number_of_nodes > 0) return 0;
-        }
+        free((*xsxml_node)->content);
+        free((*xsxml_node)->attribute_name);
+        free((*xsxml_node)->attribute_value);
 
-        (*xsxml_object)->number_of_nodes++;
+        free((*xsxml_node)->content_length);
+        free((*xsxml_node)->attribute_name_length);
+        free((*xsxml_node)->attribute_value_length);
 
-        (*xsxml_object)->node = 
-        (Xsxml_Nodes **) realloc( (*xsxml_object)->node, 
-                                  (n + 1) * sizeof(Xsxml_Nodes *));
+        free((*xsxml_node)->lazy_content);
 
-        (*xsxml_object)->node[n] = (Xsxml_Nodes *) malloc(sizeof(Xsxml_Nodes));
+        (*xsxml_node)->node_name       = NULL;
+        (*xsxml_node)->content         = NULL;
+        (*xsxml_node)->attribute_name  = NULL;
+        (*xsxml_node)->attribute_value = NULL;
 
-        (*xsxml_object)->node[n]->node_name = (char *) malloc (DATA_LEN + 1);
+        (*xsxml_node)->content_length         = NULL;
+        (*xsxml_node)->attribute_name_length  = NULL;
+        (*xsxml_node)->attribute_value_length = NULL;
 
-        (*xsxml_object)->node[n]->node_name[DATA_LEN] = 0;
+        (*xsxml_node)->lazy_content = NULL;
 
-        memcpy( &(*xsxml_object)->node[n]->node_name[0], 
-                &data[0], 
-                DATA_LEN);
+        (*xsxml_node)->ancestor         = NULL;
+        (*xsxml_node)->descendant       = NULL;
+        (*xsxml_node)->next_sibling     = NULL;
+        (*xsxml_node)->previous_sibling = NULL;
 
-        (*xsxml_object)->node[n]->attribute_name = (char **) malloc(sizeof(char *));
+        free(*xsxml_node);
 
-        (*xsxml_object)->node[n]->attribute_value = (char **) malloc(sizeof(char *));
+        *xsxml_node = NULL;
+    }
+}
 
-        (*xsxml_object)->node[n]->content = (char **) malloc(sizeof(char *));
 
-        (*xsxml_object)->node[n]->depth = node_level;
-        (*xsxml_object)->node[n]->number_of_contents   = 0;
-        (*xsxml_object)->node[n]->number_of_attributes = 0;
+static void xsxml_unset_children(Xsxml_Children **children)
+{
+    if ((*children) != NULL)
+    {
+        free((*children)->child_start);
+        free((*children)->child);
 
-        (*xsxml_object)->node[n]->descendant   = NULL;
-        (*xsxml_object)->node[n]->next_sibling = NULL;
+        free(*children);
 
-        if (node_level != 0)
-        {
-            if ((*xsxml_object)->node[n-1]->depth == node_level)
-            {
-                (*xsxml_object)->node[n]->previous_sibling = (*xsxml_object)->node[n-1];
-                (*xsxml_object)->node[n-1]->next_sibling   = (*xsxml_object)->node[n];
+        *children = NULL;
+    }
+}
 
-                (*xsxml_object)->node[n]->ancestor = (*xsxml_object)->node[n-1]->ancestor;
-            }
-            else
-            {
-                (*xsxml_object)->node[n]->ancestor     = (*xsxml_object)->node[n-1];
-                (*xsxml_object)->node[n-1]->descendant = (*xsxml_object)->node[n];
 
-                for (int i = n - 1; i >= 0; i--)
-                {
-                    if ((*xsxml_object)->node[i]->depth == node_level)
-                    {
-                        (*xsxml_object)->node[n]->previous_sibling = (*xsxml_object)->node[i];
-                        (*xsxml_object)->node[i]->next_sibling     = (*xsxml_object)->node[n];
-                        break;
-                    }
-                }
-            }
-        }
-        else /* if (node_level == 0) */
-        {
-            (*xsxml_object)->node[n]->ancestor         = NULL;
-            (*xsxml_object)->node[n]->previous_sibling = NULL;
-        }
-    }
-    else if (parse_mode == XSXML_ATTRIBUTE_NAME)
+static void xsxml_unset_tag_index(Xsxml_Tag_Index **tag_index)
+{
+    if ((*tag_index) != NULL)
     {
-        const size_t n_a = (*xsxml_object)->node[n-1]->number_of_attributes;
-
-        for (unsigned int i = 0; i < n_a; i++)
-        {
-            if (strcmp( (const char*)  data, 
-                        (const char*) ((*xsxml_object)->node[n-1]->attribute_name[i]) ) == 0)
-            {
-                return 0;
-            }
-        }
+        free((*tag_index)->node_start);
+        free((*tag_index)->node);
 
-        (*xsxml_object)->node[n-1]->number_of_attributes++;
+        xsxml_unset_name_table(&(*tag_index)->name_table);
 
-        (*xsxml_object)->node[n-1]->attribute_name = 
-        (char **) realloc( (*xsxml_object)->node[n-1]->attribute_name, 
-                           (n_a + 1) * sizeof(char *));
+        free(*tag_index);
 
-        (*xsxml_object)->node[n-1]->attribute_name[n_a] = (char *) malloc(DATA_LEN + 1);
+        *tag_index = NULL;
+    }
+}
 
-        (*xsxml_object)->node[n-1]->attribute_name[n_a][DATA_LEN] = 0;
 
-        memcpy( &(*xsxml_object)->node[n-1]->attribute_name[n_a][0], 
-                &data[0], 
-                DATA_LEN);
-    }
-    else if (parse_mode == XSXML_ATTRIBUTE_VALUE)
+static void xsxml_unset_attribute_index(Xsxml_Attribute_Index **attribute_index)
+{
+    if ((*attribute_index) != NULL)
     {
-        const size_t n_a = (*xsxml_object)->node[n-1]->number_of_attributes;
-
-        (*xsxml_object)->node[n-1]->attribute_value = 
-        (char **) realloc( (*xsxml_object)->node[n-1]->attribute_value, 
-                             n_a * sizeof(char *));
+        free((*attribute_index)->node_start);
+        free((*attribute_index)->node);
+        free((*attribute_index)->first_attribute);
 
-        (*xsxml_object)->node[n-1]->attribute_value[n_a-1] = (char *) malloc(DATA_LEN + 1);
+        xsxml_unset_name_table(&(*attribute_index)->name_table);
 
-        (*xsxml_object)->node[n-1]->attribute_value[n_a-1][DATA_LEN] = 0;
+        free(*attribute_index);
 
-        memcpy( &(*xsxml_object)->node[n-1]->attribute_value[n_a-1][0], 
-                &data[0], 
-                DATA_LEN);
+        *attribute_index = NULL;
     }
-    else if (parse_mode == XSXML_PCDATA_CONTENT)
-    {
-        const int is_within_current_tag = node_level;
-
-        Xsxml_Nodes *this_node;
+}
 
-        if (is_within_current_tag) this_node = (*xsxml_object)->node[n-1];
-        else                       this_node = (*xsxml_object)->node[n-1]->ancestor;
 
-        const size_t n_c = this_node->number_of_contents;
+static void xsxml_unset_content_index(Xsxml_Content_Index **content_index)
+{
+    if ((*content_index) != NULL)
+    {
+        free((*content_index)->trigram);
+        free((*content_index)->node_start);
+        free((*content_index)->node);
 
-        this_node->number_of_contents++;
+        xsxml_unset_name_table(&(*content_index)->name_table);
 
-        this_node->content = 
-        (char **) realloc( this_node->content, 
-                           (n_c + 1) * sizeof(char *));
+        free(*content_index);
 
-        this_node->content[n_c] = (char *) malloc(DATA_LEN + 1);
+        *content_index = NULL;
+    }
+}
 
-        this_node->content[n_c][DATA_LEN] = 0;
 
-        memcpy( &this_node->content[n_c][0], 
-                &data[0], 
-                DATA_LEN);
+static void xsxml_unset_columns(Xsxml_Columns **columns)
+{
+    if ((*columns) != NULL)
+    {
+        free((*columns)->name);
+        free((*columns)->depth);
+        free((*columns)->name_id);
+        free((*columns)->parent);
+        free((*columns)->attribute_start);
+        free((*columns)->attribute_name);
+        free((*columns)->attribute_value);
+        free((*columns)->content_start);
+        free((*columns)->content);
+        free((*columns)->attribute_name_length);
+        free((*columns)->attribute_value_length);
+        free((*columns)->content_length);
+
+        xsxml_unset_name_table(&(*columns)->name_table);
+
+        free(*columns);
+
+        *columns = NULL;
     }
-
-    return 1;
 }
 
 
-static char *get_io_file_name(Xsxml_Char_File_IO *io_obj)
+/* The shared nodes are only freed once the last object sharing them is unset. */
+static void xsxml_unset_shared_version(Xsxml_Shared_Version **shared_version)
 {
-    size_t PROPERTY_TERM_LEN = strlen(io_obj->property_term);
-
-    size_t I_STR_LEN;
-    if (io_obj->node_i_value == 0)
-        I_STR_LEN = 1;
-    else
-        I_STR_LEN = (int)log10(io_obj->node_i_value) + 1;
+    if (((*shared_version) != NULL)
+    &&  (atomic_fetch_sub(&(*shared_version)->reference_count, 1) == 1))
+    {
+        for (size_t i = 0; i < (*shared_version)->number_of_nodes; i++)
+        {
+            xsxml_unset_node(&(*shared_version)->node[i]);
+        }
 
-    /* The plus one (+2) denotes the two (2) periods (.).             */
-    const int FILE_NAME_PREFIX_LEN = NODE_FILE_NAME_SIZE + 2;
+        free((*shared_version)->node);
 
-    /* The value four (4) values denotes the four periods (.) in      */
-    /* a file name, whereas the value two (2) denotes the maximum     */
-    /* length of alphabetical extension (.am, .av, .ps, and .ns).     */
-    const int MAX_FILE_NAME_LEN = MAX_ATTRIBUTES_POSSIBLE_N_DIGITS 
-                                + FILE_NAME_PREFIX_LEN 
-                                + I_STR_LEN 
-                                + 4 
-                                + 2;
+        xsxml_unset_columns(&(*shared_version)->columns);
 
-    char file_name_prefix [FILE_NAME_PREFIX_LEN];
+        free(*shared_version);
+    }
 
-    file_name_prefix [0] = '.';
-    file_name_prefix [ FILE_NAME_PREFIX_LEN - 1 ] = '.';
+    *shared_version = NULL;
+}
 
-    memcpy( &file_name_prefix[1], 
-            &io_obj->temporary_file_name[0], 
-            NODE_FILE_NAME_SIZE);
 
-    /* The plus one (+1) is for the char array's null terminator. */
-    char *file_name = (char *) malloc(MAX_FILE_NAME_LEN + 1);
+void xsxml_unset(Xsxml **xsxml_object)
+{
+    if (*xsxml_object != NULL)
+    {
+        if ((*xsxml_object)->result_message != NULL)
+        {
+            free((*xsxml_object)->result_message);
 
-    memcpy( &file_name[0], 
-            &file_name_prefix[0], 
-            FILE_NAME_PREFIX_LEN);
+            (*xsxml_object)->result_message = NULL;
+        }
 
-    sprintf(&file_name[FILE_NAME_PREFIX_LEN], "%d", io_obj->node_i_value);
+        if ((*xsxml_object)->shared_version != NULL)
+        {
+            if ((*xsxml_object)->columns != (*xsxml_object)->shared_version->columns)
+            {
+                xsxml_unset_columns(&(*xsxml_object)->columns);
+            }
 
-    file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN] = '.';
+            xsxml_unset_shared_version(&(*xsxml_object)->shared_version);
+        }
+        else /* if ((*xsxml_object)->shared_version == NULL) */
+        {
+            for (size_t i = 0; i < (*xsxml_object)->number_of_nodes; i++)
+            {
+                xsxml_unset_node(&(*xsxml_object)->node[i]);
+            }
 
-    memcpy( &file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 1], 
-            &io_obj->property_term[0], 
-            PROPERTY_TERM_LEN);
+            free((*xsxml_object)->node);
 
-    const size_t PART_FILE_NAME_LEN = FILE_NAME_PREFIX_LEN 
-                                    + I_STR_LEN 
-                                    + PROPERTY_TERM_LEN 
-                                    + 1;
+            xsxml_unset_columns(&(*xsxml_object)->columns);
+        }
 
-    file_name [PART_FILE_NAME_LEN] = 0;
+        (*xsxml_object)->node    = NULL;
+        (*xsxml_object)->columns = NULL;
 
-    if (io_obj->node_j_value != (unsigned int)-1)
-    {
-        file_name [PART_FILE_NAME_LEN] = '.';
+        xsxml_unset_children(&(*xsxml_object)->children);
 
-        sprintf(&file_name[PART_FILE_NAME_LEN + 1], "%u", io_obj->node_j_value);
-    }
+        xsxml_unset_tag_index(&(*xsxml_object)->tag_index);
 
-    return file_name;
-}
+        xsxml_unset_attribute_index(&(*xsxml_object)->attribute_index);
 
+        xsxml_unset_content_index(&(*xsxml_object)->content_index);
 
-static void read_from_char_file(Xsxml_Char_File_IO *io_obj)
-{
-    char *file_name = get_io_file_name(io_obj);
+        xsxml_unset_string_arena(&(*xsxml_object)->string_arena);
 
-    FILE *file_pointer_read = open_char_file(io_obj->temporary_dir_path, file_name, "r");
+        free((*xsxml_object)->source_buffer);
 
-    if (io_obj->data_str == NULL)
-    {
-        fseek(file_pointer_read, 0L, SEEK_END);
+        /* The removed nodes are still held by the node array, and have */
+        /* thus been freed along with the other nodes.                  */
+        if ((*xsxml_object)->edit_state != NULL)
+        {
+            free((*xsxml_object)->edit_state->removed_subtree);
 
-        size_t FILE_SIZE = ftell(file_pointer_read);
+            free((*xsxml_object)->edit_state);
 
-        io_obj->data_str = (char *) calloc(FILE_SIZE, sizeof(char));
+            (*xsxml_object)->edit_state = NULL;
+        }
 
-        fseek(file_pointer_read, 0L, SEEK_SET);
+        free(*xsxml_object);
 
-        if (fread(io_obj->data_str, sizeof(char), FILE_SIZE - 1, file_pointer_read)) {}
-    }
-    else
-    {
-        if (fscanf(file_pointer_read, "%u", &io_obj->data_int)) {}
+        *xsxml_object = NULL;
     }
-
-    fclose(file_pointer_read);
-
-    free(file_name);
 }
 
 
-static void write_to_char_file(Xsxml_Char_File_IO *io_obj)
+void xsxml_files_unset(Xsxml_Files **xsxml_files_object)
 {
-    char *file_name = get_io_file_name(io_obj);
+    if (*xsxml_files_object != NULL)
+    {
+        if ((*xsxml_files_object)->result_message != NULL)
+        {
+            free((*xsxml_files_object)->result_message);
 
-    FILE *file_pointer_write = open_char_file(io_obj->temporary_dir_path, file_name, "w");
+            (*xsxml_files_object)->result_message = NULL;
+        }
 
-    if (io_obj->data_str != NULL)
-        fprintf(file_pointer_write, "%s\n", io_obj->data_str);
-    else
-        fprintf(file_pointer_write, "%u\n", io_obj->data_int);
+        if (((*xsxml_files_object)->node_file_name  != NULL) 
+        &&  ((*xsxml_files_object)->number_of_nodes != 0))
+        {
+            const size_t MAX_I_STR_LEN = (int)log10((*xsxml_files_object)->number_of_nodes) 
+                                       + 1;
 
-    fclose(file_pointer_write);
+            /* The plus one (+2) denotes the two (2) periods (.).             */
+            const int FILE_NAME_PREFIX_LEN = NODE_FILE_NAME_SIZE + 2;
+
+            /* The value four (4) values denotes the four periods (.) in      */
+            /* a file name, whereas the value two (2) denotes the maximum     */
+            /* length of alphabetical extension (.am, .av, .ps, and .ns).     */
+            const int MAX_FILE_NAME_LEN = MAX_ATTRIBUTES_POSSIBLE_N_DIGITS 
+                                        + FILE_NAME_PREFIX_LEN 
+                                        + MAX_I_STR_LEN 
+                                        + 4 
+                                        + 2;
+
+            char file_name_prefix [FILE_NAME_PREFIX_LEN];
+
+            file_name_prefix [0] = '.';
+            file_name_prefix [ FILE_NAME_PREFIX_LEN - 1 ] = '.';
+
+            memcpy( &file_name_prefix[1], 
+                    &(*xsxml_files_object)->node_file_name[0], 
+                    NODE_FILE_NAME_SIZE);
+
+            for (size_t i = 0; i < (*xsxml_files_object)->number_of_nodes; i++)
+            {
+                size_t I_STR_LEN;
+                if (i == 0)
+                    I_STR_LEN = 1;
+                else
+                    I_STR_LEN = (int)log10(i) + 1;
+
+                /* The plus one (+1) is for the char array's null terminator. */
+                char file_name [MAX_FILE_NAME_LEN + 1];
+
+                file_name [MAX_FILE_NAME_LEN] = 0;
+
+                memcpy( &file_name[0], 
+                        &file_name_prefix[0], 
+                        FILE_NAME_PREFIX_LEN);
+
+                sprintf(&file_name[FILE_NAME_PREFIX_LEN], "%zu", i);
+
+                int dummy_val;
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN] = '.';
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 0;
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'd';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'l';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 3] = 0;
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'N';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'c';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'N';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'p';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 's';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'n';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 's';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'n';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'n';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 's';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'e';
+
+                dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                file_name);
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 3] = '.';
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'n';
+
+                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
+                {
+                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 4], "%d", j);
+
+                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                    file_name);
+
+                    if (dummy_val == -1) break;
+                }
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'a';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = 'v';
+
+                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
+                {
+                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 4], "%d", j);
+
+                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                    file_name);
+
+                    if (dummy_val == -1) break;
+                }
+
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 1] = 'c';
+                file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN + 2] = '.';
+
+                for (int j = 0; j < MAX_ATTRIBUTES_POSSIBLE_N; j++)
+                {
+                    sprintf(&file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 3], "%d", j);
+
+                    dummy_val = delete_char_file( (*xsxml_files_object)->node_directory_path, 
+                                                    file_name);
+
+                    if (dummy_val == -1) break;
+                }
+            }
+
+            free((*xsxml_files_object)->node_file_name);
+
+            (*xsxml_files_object)->node_file_name = NULL;
+        }
+
+        if ((*xsxml_files_object)->node_directory_path != NULL)
+        {
+            free((*xsxml_files_object)->node_directory_path);
+
+            (*xsxml_files_object)->node_directory_path = NULL;
+        }
+
+        free(*xsxml_files_object);
+
+        *xsxml_files_object = NULL;
+    }
+}
+
+
+/* Returns the given node, or its closest ancestor, whose depth does not  */
+/* exceed the given depth.                                               */
+static Xsxml_Nodes *climb_to_depth( Xsxml_Nodes *xsxml_node, 
+                                    size_t depth)
+{
+    while ((xsxml_node != NULL) && (xsxml_node->depth > depth))
+    {
+        xsxml_node = xsxml_node->ancestor;
+    }
+
+    return xsxml_node;
+}
+
+
+/* Empties and unlinks a node whose six arrays have been allocated, and */
+/* accounts for it as though it were a new node.                        */
+static Xsxml_Nodes *reset_node( Xsxml *xsxml_object, 
+                                Xsxml_Nodes *xsxml_node, 
+                                const char *node_name, 
+                                size_t node_name_length, 
+                                size_t depth)
+{
+    xsxml_set_node_name( xsxml_object, 
+                         xsxml_node, 
+                         node_name, 
+                         node_name_length);
+
+    /* The node, its slot in the node array, and its six arrays. */
+    xsxml_object->memory_usage.node_bytes += 
+        sizeof(Xsxml_Nodes) + sizeof(Xsxml_Nodes *);
+
+    xsxml_object->memory_usage.pointer_array_bytes += 
+        3 * (sizeof(char *) + sizeof(size_t));
+
+    xsxml_object->memory_usage.number_of_allocations += 7;
+
+    xsxml_node->depth = depth;
+    xsxml_node->number_of_contents   = 0;
+    xsxml_node->number_of_attributes = 0;
+    xsxml_node->number_of_children   = 0;
+
+    xsxml_node->ancestor         = NULL;
+    xsxml_node->descendant       = NULL;
+    xsxml_node->next_sibling     = NULL;
+    xsxml_node->previous_sibling = NULL;
+
+    return xsxml_node;
+}
+
+
+/* Returns a new, unlinked node without any contents or attributes. */
+static Xsxml_Nodes *new_node( Xsxml *xsxml_object, 
+                              const char *node_name, 
+                              size_t node_name_length, 
+                              size_t depth)
+{
+    Xsxml_Nodes *xsxml_node = (Xsxml_Nodes *) malloc(sizeof(Xsxml_Nodes));
+
+    xsxml_node->attribute_name = (char **) malloc(sizeof(char *));
+
+    xsxml_node->attribute_value = (char **) malloc(sizeof(char *));
+
+    xsxml_node->content = (char **) malloc(sizeof(char *));
+
+    xsxml_node->attribute_name_length  = (size_t *) malloc(sizeof(size_t));
+
+    xsxml_node->attribute_value_length = (size_t *) malloc(sizeof(size_t));
+
+    xsxml_node->content_length         = (size_t *) malloc(sizeof(size_t));
+
+    xsxml_node->lazy_content = NULL;
+
+    return reset_node( xsxml_object, 
+                       xsxml_node, 
+                       node_name, 
+                       node_name_length, 
+                       depth);
+}
+
+
+static int parse_sub_operation_ram_mode( Xsxml **xsxml_object, 
+                                         Xsxml_Parse_Mode parse_mode, 
+                                         size_t node_level, 
+                                         char *data, 
+                                         size_t data_length)
+{
+    const size_t DATA_LEN = data_length;
+
+    const size_t n = (*xsxml_object)->number_of_nodes;
+
+    if (parse_mode == XSXML_TAG)
+    {
+        if (node_level == 0)
+        {
+            if ((*xsxml_object)->number_of_nodes > 0) return 0;
+        }
+
+        (*xsxml_object)->number_of_nodes++;
+
+        Xsxml_Parse_Context *parse_context = (*xsxml_object)->parse_context;
+
+        if (parse_context == NULL)
+        {
+            (*xsxml_object)->node = 
+            (Xsxml_Nodes **) realloc( (*xsxml_object)->node, 
+                                      (n + 1) * sizeof(Xsxml_Nodes *));
+
+            (*xsxml_object)->node[n] = new_node( *xsxml_object, 
+                                                 data, 
+                                                 DATA_LEN, 
+                                                 node_level);
+        }
+        else if (n < parse_context->number_of_spare_nodes)
+        {
+            /* The node at the same index in the previous document is */
+            /* reused, along with its arrays.                          */
+            free((*xsxml_object)->node[n]->lazy_content);
+
+            (*xsxml_object)->node[n]->lazy_content = NULL;
+
+            reset_node( *xsxml_object, 
+                        (*xsxml_object)->node[n], 
+                        data, 
+                        DATA_LEN, 
+                        node_level);
+        }
+        else /* if (n >= parse_context->number_of_spare_nodes) */
+        {
+            if (n + 1 > parse_context->node_capacity)
+            {
+                parse_context->node_capacity = 2 * (n + 1);
+
+                (*xsxml_object)->node = 
+                (Xsxml_Nodes **) realloc( (*xsxml_object)->node, 
+                                          parse_context->node_capacity * sizeof(Xsxml_Nodes *));
+            }
+
+            (*xsxml_object)->node[n] = new_node( *xsxml_object, 
+                                                 data, 
+                                                 DATA_LEN, 
+                                                 node_level);
+        }
+
+        /* Until its end tag is met, the node's subtree consists of itself. */
+        (*xsxml_object)->node[n]->subtree_end = n;
+
+        if (node_level != 0)
+        {
+            /* Climb up from the previous node to this node's previous sibling. */
+            Xsxml_Nodes *previous_node = climb_to_depth( (*xsxml_object)->node[n-1], 
+                                                         node_level);
+
+            if (previous_node->depth == node_level)
+            {
+                (*xsxml_object)->node[n]->previous_sibling = previous_node;
+                previous_node->next_sibling                = (*xsxml_object)->node[n];
+
+                (*xsxml_object)->node[n]->ancestor = previous_node->ancestor;
+            }
+            else /* if (previous_node->depth < node_level) */
+            {
+                (*xsxml_object)->node[n]->ancestor         = previous_node;
+                (*xsxml_object)->node[n]->previous_sibling = NULL;
+
+                previous_node->descendant = (*xsxml_object)->node[n];
+            }
+
+            (*xsxml_object)->node[n]->ancestor->number_of_children++;
+        }
+        else /* if (node_level == 0) */
+        {
+            (*xsxml_object)->node[n]->ancestor         = NULL;
+            (*xsxml_object)->node[n]->previous_sibling = NULL;
+        }
+    }
+    else if (parse_mode == XSXML_ATTRIBUTE_NAME)
+    {
+        const size_t n_a = (*xsxml_object)->node[n-1]->number_of_attributes;
+
+        for (size_t i = 0; i < n_a; i++)
+        {
+            if (((*xsxml_object)->node[n-1]->attribute_name_length[i] == DATA_LEN) 
+            &&  (memcmp( (const char*)  data, 
+                         (const char*) ((*xsxml_object)->node[n-1]->attribute_name[i]), 
+                         DATA_LEN) == 0))
+            {
+                return 0;
+            }
+        }
+
+        (*xsxml_object)->node[n-1]->number_of_attributes++;
+
+        (*xsxml_object)->node[n-1]->attribute_name = 
+        (char **) realloc( (*xsxml_object)->node[n-1]->attribute_name, 
+                           (n_a + 1) * sizeof(char *));
+
+        (*xsxml_object)->node[n-1]->attribute_name[n_a] = 
+        xsxml_copy_string(*xsxml_object, data, DATA_LEN);
+
+        (*xsxml_object)->node[n-1]->attribute_name_length = 
+        (size_t *) realloc( (*xsxml_object)->node[n-1]->attribute_name_length, 
+                            (n_a + 1) * sizeof(size_t));
+
+        (*xsxml_object)->node[n-1]->attribute_name_length[n_a] = DATA_LEN;
+
+        /* The first slot of every array is allocated along with the node. */
+        if (n_a > 0)
+        {
+            (*xsxml_object)->memory_usage.pointer_array_bytes += 
+                sizeof(char *) + sizeof(size_t);
+        }
+
+        (*xsxml_object)->memory_usage.attribute_bytes += DATA_LEN + 1;
+    }
+    else if (parse_mode == XSXML_ATTRIBUTE_VALUE)
+    {
+        const size_t n_a = (*xsxml_object)->node[n-1]->number_of_attributes;
+
+        (*xsxml_object)->node[n-1]->attribute_value = 
+        (char **) realloc( (*xsxml_object)->node[n-1]->attribute_value, 
+                             n_a * sizeof(char *));
+
+        (*xsxml_object)->node[n-1]->attribute_value[n_a-1] = 
+        xsxml_copy_string(*xsxml_object, data, DATA_LEN);
+
+        (*xsxml_object)->node[n-1]->attribute_value_length = 
+        (size_t *) realloc( (*xsxml_object)->node[n-1]->attribute_value_length, 
+                              n_a * sizeof(size_t));
+
+        (*xsxml_object)->node[n-1]->attribute_value_length[n_a-1] = DATA_LEN;
+
+        if (n_a > 1)
+        {
+            (*xsxml_object)->memory_usage.pointer_array_bytes += 
+                sizeof(char *) + sizeof(size_t);
+        }
+
+        (*xsxml_object)->memory_usage.attribute_bytes += DATA_LEN + 1;
+    }
+    else if (parse_mode == XSXML_PCDATA_CONTENT)
+    {
+        /* The content belongs to the innermost node that is still open. */
+        Xsxml_Nodes *this_node = climb_to_depth( (*xsxml_object)->node[n-1], 
+                                                 node_level - 1);
+
+        const size_t n_c = this_node->number_of_contents;
+
+        this_node->number_of_contents++;
+
+        this_node->content = 
+        (char **) realloc( this_node->content, 
+                           (n_c + 1) * sizeof(char *));
+
+        this_node->content[n_c] = xsxml_copy_string(*xsxml_object, data, DATA_LEN);
+
+        this_node->content_length = 
+        (size_t *) realloc( this_node->content_length, 
+                            (n_c + 1) * sizeof(size_t));
+
+        this_node->content_length[n_c] = DATA_LEN;
+
+        if (n_c > 0)
+        {
+            (*xsxml_object)->memory_usage.pointer_array_bytes += 
+                sizeof(char *) + sizeof(size_t);
+        }
+
+        (*xsxml_object)->memory_usage.content_bytes += DATA_LEN + 1;
+    }
+    else if (parse_mode == XSXML_END_TAG)
+    {
+        /* The node being closed is open at the given depth, and the last */
+        /* node parsed so far is the last node within its subtree.        */
+        Xsxml_Nodes *this_node = climb_to_depth( (*xsxml_object)->node[n-1], 
+                                                 node_level);
+
+        if ((this_node != NULL) && (this_node->depth == node_level))
+        {
+            this_node->subtree_end = n - 1;
+        }
+    }
+
+    return 1;
+}
+
+
+static void parse_lazy_content_ram_mode( Xsxml **xsxml_object, 
+                                         size_t node_level, 
+                                         const Xsxml_Lazy_Word *lazy_word, 
+                                         size_t word_len)
+{
+    const size_t n = (*xsxml_object)->number_of_nodes;
+
+    /* The content belongs to the innermost node that is still open. */
+    Xsxml_Nodes *this_node = climb_to_depth( (*xsxml_object)->node[n-1], 
+                                             node_level - 1);
+
+    const size_t n_c = this_node->number_of_contents;
+
+    this_node->number_of_contents++;
+
+    this_node->content = 
+    (char **) realloc( this_node->content, 
+                       (n_c + 1) * sizeof(char *));
+
+    this_node->content_length = 
+    (size_t *) realloc( this_node->content_length, 
+                        (n_c + 1) * sizeof(size_t));
+
+    this_node->lazy_content = 
+    (Xsxml_Lazy_Content *) realloc( this_node->lazy_content, 
+                                    (n_c + 1) * sizeof(Xsxml_Lazy_Content));
+
+    /* The content is decoded upon its first access. */
+    this_node->content       [n_c] = NULL;
+    this_node->content_length[n_c] = 0;
+
+    if (word_len == 0)
+    {
+        this_node->lazy_content[n_c].offset = 0;
+        this_node->lazy_content[n_c].length = 0;
+    }
+    else /* if (word_len > 0) */
+    {
+        /* Like the trailing space of a word, that of a content is dropped. */
+        const size_t END_OFFSET = lazy_word->ends_with_space 
+                                ? lazy_word->space_offset 
+                                : lazy_word->end_offset;
+
+        this_node->lazy_content[n_c].offset = lazy_word->offset;
+        this_node->lazy_content[n_c].length = END_OFFSET - lazy_word->offset;
+    }
+
+    this_node->lazy_content[n_c].needs_decoding = lazy_word->needs_decoding;
+
+    if (n_c > 0)
+    {
+        (*xsxml_object)->memory_usage.pointer_array_bytes += 
+            sizeof(char *) + sizeof(size_t);
+    }
+    else /* if (n_c == 0) */
+    {
+        (*xsxml_object)->memory_usage.number_of_allocations++;
+    }
+
+    (*xsxml_object)->memory_usage.pointer_array_bytes += sizeof(Xsxml_Lazy_Content);
+}
+
+
+/* Decodes the source data of a content in the same manner as the parser */
+/* does, and returns the decoded length, which is never more than the    */
+/* source length.                                                        */
+static size_t decode_lazy_content( const char *source_data, 
+                                   size_t source_length, 
+                                   char *decoded_data)
+{
+    size_t decoded_len = 0;
+
+    int was_space = 0;
+
+    size_t i = 0;
+
+    while (i < source_length)
+    {
+        const char character = source_data[i];
+
+        if (character == '<')
+        {
+            was_space = 0;
+
+            if ((source_length - i >= 9) && (memcmp(&source_data[i], "<![CDATA[", 9) == 0))
+            {
+                int end_square_brackets = 0;
+
+                for (i += 9; i < source_length; i++)
+                {
+                    if (source_data[i] == ']')
+                    {
+                        end_square_brackets++;
+                        continue;
+                    }
+
+                    if ((end_square_brackets == 2) && (source_data[i] == '>')) break;
+
+                    while (end_square_brackets > 0)
+                    {
+                        decoded_data[decoded_len++] = ']';
+
+                        end_square_brackets--;
+                    }
+
+                    decoded_data[decoded_len++] = source_data[i];
+                }
+            }
+            else /* if (it is a comment) */
+            {
+                /* A comment ends with a hyphen followed by a '>' character, */
+                /* where the hyphen is not part of the '<!--' start tag.     */
+                for (i += 5; i < source_length; i++)
+                {
+                    if ((source_data[i] == '>') && (source_data[i - 1] == '-')) break;
+                }
+            }
+
+            i++;
+            continue;
+        }
+
+        if (character == '&')
+        {
+            char character_entry_reference [CHARACTER_ENTRY_REFERENCE_MAX_LENGTH + 1] = { 0 };
+
+            char *cer_pointer = &character_entry_reference[0];
+
+            int cer_i = 0;
+
+            for (i++; source_data[i] != ';'; i++)
+            {
+                character_entry_reference [cer_i++] = source_data[i];
+            }
+
+            /* The reference has already been validated by the parser. */
+            if (parse_cer(&cer_pointer)) {}
+
+            decoded_data[decoded_len++] = character_entry_reference[0];
+
+            was_space = 0;
+
+            i++;
+            continue;
+        }
+
+        if ((character ==  ' ') || (character == '\r') 
+        ||  (character == '\n') || (character == '\t') 
+        ||  (character == '\v') || (character == '\f'))
+        {
+            if (!was_space)
+            {
+                was_space = 1;
+
+                decoded_data[decoded_len++] = ' ';
+            }
+
+            i++;
+            continue;
+        }
+
+        was_space = 0;
+
+        decoded_data[decoded_len++] = character;
+
+        i++;
+    }
+
+    return decoded_len;
+}
+
+
+/* A NULL content is one that has been parsed lazily, and not accessed yet. */
+static char *node_content( Xsxml *xsxml_object, 
+                           Xsxml_Nodes *xsxml_node, 
+                           size_t content_index)
+{
+    if (xsxml_node->content[content_index] != NULL)
+    {
+        return xsxml_node->content[content_index];
+    }
+
+    const Xsxml_Lazy_Content *LAZY_CONTENT = &xsxml_node->lazy_content[content_index];
+
+    const char *source_data = &xsxml_object->source_buffer[LAZY_CONTENT->offset];
+
+    if (!LAZY_CONTENT->needs_decoding)
+    {
+        xsxml_node->content[content_index] = 
+        xsxml_copy_string(xsxml_object, source_data, LAZY_CONTENT->length);
+
+        xsxml_node->content_length[content_index] = LAZY_CONTENT->length;
+
+        xsxml_object->memory_usage.content_bytes += LAZY_CONTENT->length + 1;
+    }
+    else /* if (LAZY_CONTENT->needs_decoding) */
+    {
+        /* The plus one (+1) prevents a zero-sized allocation. */
+        char *decoded_data = (char *) malloc(LAZY_CONTENT->length + 1);
+
+        const size_t DECODED_LEN = decode_lazy_content( source_data, 
+                                                        LAZY_CONTENT->length, 
+                                                        decoded_data);
+
+        xsxml_node->content[content_index] = 
+        xsxml_copy_string(xsxml_object, decoded_data, DECODED_LEN);
+
+        xsxml_node->content_length[content_index] = DECODED_LEN;
+
+        xsxml_object->memory_usage.content_bytes += DECODED_LEN + 1;
+
+        free(decoded_data);
+    }
+
+    return xsxml_node->content[content_index];
+}
+
+
+static void materialise_contents( Xsxml *xsxml_object, 
+                                  Xsxml_Nodes *xsxml_node)
+{
+    for (size_t j = 0; j < xsxml_node->number_of_contents; j++)
+    {
+        node_content(xsxml_object, xsxml_node, j);
+    }
+}
+
+
+static char *get_io_file_name(Xsxml_Char_File_IO *io_obj)
+{
+    size_t PROPERTY_TERM_LEN = strlen(io_obj->property_term);
+
+    size_t I_STR_LEN;
+    if (io_obj->node_i_value == 0)
+        I_STR_LEN = 1;
+    else
+        I_STR_LEN = (int)log10(io_obj->node_i_value) + 1;
+
+    /* The plus one (+2) denotes the two (2) periods (.).             */
+    const int FILE_NAME_PREFIX_LEN = NODE_FILE_NAME_SIZE + 2;
+
+    /* The value four (4) values denotes the four periods (.) in      */
+    /* a file name, whereas the value two (2) denotes the maximum     */
+    /* length of alphabetical extension (.am, .av, .ps, and .ns).     */
+    const int MAX_FILE_NAME_LEN = MAX_ATTRIBUTES_POSSIBLE_N_DIGITS 
+                                + FILE_NAME_PREFIX_LEN 
+                                + I_STR_LEN 
+                                + 4 
+                                + 2;
+
+    char file_name_prefix [FILE_NAME_PREFIX_LEN];
+
+    file_name_prefix [0] = '.';
+    file_name_prefix [ FILE_NAME_PREFIX_LEN - 1 ] = '.';
+
+    memcpy( &file_name_prefix[1], 
+            &io_obj->temporary_file_name[0], 
+            NODE_FILE_NAME_SIZE);
+
+    /* The plus one (+1) is for the char array's null terminator. */
+    char *file_name = (char *) malloc(MAX_FILE_NAME_LEN + 1);
+
+    memcpy( &file_name[0], 
+            &file_name_prefix[0], 
+            FILE_NAME_PREFIX_LEN);
+
+    sprintf(&file_name[FILE_NAME_PREFIX_LEN], "%zu", io_obj->node_i_value);
+
+    file_name [FILE_NAME_PREFIX_LEN + I_STR_LEN] = '.';
+
+    memcpy( &file_name[FILE_NAME_PREFIX_LEN + I_STR_LEN + 1], 
+            &io_obj->property_term[0], 
+            PROPERTY_TERM_LEN);
+
+    const size_t PART_FILE_NAME_LEN = FILE_NAME_PREFIX_LEN 
+                                    + I_STR_LEN 
+                                    + PROPERTY_TERM_LEN 
+                                    + 1;
+
+    file_name [PART_FILE_NAME_LEN] = 0;
+
+    if (io_obj->node_j_value != XSXML_NO_NODE)
+    {
+        file_name [PART_FILE_NAME_LEN] = '.';
+
+        sprintf(&file_name[PART_FILE_NAME_LEN + 1], "%zu", io_obj->node_j_value);
+    }
+
+    return file_name;
+}
+
+
+static void read_from_char_file(Xsxml_Char_File_IO *io_obj)
+{
+    char *file_name = get_io_file_name(io_obj);
+
+    FILE *file_pointer_read = open_char_file(io_obj->temporary_dir_path, file_name, "r");
+
+    if (io_obj->data_str == NULL)
+    {
+        fseek(file_pointer_read, 0L, SEEK_END);
+
+        size_t FILE_SIZE = ftell(file_pointer_read);
+
+        io_obj->data_str = (char *) calloc(FILE_SIZE, sizeof(char));
+
+        fseek(file_pointer_read, 0L, SEEK_SET);
+
+        if (fread(io_obj->data_str, sizeof(char), FILE_SIZE - 1, file_pointer_read)) {}
+    }
+    else
+    {
+        if (fscanf(file_pointer_read, "%zu", &io_obj->data_int)) {}
+    }
+
+    fclose(file_pointer_read);
+
+    free(file_name);
+}
+
+
+/* Returns the number of bytes written, which is the size of the file. */
+static size_t write_to_char_file(Xsxml_Char_File_IO *io_obj)
+{
+    char *file_name = get_io_file_name(io_obj);
+
+    FILE *file_pointer_write = open_char_file(io_obj->temporary_dir_path, file_name, "w");
+
+    int bytes_written;
+
+    if (io_obj->data_str != NULL)
+        bytes_written = fprintf(file_pointer_write, "%s\n", io_obj->data_str);
+    else
+        bytes_written = fprintf(file_pointer_write, "%zu\n", io_obj->data_int);
+
+    fclose(file_pointer_write);
+
+    free(file_name);
+
+    return (bytes_written > 0) ? (size_t) bytes_written : 0;
+}
+
+
+/* The size of a file, written by the above function, that holds a number. */
+static size_t number_file_size(size_t data_int)
+{
+    return snprintf(NULL, 0, "%zu\n", data_int);
+}
+
+
+/* The FILE mode counterpart of the function 'climb_to_depth'.           */
+/* The variable io_obj->data_int holds the returned node's depth.        */
+static size_t climb_to_depth_file_mode( Xsxml_Char_File_IO *io_obj, 
+                                        size_t node_i, 
+                                        size_t depth)
+{
+    io_obj->node_j_value  = -1;
+    io_obj->property_term = "l";
+    io_obj->node_i_value  = node_i;
+    io_obj->data_str      = "dummy";
+    read_from_char_file(io_obj);
+
+    while (io_obj->data_int > depth)
+    {
+        io_obj->property_term = "a";
+        read_from_char_file(io_obj);
+
+        node_i = io_obj->data_int;
+
+        io_obj->property_term = "l";
+        io_obj->node_i_value  = node_i;
+        read_from_char_file(io_obj);
+    }
+
+    return node_i;
+}
+
+
+static int parse_sub_operation_file_mode( Xsxml_Files **xsxml_files_object, 
+                                          Xsxml_Parse_Mode parse_mode, 
+                                          size_t node_level, 
+                                          char *data)
+{
+    Xsxml_Char_File_IO io_obj;
+    io_obj.temporary_dir_path  = (*xsxml_files_object)->node_directory_path;
+    io_obj.temporary_file_name = (*xsxml_files_object)->node_file_name;
+
+    const size_t n = (*xsxml_files_object)->number_of_nodes;
+
+    /* The bytes added to the temporary files. */
+    size_t disk_bytes = 0;
+
+    if (parse_mode == XSXML_TAG)
+    {
+        if (node_level == 0)
+        {
+            if ((*xsxml_files_object)->number_of_nodes > 0) return 0;
+        }
+
+        (*xsxml_files_object)->number_of_nodes++;
+
+        const size_t NODE_FILE_NAME_LEN = strlen((*xsxml_files_object)->node_file_name);
+
+        char *temp_file_name = (char *) malloc(NODE_FILE_NAME_LEN + 5);
+
+        io_obj.property_term = "l";
+        io_obj.node_i_value  =  n;
+        io_obj.node_j_value  = -1;
+        io_obj.data_int      = node_level;
+        io_obj.data_str      = NULL;
+        disk_bytes += write_to_char_file(&io_obj);
+
+        io_obj.property_term = "cN";
+        io_obj.node_i_value  =  n;
+        io_obj.data_int      =  0;
+        disk_bytes += write_to_char_file(&io_obj);
+
+        io_obj.property_term = "aN";
+        disk_bytes += write_to_char_file(&io_obj);
+
+        io_obj.property_term = "nn";
+        io_obj.data_str      = data;
+        disk_bytes += write_to_char_file(&io_obj);
+
+        io_obj.property_term = "d";
+        temp_file_name = get_io_file_name(&io_obj);
+        delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+
+        io_obj.property_term = "ns";
+        temp_file_name = get_io_file_name(&io_obj);
+        delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+
+        /* Until its end tag is met, the node's subtree consists of itself. */
+        io_obj.property_term = "se";
+        io_obj.data_int      = n;
+        io_obj.data_str      = NULL;
+        disk_bytes += write_to_char_file(&io_obj);
+
+        if (node_level != 0)
+        {
+            /* Climb up from the previous node to this node's previous sibling. */
+            const size_t previous_node_i = climb_to_depth_file_mode( &io_obj, 
+                                                                     n - 1, 
+                                                                     node_level);
+
+            /* The variable io_obj.data_int plays the role of   */
+            /* (*xsxml_object)->node[previous_node_i]->depth    */
+            if (io_obj.data_int == node_level)
+            {
+                io_obj.property_term = "a";
+                read_from_char_file(&io_obj);
+
+                io_obj.node_i_value  = n;
+                io_obj.data_str      = NULL;
+                disk_bytes += write_to_char_file(&io_obj);
+
+                io_obj.property_term = "ns";
+                io_obj.node_i_value  = previous_node_i;
+                io_obj.data_int      = n;
+                disk_bytes += write_to_char_file(&io_obj);
+
+                io_obj.property_term = "ps";
+                io_obj.node_i_value  = n;
+                io_obj.data_int      = previous_node_i;
+                disk_bytes += write_to_char_file(&io_obj);
+            }
+            else
+            {
+                io_obj.property_term = "a";
+                io_obj.node_i_value  = n;
+                io_obj.data_int      = previous_node_i;
+                io_obj.data_str      = NULL;
+                disk_bytes += write_to_char_file(&io_obj);
+
+                io_obj.property_term = "d";
+                io_obj.node_i_value  = previous_node_i;
+                io_obj.data_int      = n;
+                disk_bytes += write_to_char_file(&io_obj);
+            }
+        }
+        else /* if (node_level == 0) */
+        {
+            io_obj.property_term = "a";
+            temp_file_name = get_io_file_name(&io_obj);
+            delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+
+            io_obj.property_term = "ps";
+            temp_file_name = get_io_file_name(&io_obj);
+            delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+        }
+
+        free(temp_file_name);
+    }
+    else if (parse_mode == XSXML_ATTRIBUTE_NAME)
+    {
+        io_obj.node_j_value  = -1;
+
+        io_obj.property_term = "aN";
+        io_obj.node_i_value  =  n - 1;
+        io_obj.data_str      = "dummy";
+        read_from_char_file(&io_obj);
+
+        const size_t n_a = io_obj.data_int;
+
+        for (size_t i = 0; i < n_a; i++)
+        {
+            io_obj.property_term = "an";
+            io_obj.node_j_value  = i;
+            io_obj.data_str      = NULL;
+            read_from_char_file(&io_obj);
+
+            if (strcmp( (const char*)  data, 
+                        (const char*) io_obj.data_str) == 0)
+            {
+                return 0;
+            }
+        }
+
+        io_obj.property_term = "aN";
+        io_obj.data_str = NULL;
+        io_obj.node_j_value  = -1;
+        io_obj.data_int = n_a + 1;
+        disk_bytes += write_to_char_file(&io_obj);
+        disk_bytes -= number_file_size(n_a);
+
+        io_obj.property_term = "an";
+        io_obj.node_j_value  = n_a;
+        io_obj.data_str      = data;
+        disk_bytes += write_to_char_file(&io_obj);
+    }
+    else if (parse_mode == XSXML_ATTRIBUTE_VALUE)
+    {
+        io_obj.node_j_value  = -1;
+
+        io_obj.property_term = "aN";
+        io_obj.node_i_value  =  n - 1;
+        io_obj.data_str      = "dummy";
+        read_from_char_file(&io_obj);
+
+        const size_t n_a = io_obj.data_int;
+
+        io_obj.property_term = "av";
+        io_obj.node_j_value  = n_a - 1;
+        io_obj.data_str      = data;
+        disk_bytes += write_to_char_file(&io_obj);
+    }
+    else if (parse_mode == XSXML_PCDATA_CONTENT)
+    {
+        /* The content belongs to the innermost node that is still open. */
+        const size_t this_node_i = climb_to_depth_file_mode( &io_obj, 
+                                                             n - 1, 
+                                                             node_level - 1);
+
+        io_obj.property_term = "cN";
+        io_obj.node_i_value  =  this_node_i;
+        io_obj.data_str      = "dummy";
+        read_from_char_file(&io_obj);
+
+        const size_t n_c = io_obj.data_int;
+
+        io_obj.data_str = NULL;
+        io_obj.data_int = n_c + 1;
+        disk_bytes += write_to_char_file(&io_obj);
+        disk_bytes -= number_file_size(n_c);
+
+        io_obj.property_term = "c";
+        io_obj.node_j_value  = n_c;
+        io_obj.data_str      = data;
+        disk_bytes += write_to_char_file(&io_obj);
+    }
+    else if (parse_mode == XSXML_END_TAG)
+    {
+        /* The node being closed is open at the given depth, and the last */
+        /* node parsed so far is the last node within its subtree.        */
+        const size_t this_node_i = climb_to_depth_file_mode( &io_obj, 
+                                                             n - 1, 
+                                                             node_level);
+
+        if (io_obj.data_int == node_level)
+        {
+            io_obj.property_term = "se";
+            io_obj.node_i_value  = this_node_i;
+            io_obj.data_int      = n - 1;
+            io_obj.data_str      = NULL;
+            disk_bytes += write_to_char_file(&io_obj);
+            disk_bytes -= number_file_size(this_node_i);
+        }
+    }
+
+    (*xsxml_files_object)->memory_usage.disk_bytes += disk_bytes;
+
+    return 1;
+}
+
+
+static Xsxml_Private_Result *parse_operation( void **object, 
+                                              const Xml_Data_Access_Mode access_mode, 
+                                              FILE *file_pointer)
+{
+    Xsxml_Private_Result *result_obj = 
+    (Xsxml_Private_Result *) malloc(sizeof(Xsxml_Private_Result));
+
+    result_obj->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+
+    int XML_X                   = 0;    /* X */
+    int XML_M                   = 0;    /* M */
+    int XML_EQUAL               = 0;    /* = */
+    int XML_HYPHEN              = 0;    /* - */
+    int XML_QUESTION            = 0;    /* ? */
+    int XML_AMPERSAND           = 0;    /* & */
+    int XML_WHITESPACE          = 0;    /*   */
+    int XML_SINGLE_QUOTE        = 0;    /* - */
+    int XML_DOUBLE_QUOTE        = 0;    /* - */
+    int XML_FORWARD_SLASH_END   = 0;    /* / */
+    int XML_FORWARD_SLASH_START = 0;    /* / */
+    int XML_END_SQUARE_BRACKET  = 0;    /* ] */
+
+    int XML_HEADING             = 0;
+    int XML_COMMENT_CONTENT     = 0;
+    int XML_COMMENT_START_TAG   = 0;
+    int XML_TAG                 = 0;
+    int XML_ATTRIBUTE           = 0;
+    int XML_ATTRIBUTE_NAME      = 0;
+    int XML_ATTRIBUTE_VALUE     = 0;
+    int XML_CDATA_CONTENT       = 0;
+    int XML_CDATA_START_TAG     = 0;
+    int XML_PCDATA_CONTENT      = 0;
+
+    int XML_TAG_RECENTLY_CLOSED = 0;
+
+
+    int       cer_i         = 0;        /* Character entry reference count */
+    size_t    word_len      = 0;        /* Word characters count           */
+    size_t    word_capacity = 64;       /* Word buffer size                */
+    long long node_level    = 0;        /* Current hierarchical depth      */
+
+
+    char *word = (char *) calloc(word_capacity, sizeof(char));
+
+    char *character_entry_reference = 
+    (char *) calloc( CHARACTER_ENTRY_REFERENCE_MAX_LENGTH + 1, sizeof(char));
+
+    character_entry_reference [CHARACTER_ENTRY_REFERENCE_MAX_LENGTH] = 0;
+
+
+    /* A lazily parsed object reads from its retained source instead. */
+    const char *source_buffer = NULL;
+    size_t      source_length = 0;
+
+    if (access_mode == XSXML_RAM_MODE)
+    {
+        source_buffer = (*(Xsxml **) object)->source_buffer;
+        source_length = (*(Xsxml **) object)->source_length;
+    }
+
+    Xsxml_Lazy_Word lazy_word = { 0 };
+
+    lazy_word.is_enabled = (source_buffer != NULL);
+
+    size_t markup_offset    = 0;        /* Offset of the latest '<'        */
+    size_t ampersand_offset = 0;        /* Offset of the latest '&'        */
+
+
+    for (size_t source_offset = 0; ; source_offset++)
+    {
+        char file_data_character;
+
+        if (source_buffer != NULL)
+        {
+            if (source_offset == source_length) break;
+
+            file_data_character = source_buffer[source_offset];
+        }
+        else /* if (source_buffer == NULL) */
+        {
+            file_data_character = fgetc(file_pointer);
+
+            if (feof(file_pointer)) break;
+        }
+
+        /* The below code is just a test code for debugging purposes. */
+        /* printf("%c", file_data_character);                         */
+
+
+/* ########################################################################## */
+/*                                  XML HEADING                               */
+/* ########################################################################## */
+        if (XML_HEADING)
+        {
+            if (file_data_character == '?')
+            {
+                XML_QUESTION = 1;
+                continue;
+            }
+
+            if (XML_QUESTION)
+            {
+                if (file_data_character == '>')
+                {
+                    XML_QUESTION = 0;
+                    XML_HEADING  = 0;
+                    continue;
+                }
+            }
+
+            XML_QUESTION = 0;
+            continue;
+        }
+
+
+/* ########################################################################## */
+/*                            XML COMMENT CONTENT                             */
+/* ########################################################################## */
+        if (XML_COMMENT_CONTENT)
+        {
+            if (file_data_character == '-')
+            {
+                if (XML_HYPHEN == 1)
+                {
+                    XML_HYPHEN = 2;
+                    continue;
+                }
+                else if (XML_HYPHEN == 2)
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "A double hyphen (--) within comments "
+                             "is not allowed.");
+
+                    return result_obj;
+                }
+
+                XML_HYPHEN = 1;
+                continue;
+            }
+
+            if (XML_HYPHEN)
+            {
+                if (file_data_character == '>')
+                {
+                    XML_HYPHEN  = 0;
+                    XML_COMMENT_CONTENT = 0;
+                    continue;
+                }
+            }
+
+            XML_HYPHEN = 0;
+            continue;
+        }
+
+
+/* ########################################################################## */
+/*                            XML COMMENT START TAG                           */
+/* ########################################################################## */
+        if (XML_COMMENT_START_TAG)
+        {
+            if (file_data_character == '-')
+            {
+                XML_COMMENT_CONTENT   = 1;
+                XML_COMMENT_START_TAG = 0;
+                continue;
+            }
+
+            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+            sprintf( &result_obj->result_message[0], 
+                     "Tag names must start with an alphabetical character "
+                     "[a-zA-Z] or underscore (_)");
+
+            return result_obj;
+        }
+
+
+/* ########################################################################## */
+/*                             XML CDATA CONTENT                              */
+/* ########################################################################## */
+        if (XML_CDATA_CONTENT)
+        {
+            if (file_data_character == ']')
+            {
+                XML_END_SQUARE_BRACKET++;
+                continue;
+            }
+
+            if ((XML_END_SQUARE_BRACKET == 2) && (file_data_character == '>'))
+            {
+                /* Working on CDATA. */
+
+                /* The below code is just a test code for debugging purposes.       */
+                /* printf("\n\n%*sCDATA = %s", node_level * INDENTATION, "", word); */
+
+                XML_CDATA_CONTENT      = 0;
+                XML_END_SQUARE_BRACKET = 0;
+                continue;
+            }
+
+            while (XML_END_SQUARE_BRACKET > 0)
+            {
+                append_character_to_content( &word, 
+                                             ']', 
+                                             &word_len, 
+                                             &word_capacity, 
+                                             &lazy_word, 
+                                             markup_offset, 
+                                             source_offset, 
+                                             1);
+
+                XML_END_SQUARE_BRACKET--;
+            }
+
+            append_character_to_content( &word, 
+                                         file_data_character, 
+                                         &word_len, 
+                                         &word_capacity, 
+                                         &lazy_word, 
+                                         markup_offset, 
+                                         source_offset, 
+                                         1);
+
+            continue;
+        }
+
+
+/* ########################################################################## */
+/*                              XML CDATA START TAG                           */
+/* ########################################################################## */
+        if (XML_CDATA_START_TAG)
+        {
+            if (file_data_character == '-')
+            {
+                XML_COMMENT_START_TAG = 1;
+                XML_CDATA_START_TAG   = 0;
+                continue;
+            }
+
+            if (((XML_CDATA_START_TAG == 1) && (file_data_character == '[')) 
+            ||  ((XML_CDATA_START_TAG == 2) && (file_data_character == 'C')) 
+            ||  ((XML_CDATA_START_TAG == 3) && (file_data_character == 'D')) 
+            ||  ((XML_CDATA_START_TAG == 4) && (file_data_character == 'A')) 
+            ||  ((XML_CDATA_START_TAG == 5) && (file_data_character == 'T')) 
+            ||  ((XML_CDATA_START_TAG == 6) && (file_data_character == 'A')))
+            {
+                XML_CDATA_START_TAG++;
+                continue;
+            }
+
+            if ((XML_CDATA_START_TAG == 7) && (file_data_character == '['))
+            {
+                XML_CDATA_CONTENT      = 1;
+                XML_PCDATA_CONTENT     = 1;
+                XML_CDATA_START_TAG    = 0;
+                XML_END_SQUARE_BRACKET = 0;
+                continue;
+            }
+
+            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+            sprintf( &result_obj->result_message[0], 
+                     "Tag names must start with an alphabetical character "
+                     "[a-zA-Z] or underscore (_)");
+
+            return result_obj;
+        }
+
+
+/* ########################################################################## */
+/*                                  XML TAG                                   */
+/* ########################################################################## */
+        if (XML_TAG)
+        {
+            if (XML_PCDATA_CONTENT)
+            {
+                /* The PCDATA continues after a CDATA entity or a comment. */
+                if (file_data_character == '!')
+                {
+                    XML_TAG = 0;
+                    XML_CDATA_START_TAG = 1;
+
+                    lazy_word.needs_decoding = 1;
+                    continue;
+                }
+
+                /* Working on PCDATA. */
+
+                if (lazy_word.is_enabled)
+                {
+                    if (lazy_word.has_nested_cdata)
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Nested CDATA is not allowed.");
+
+                        return result_obj;
+                    }
+
+                    parse_lazy_content_ram_mode( (Xsxml **) object, 
+                                                 node_level, 
+                                                 &lazy_word, 
+                                                 word_len);
+                }
+                else /* if (!lazy_word.is_enabled) */
+                {
+                    word [word_len] = 0;
+
+                    if ((word_len > 0) && (word[word_len - 1] == ' '))
+                    {
+                        word[word_len - 1] = '\0';
+
+                        word_len--;
+                    }
+
+                    if (strstr(word, "<![CDATA[") != NULL)
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Nested CDATA is not allowed.");
+
+                        return result_obj;
+                    }
+
+                    if (access_mode == XSXML_RAM_MODE)
+                    {
+                        parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                       XSXML_PCDATA_CONTENT, 
+                                                       node_level, 
+                                                       word, 
+                                                       (size_t) word_len);
+                    }
+                    else /* if (access_mode == XSXML_FILE_MODE) */
+                    {
+                        parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                        XSXML_PCDATA_CONTENT, 
+                                                        node_level, 
+                                                        word);
+                    }
+                }
+
+                /* The below code is just a test code for debugging purposes.        */
+                /* printf("\n\n%*sPCDATA = %s", node_level * INDENTATION, "", word); */
+
+                reset_word(&word, &word_len);
+                reset_lazy_word(&lazy_word);
+
+                XML_PCDATA_CONTENT = 0;
+            }
+
+            if (!XML_ATTRIBUTE && word_len == 0)
+            {
+                if (file_data_character == '!')
+                {
+                    XML_TAG = 0;
+                    XML_CDATA_START_TAG = 1;
+                    continue;
+                }
+
+                if (file_data_character == '/')
+                {
+                    XML_FORWARD_SLASH_START = 1;
+                    continue;
+                }
+
+                if (file_data_character == '?')
+                {
+                    XML_TAG      = 0;
+                    XML_QUESTION = 0;
+                    XML_HEADING  = 1;
+                    continue;
+                }
+
+                if (!isalpha(file_data_character) && file_data_character != '_')
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "Tag names must start with an alphabetical character "
+                             "[a-zA-Z] or underscore (_)");
+
+                    return result_obj;
+                }
+
+                if ((file_data_character == 'x') || (file_data_character == 'X'))
+                {
+                    XML_X = 1;
+                    append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+
+                    continue;
+                }
+            }
+
+            if (XML_X)
+            {
+                if ((file_data_character == 'm') || (file_data_character == 'M'))
+                {
+                    XML_M = 1;
+                    append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+                    continue;
+                }
+                XML_X = 0;
+            }
+
+            if (XML_M)
+            {
+                if ((file_data_character == 'l') || (file_data_character == 'L'))
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "Tag names cannot start with 'xml' or "
+                             "any of its variants like XML, Xml, etc.");
+
+                    return result_obj;
+                }
+                XML_X = 0;
+                XML_M = 0;
+            }
+
+
+/* ########################################################################## */
+/*                              XML ATTRIBUTE VALUE                           */
+/* ########################################################################## */
+            if (XML_ATTRIBUTE_VALUE)
+            {
+                if (file_data_character == '<')
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "Attribute values may not contain the "
+                             "less-than (<) characters.");
+
+                    return result_obj;
+                }
+
+                if (file_data_character == '&')
+                {
+                    if (!XML_AMPERSAND)
+                    {
+                        cer_i = 0;
+
+                        memset( &character_entry_reference[0], 
+                                0, 
+                                CHARACTER_ENTRY_REFERENCE_MAX_LENGTH);
+
+                        character_entry_reference[0] = '&';
+
+                        XML_AMPERSAND = 1;
+
+                        continue;
+                    }
+                }
+
+                if (file_data_character == ';')
+                {
+                    if (parse_cer(&character_entry_reference))
+                    {
+                        append_character_to_word( &word, 
+                                                  character_entry_reference[0], 
+                                                  &word_len, 
+                                                  &word_capacity);
+                    }
+                    else
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Attribute values may contain the ampersand (&) "
+                                 "characters only as character entity references.");
+
+                        return result_obj;
+                    }
+
+                    XML_AMPERSAND = 0;
+                    continue;
+                }
+
+                if (XML_AMPERSAND)
+                {
+                    if (cer_i == (CHARACTER_ENTRY_REFERENCE_MAX_LENGTH - 1))
+                    {
+                        const char *MESSAGE_PART_1 = "Attribute values may contain "
+                                                     "the ampersand (&) characters "
+                                                     "only as character entity "
+                                                     "references. ";
+
+                        const char *MESSAGE_PART_2 = "Character entry references "
+                                                     "may contain atmost ";
+
+                        const char *MESSAGE_PART_3 = " number of characters.";
+
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "%s%s%d%s", 
+                                 MESSAGE_PART_1, 
+                                 MESSAGE_PART_2, 
+                                 CHARACTER_ENTRY_REFERENCE_MAX_LENGTH, 
+                                 MESSAGE_PART_3);
+
+                        return result_obj;
+                    }
+
+                    character_entry_reference [cer_i++] = file_data_character;
+                    continue;
+                }
+
+                if (((file_data_character == '\'') && XML_SINGLE_QUOTE) 
+                ||  ((file_data_character == '\"') && XML_DOUBLE_QUOTE))
+                {
+                    if (XML_AMPERSAND)
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Attribute values may contain the ampersand (&) "
+                                 "characters only as character entity references.");
+
+                        return result_obj;
+                    }
+
+                    /* Working on attribute value. */
+
+                    word [word_len] = 0;
+
+                    if (access_mode == XSXML_RAM_MODE)
+                    {
+                        parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                       XSXML_ATTRIBUTE_VALUE, 
+                                                       node_level, 
+                                                       word, 
+                                                       (size_t) word_len);
+                    }
+                    else /* if (access_mode == XSXML_FILE_MODE) */
+                    {
+                        parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                        XSXML_ATTRIBUTE_VALUE, 
+                                                        node_level, 
+                                                        word);
+                    }
+
+                    /* The below code is just a test code for debugging purposes. */
+                    /* printf("  &  ATTRIBUTE VALUE = %s", word);                 */
+
+                    reset_word(&word, &word_len);
+
+                    XML_ATTRIBUTE       = 1;
+                    XML_ATTRIBUTE_NAME  = 0;
+                    XML_ATTRIBUTE_VALUE = 0;
+                    XML_SINGLE_QUOTE    = 0;
+                    XML_DOUBLE_QUOTE    = 0;
+                    XML_EQUAL           = 0;
+                    continue;
+                }
+
+                append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+                continue;
+            }
+
+
+/* ########################################################################## */
+/*                                 XML END TAG                                */
+/* ########################################################################## */
+            if (file_data_character == '>')
+            {
+                if (XML_ATTRIBUTE_NAME)
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "If empty, then attribute values must atleast "
+                             "contain the double quotes ("").");
+
+                    return result_obj;
+                }
+
+                XML_TAG_RECENTLY_CLOSED = 0;
+
+                /* An empty (self-closing) tag does not open a new level. */
+                if (XML_FORWARD_SLASH_END)
+                {
+                    XML_FORWARD_SLASH_END   = 0;
+
+                    XML_TAG_RECENTLY_CLOSED = 1;
+                }
+
+                if (XML_ATTRIBUTE)
+                {
+                    if (!XML_TAG_RECENTLY_CLOSED) node_level++;
+                    XML_TAG       = 0;
+                    XML_ATTRIBUTE = 0;
+                    continue;
+                }
+
+                XML_TAG       = 0;
+                XML_ATTRIBUTE = 0;
+
+                if (XML_FORWARD_SLASH_START)
+                {
+                    node_level--;
+                    XML_FORWARD_SLASH_START = 0;
+                    reset_word(&word, &word_len);
+
+                    XML_TAG_RECENTLY_CLOSED = 1;
+
+                    if (node_level < 0) continue;
+
+                    if (access_mode == XSXML_RAM_MODE)
+                    {
+                        parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                       XSXML_END_TAG, 
+                                                       node_level, 
+                                                       word, 
+                                                       (size_t) word_len);
+                    }
+                    else /* if (access_mode == XSXML_FILE_MODE) */
+                    {
+                        parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                        XSXML_END_TAG, 
+                                                        node_level, 
+                                                        word);
+                    }
+
+                    continue;
+                }
+
+                /* Working on tag. */
+
+                word [word_len] = 0;
+
+                if (access_mode == XSXML_RAM_MODE)
+                {
+                    if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                        XSXML_TAG, 
+                                                        node_level, 
+                                                        word, 
+                                                        (size_t) word_len))
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "There cannot be more than one outermost tag.");
+
+                        return result_obj;
+                    }
+                }
+                else /* if (access_mode == XSXML_FILE_MODE) */
+                {
+                    if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                         XSXML_TAG, 
+                                                         node_level, 
+                                                         word))
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "There cannot be more than one outermost tag.");
+
+                        return result_obj;
+                    }
+                }
+
+                /* The below code is just a test code for debugging purposes.     */
+                /* printf("\n\n%*sTAG = %s", node_level * INDENTATION, "", word); */
+
+                reset_word(&word, &word_len);
+
+                if (!XML_TAG_RECENTLY_CLOSED) /* && (!XML_FORWARD_SLASH_START) */
+                {
+                    node_level++;
+                }
+
+                continue;
+            }
+
+
+/* ########################################################################## */
+/*                                 XML ATTRIBUTE                              */
+/* ########################################################################## */
+            if (XML_ATTRIBUTE)
+            {
+                if (file_data_character == ' ') continue;
+
+                if (XML_FORWARD_SLASH_START)
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "End tags cannot have any attributes.");
+
+                    return result_obj;
+                }
+
+                if (file_data_character == '=')
+                {
+                    if (!XML_ATTRIBUTE_NAME)
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Attribute names cannot be empty "
+                                 "(i.e. contain a lone equal-to sign (=).");
+
+                        return result_obj;
+                    }
+
+                    /* Working on attribute name. */
+
+                    word [word_len] = 0;
+
+                    if (access_mode == XSXML_RAM_MODE)
+                    {
+                        if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                            XSXML_ATTRIBUTE_NAME, 
+                                                            node_level, 
+                                                            word, 
+                                                            (size_t) word_len))
+                        {
+                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                            sprintf( &result_obj->result_message[0], 
+                                     "Within a given tag, attributes "
+                                     "cannot share the same name.");
+
+                            return result_obj;
+                        }
+                    }
+                    else /* if (access_mode == XSXML_FILE_MODE) */
+                    {
+                        if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                             XSXML_ATTRIBUTE_NAME, 
+                                                             node_level, 
+                                                             word))
+                        {
+                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                            sprintf( &result_obj->result_message[0], 
+                                     "Within a given tag, attributes "
+                                     "cannot share the same name.");
+
+                            return result_obj;
+                        }
+                    }
+
+                    /* The below code is just a test code for debugging purposes.              */
+                    /* printf("\n%*sATTRIBUTE NAME = %s", node_level * INDENTATION, "", word); */
+
+                    reset_word(&word, &word_len);
+
+                    if (file_data_character == '=') XML_EQUAL = 1;
+
+                    continue;
+                }
+
+                if (XML_EQUAL)
+                {
+                    if (file_data_character == '\'')
+                    {
+                        XML_AMPERSAND       = 0;
+                        XML_DOUBLE_QUOTE    = 0;
+                        XML_SINGLE_QUOTE    = 1;
+                        XML_ATTRIBUTE_VALUE = 1;
+                        continue;
+                    }
+                    else if (file_data_character == '\"')
+                    {
+                        XML_AMPERSAND       = 0;
+                        XML_SINGLE_QUOTE    = 0;
+                        XML_DOUBLE_QUOTE    = 1;
+                        XML_ATTRIBUTE_VALUE = 1;
+                        continue;
+                    }
+                    else
+                    {
+                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                        sprintf( &result_obj->result_message[0], 
+                                 "Attribute assignment (=) must be followed "
+                                 "either by a single quote (') "
+                                 "or a double quote (\").");
+
+                        return result_obj;
+                    }
+                }
+
+                if (file_data_character != '/')
+                {
+                    if (!XML_ATTRIBUTE_NAME)
+                    {
+                        if (!isalpha(file_data_character) && file_data_character != '_')
+                        {
+                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                            sprintf( &result_obj->result_message[0], 
+                                     "Attribute names must start with an "
+                                     "alphabetical character [a-zA-Z] or "
+                                     "underscore (_)");
+
+                            return result_obj;
+                        }
+
+                        XML_ATTRIBUTE_NAME = 1;
+                    }
+
+                    append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+
+                    continue;
+                }
+            }
+
+
+/* ########################################################################## */
+/*                             XML TAG ... CONT'D                             */
+/* ########################################################################## */
+            if (file_data_character == '/')
+            {
+                if (XML_FORWARD_SLASH_START)
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "A tag cannot have more than one forward slash.");
+
+                    return result_obj;
+                }
+
+                XML_FORWARD_SLASH_END = 1;
+
+                continue;
+            }
+
+            if (file_data_character == ' ')
+            {
+                if (word_len != 0)
+                {
+                    /* Working on tag. */
+
+                    word [word_len] = 0;
+
+                    if (access_mode == XSXML_RAM_MODE)
+                    {
+                        if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
+                                                            XSXML_TAG, 
+                                                            node_level, 
+                                                            word, 
+                                                            (size_t) word_len))
+                        {
+                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                            sprintf( &result_obj->result_message[0], 
+                                     "There cannot be more than one outermost tag.");
+
+                            return result_obj;
+                        }
+                    }
+                    else /* if (access_mode == XSXML_FILE_MODE) */
+                    {
+                        if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
+                                                             XSXML_TAG, 
+                                                             node_level, 
+                                                             word))
+                        {
+                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                            sprintf( &result_obj->result_message[0], 
+                                     "There cannot be more than one outermost tag.");
+
+                            return result_obj;
+                        }
+                    }
+
+                    /* The below code is just a test code for debugging purposes.     */
+                    /* printf("\n\n%*sTAG = %s", node_level * INDENTATION, "", word); */
+
+                    reset_word(&word, &word_len);
+
+                    XML_ATTRIBUTE      = 1;
+                    XML_ATTRIBUTE_NAME = 0;
+                }
+
+                continue;
+            }
+
+            if (file_data_character == '=')
+            {
+                if (XML_ATTRIBUTE_VALUE)
+                {
+                    append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+                }
+
+                if (XML_ATTRIBUTE)
+                {
+                    XML_ATTRIBUTE_VALUE = 1;
+                }
+
+                continue;
+            }
+
+            if (!isalnum(file_data_character) && (file_data_character != '-') 
+            && (file_data_character != '_')    && (file_data_character != '.'))
+            {
+                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                sprintf( &result_obj->result_message[0], 
+                         "Tag names may contain letters [a-zA-z], "
+                         "digits [0-9], hyphens (-), underscores (_), "
+                         "and periods (.) only.");
+
+                return result_obj;
+            }
+
+            append_character_to_word(&word, file_data_character, &word_len, &word_capacity);
+
+            continue;
+        }
+
+
+/* ########################################################################## */
+/*                                  XML PCDATA                                */
+/* ########################################################################## */
+        if ((file_data_character ==  ' ') || (file_data_character == '\r') 
+        ||  (file_data_character == '\n') || (file_data_character == '\t') 
+        ||  (file_data_character == '\v') || (file_data_character == '\f'))
+        {
+            if (XML_AMPERSAND)
+            {
+                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                sprintf( &result_obj->result_message[0], 
+                         "A tag's PCDATA may contain the ampersand (&) "
+                         "characters only as character entity references.");
+
+                return result_obj;
+            }
+
+            if (!XML_PCDATA_CONTENT) continue;
+
+            if (!XML_WHITESPACE)
+            {
+                XML_WHITESPACE = 1;
+                append_character_to_content( &word, 
+                                             ' ', 
+                                             &word_len, 
+                                             &word_capacity, 
+                                             &lazy_word, 
+                                             source_offset, 
+                                             source_offset, 
+                                             file_data_character != ' ');
+            }
+            else
+            {
+                /* The whitespace characters collapse into a single space. */
+                lazy_word.needs_decoding = 1;
+            }
+            continue;
+        }
+
+        XML_WHITESPACE = 0;
+
+        if (file_data_character == '<')
+        {
+            if (XML_AMPERSAND)
+            {
+                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                sprintf( &result_obj->result_message[0], 
+                         "1A tag's PCDATA may contain the ampersand (&) "
+                         "characters only as character entity references.");
+
+                return result_obj;
+            }
+
+            XML_TAG                 = 1;
+            XML_AMPERSAND           = 0;
+            XML_FORWARD_SLASH_START = 0;
+            XML_FORWARD_SLASH_END   = 0;
+
+            markup_offset = source_offset;
+
+            continue;
+        }
+
+        if (file_data_character == '&')
+        {
+            if (!XML_AMPERSAND)
+            {
+                cer_i = 0;
+
+                memset( &character_entry_reference[0], 
+                        0, 
+                        CHARACTER_ENTRY_REFERENCE_MAX_LENGTH);
+
+                character_entry_reference[0] = '&';
+
+                XML_AMPERSAND = 1;
+
+                ampersand_offset = source_offset;
+
+                continue;
+            }
+        }
+
+        if (file_data_character == ';')
+        {
+            if (parse_cer(&character_entry_reference))
+            {
+                if (node_level == 0)
+                {
+                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                    sprintf( &result_obj->result_message[0], 
+                             "Parsed character data (PCDATA or text data) "
+                             "cannot be placed outside the outermost tag.");
+
+                    return result_obj;
+                }
+
+                append_character_to_content( &word, 
+                                             character_entry_reference[0], 
+                                             &word_len, 
+                                             &word_capacity, 
+                                             &lazy_word, 
+                                             ampersand_offset, 
+                                             source_offset, 
+                                             1);
+
+                /* A content may also begin with a character entity reference. */
+                XML_PCDATA_CONTENT = 1;
+            }
+            else
+            {
+                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                sprintf( &result_obj->result_message[0], 
+                         "A tag's PCDATA may contain the ampersand (&) "
+                         "characters only as character entity references.");
+
+                return result_obj;
+            }
+
+            XML_AMPERSAND = 0;
+            continue;
+        }
+
+        if (XML_AMPERSAND)
+        {
+            if (cer_i == (CHARACTER_ENTRY_REFERENCE_MAX_LENGTH - 1))
+            {
+                const char *MESSAGE_PART_1 = "A tag's PCDATA may contain the "
+                                             "ampersand (&) characters only as "
+                                             "character entity references.";
+
+                const char *MESSAGE_PART_2 = "Character entry references "
+                                             "may contain atmost ";
+
+                const char *MESSAGE_PART_3 = " number of characters.";
+
+                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+                sprintf( &result_obj->result_message[0], 
+                         "%s%s%d%s", 
+                         MESSAGE_PART_1, 
+                         MESSAGE_PART_2, 
+                         CHARACTER_ENTRY_REFERENCE_MAX_LENGTH, 
+                         MESSAGE_PART_3);
+
+                return result_obj;
+            }
+
+            character_entry_reference [cer_i++] = file_data_character;
+            continue;
+        }
+
+        if (node_level == 0)
+        {
+            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+            sprintf( &result_obj->result_message[0], 
+                     "Parsed character data (PCDATA or text data) "
+                     "cannot be placed outside the outermost tag.");
+
+            return result_obj;
+        }
+
+
+        XML_X                   = 0;    /* X */
+        XML_M                   = 0;    /* M */
+        XML_EQUAL               = 0;    /* = */
+        XML_HYPHEN              = 0;    /* - */
+        XML_QUESTION            = 0;    /* ? */
+        XML_AMPERSAND           = 0;    /* & */
+        XML_SINGLE_QUOTE        = 0;    /* - */
+        XML_DOUBLE_QUOTE        = 0;    /* - */
+        XML_FORWARD_SLASH_END   = 0;    /* / */
+        XML_FORWARD_SLASH_START = 0;    /* / */
+        XML_END_SQUARE_BRACKET  = 0;    /* ] */
+
+
+        XML_PCDATA_CONTENT = 1;
+
+        append_character_to_content( &word, 
+                                     file_data_character, 
+                                     &word_len, 
+                                     &word_capacity, 
+                                     &lazy_word, 
+                                     source_offset, 
+                                     source_offset, 
+                                     0);
+    }
+
+
+/* ########################################################################## */
+/*                          XML TAGS COMPLETION CHECK                         */
+/* ########################################################################## */
+    if (node_level != 0)
+    {
+        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+
+        if (XML_CDATA_CONTENT)
+        {
+            sprintf( &result_obj->result_message[0], 
+                     "A CDATA entity does not terminate.");
+        }
+        else
+        {
+            sprintf( &result_obj->result_message[0], 
+                     "%lld start tag elements do not have their end tag counterparts.", 
+                     node_level);
+        }
+
+        return result_obj;
+    }
+
+    free(word);
+    free(character_entry_reference);
+
+    result_obj->result_code = XSXML_RESULT_SUCCESS;
+
+    return result_obj;
+}
+
+
+Xsxml *xsxml_parse(const char *input_file_path)
+{
+    return xsxml_parse_with_options(input_file_path, XSXML_PARSE_OPTION_NONE);
+}
+
+
+/* Parses the file into an object that holds no nodes, though it may */
+/* hold a node array, and a source buffer, to be reused.              */
+static void parse_file( Xsxml *xsxml_object, 
+                        const char *input_file_path, 
+                        unsigned int parse_options)
+{
+    if ((input_file_path == NULL) || (strlen(input_file_path) == 0))
+    {
+        xsxml_object->result = XSXML_RESULT_FILE_FAILURE;
+
+        sprintf( &xsxml_object->result_message[0], 
+                 "The input file path cannot be empty or NULL.");
+
+        return;
+    }
+
+    FILE *file_pointer = fopen(input_file_path, "r");
+
+    if (file_pointer == NULL)
+    {
+        xsxml_object->result = XSXML_RESULT_FILE_FAILURE;
+
+        sprintf( &xsxml_object->result_message[0], 
+                 "The file path '%s' does not exist.", 
+                 input_file_path);
+
+        return;
+    }
+
+    xsxml_object->number_of_nodes = 0;
+
+    if (xsxml_object->node == NULL)
+    {
+        xsxml_object->node = (Xsxml_Nodes **) malloc(sizeof(Xsxml_Nodes *));
+    }
+
+    xsxml_object->memory_usage.number_of_allocations++;
+
+    if (parse_options & XSXML_PARSE_OPTION_LAZY_CONTENT)
+    {
+        /* The source is retained, since the contents are decoded from it */
+        /* only upon their first access.                                  */
+        fseek(file_pointer, 0L, SEEK_END);
+
+        const long FILE_SIZE = ftell(file_pointer);
+
+        fseek(file_pointer, 0L, SEEK_SET);
+
+        /* The plus one (+1) is for the null terminator. */
+        xsxml_object->source_buffer = 
+        (char *) realloc( xsxml_object->source_buffer, 
+                          ((FILE_SIZE > 0) ? FILE_SIZE : 0) + 1);
+
+        xsxml_object->source_length = 
+        fread( xsxml_object->source_buffer, 
+               sizeof(char), 
+               (FILE_SIZE > 0) ? FILE_SIZE : 0, 
+               file_pointer);
+
+        xsxml_object->source_buffer [xsxml_object->source_length] = 0;
+
+        xsxml_object->memory_usage.source_bytes = xsxml_object->source_length + 1;
+
+        xsxml_object->memory_usage.number_of_allocations++;
+    }
+
+    Xsxml_Private_Result *private_result = 
+    parse_operation((void **)&xsxml_object, XSXML_RAM_MODE, file_pointer);
+
+    fclose(file_pointer);
+
+    xsxml_object->result = private_result->result_code;
+
+    if (private_result->result_code == XSXML_RESULT_SUCCESS)
+    {
+        if (parse_options & XSXML_PARSE_OPTION_COLUMNS)
+        {
+            xsxml_columns(xsxml_object);
+        }
+
+        if (parse_options & XSXML_PARSE_OPTION_TAG_INDEX)
+        {
+            xsxml_tag_index(xsxml_object);
+        }
+
+        if (parse_options & XSXML_PARSE_OPTION_ATTRIBUTE_INDEX)
+        {
+            xsxml_attribute_index(xsxml_object);
+        }
+
+        if (parse_options & XSXML_PARSE_OPTION_CONTENT_INDEX)
+        {
+            xsxml_content_index(xsxml_object);
+        }
+
+        sprintf( &xsxml_object->result_message[0], 
+                 "The file '%s' has been successfully parsed.", 
+                 input_file_path);
+    }
+    else
+    {
+        sprintf( &xsxml_object->result_message[0], 
+                 "%s", 
+                 private_result->result_message);
+    }
+
+    free(private_result->result_message);
+
+    /*
+    For some unknown, odd reason, the following code produces the 
+    'Double free or corruption' error:
+
+    free(private_result);
+    */
+}
+
+
+Xsxml *xsxml_parse_with_options( const char *input_file_path, 
+                                 unsigned int parse_options)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml *xsxml_object = (Xsxml *) calloc(1, sizeof(Xsxml));
+
+    xsxml_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+
+    /* The object and its result message. */
+    xsxml_object->memory_usage.number_of_allocations = 2;
+
+    xsxml_object->memory_usage.overhead_bytes = sizeof(Xsxml) + RESULT_MESSAGE_MAX_LENGTH;
+
+    parse_file(xsxml_object, input_file_path, parse_options);
+
+    return xsxml_object;
+}
+
+
+Xsxml_Files *xsxml_files_parse( const char *input_file_path, 
+                                const char *temporary_directory_path)
+{
+    Xsxml_Files *xsxml_files_object = (Xsxml_Files *) malloc(sizeof(Xsxml_Files));
+
+    xsxml_files_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+
+    /* The object and its result message. */
+    xsxml_files_object->memory_usage = (Xsxml_Memory_Usage) { 0 };
+
+    xsxml_files_object->memory_usage.number_of_allocations = 2;
+
+    xsxml_files_object->memory_usage.overhead_bytes = 
+        sizeof(Xsxml_Files) + RESULT_MESSAGE_MAX_LENGTH;
+
+    if ((input_file_path == NULL) || (strlen(input_file_path) == 0))
+    {
+        xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+
+        sprintf( &xsxml_files_object->result_message[0], 
+                 "The input file path cannot be empty or NULL.");
+
+        return xsxml_files_object;
+    }
+
+    FILE *file_pointer = fopen(input_file_path, "r");
+
+    if (file_pointer == NULL)
+    {
+        xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+
+        sprintf( &xsxml_files_object->result_message[0], 
+                 "The file path '%s' does not exist.", 
+                 input_file_path);
+
+        return xsxml_files_object;
+    }
+
+
+    /* The plus one (+1) is for the char array's null terminator. */
+    xsxml_files_object->node_file_name = (char *) malloc(NODE_FILE_NAME_SIZE + 1);
+
+    xsxml_files_object->node_file_name [NODE_FILE_NAME_SIZE] = 0;
+
+    srand(time(NULL));
+
+    for (int i = 0; i < NODE_FILE_NAME_SIZE; i++)
+    {
+        xsxml_files_object->node_file_name [i] = 
+
+            (rand() % NUMBER_OF_ALPHABETIC_CHARACTERS) 
+          + LOWER_CASE_LETTER_A_ASCII_VALUE;
+    }
+
+    if ((temporary_directory_path != NULL) && (temporary_directory_path[0] != 0))
+    {
+        const int TEMPORARY_DIRECTORY_PATH_LEN = strlen(temporary_directory_path);
+
+        /* The plus two (+2) is for the char array's null terminator, */
+        /* plus an additional forward slash (/), if required.         */
+        xsxml_files_object->node_directory_path = (char *) malloc(TEMPORARY_DIRECTORY_PATH_LEN + 2);
+
+        memcpy( &xsxml_files_object->node_directory_path[0], 
+                &temporary_directory_path[0], 
+                TEMPORARY_DIRECTORY_PATH_LEN);
+
+        if (xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN - 1]
+        != '/')
+        {
+            xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN]
+            = '/';
+
+            xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN + 1]
+            = 0;
+        }
+        else
+        {
+            xsxml_files_object->node_directory_path[TEMPORARY_DIRECTORY_PATH_LEN]
+            = 0;
+        }
+
+        FILE *dummy_pointer = open_char_file( xsxml_files_object->node_directory_path, 
+                                              xsxml_files_object->node_file_name, 
+                                              "w");
+
+        if (dummy_pointer == NULL)
+        {
+            xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+
+            sprintf( &xsxml_files_object->result_message[0], 
+                     "The temporary directory path '%s' does not exist.", 
+                     temporary_directory_path);
+
+            return xsxml_files_object;
+        }
+
+        fclose(dummy_pointer);
+
+        delete_char_file( xsxml_files_object->node_directory_path, 
+                          xsxml_files_object->node_file_name);
+    }
+    else /* if (temporary_directory_path == NULL) */
+    {
+        char *file_path_split = strrchr(input_file_path, '/');
+
+        if (file_path_split == NULL)
+        {
+            xsxml_files_object->node_directory_path = (char *) malloc(1);
+
+            xsxml_files_object->node_directory_path[0] = 0;
+        }
+        else
+        {
+            const size_t DIRECTORY_PATH_LEN = file_path_split - input_file_path + 1;
+
+            /* The plus one (+1) is for the char array's null terminator. */
+            xsxml_files_object->node_directory_path = (char *) malloc(DIRECTORY_PATH_LEN + 1);
+
+            /* The directory path retains its trailing forward slash (/). */
+            memcpy( &xsxml_files_object->node_directory_path[0], 
+                    &input_file_path[0], 
+                    DIRECTORY_PATH_LEN);
+
+            xsxml_files_object->node_directory_path [DIRECTORY_PATH_LEN] = 0;
+        }
+    }
+
+    xsxml_files_object->number_of_nodes = 0;
+
+    /* The node file name and the node directory path. */
+    xsxml_files_object->memory_usage.number_of_allocations += 2;
+
+    xsxml_files_object->memory_usage.overhead_bytes += 
+        NODE_FILE_NAME_SIZE + 1 
+      + strlen(xsxml_files_object->node_directory_path) + 1;
+
+    Xsxml_Private_Result *private_result = 
+    parse_operation((void **)&xsxml_files_object, XSXML_FILE_MODE, file_pointer);
+
+    fclose(file_pointer);
+
+    xsxml_files_object->result = private_result->result_code;
+
+    if (private_result->result_code == XSXML_RESULT_SUCCESS)
+    {
+        sprintf( &xsxml_files_object->result_message[0], 
+                 "The file '%s' has been successfully parsed.", 
+                 input_file_path);
+    }
+    else
+    {
+        sprintf( &xsxml_files_object->result_message[0], 
+                 "%s", 
+                 private_result->result_message);
+    }
+
+    free(private_result->result_message);
+
+    /*
+    For some unknown, odd reason, the following code produces the 
+    'Double free or corruption' error:
+
+    free(private_result);
+    */
+
+    return xsxml_files_object;
+}
+
+
+char *xsxml_files_property( Xsxml_Files *xsxml_files_object, 
+                            size_t node_index, 
+                            Xsxml_Property property_name, 
+                            size_t property_index)
+{
+    Xsxml_Char_File_IO io_obj;
+
+    io_obj.temporary_dir_path  = xsxml_files_object->node_directory_path;
+    io_obj.temporary_file_name = xsxml_files_object->node_file_name;
+    io_obj.node_i_value        = node_index;
+    io_obj.property_term       = (char *) PROPERTY_NAMES_LIST [property_name];
+    io_obj.node_j_value        = property_index;
+    io_obj.data_str            = NULL;
+
+    read_from_char_file(&io_obj);
+
+    return io_obj.data_str;
+}
+
+
+static int name_equals( const void *context, 
+                        size_t id, 
+                        const void *key)
+{
+    return strcmp(((char **) context)[id], (const char *) key) == 0;
+}
+
+
+/* The bytes held by the columnar form, along with its name table. */
+static size_t columns_memory_bytes(const Xsxml_Columns *columns)
+{
+    const size_t n            = columns->number_of_nodes;
+    const size_t n_attributes = columns->attribute_start[n];
+    const size_t n_contents   = columns->content_start[n];
+
+    return sizeof(Xsxml_Columns) 
+         + (n + 1)            * (sizeof(char *) + 5 * sizeof(size_t)) 
+         + (n_attributes + 1) * (2 * sizeof(char *) + 2 * sizeof(size_t)) 
+         + (n_contents   + 1) * (sizeof(char *) + sizeof(size_t)) 
+         + sizeof(Xsxml_Name_Table) 
+         + columns->name_table->capacity * 2 * sizeof(size_t);
+}
+
+
+static size_t children_memory_bytes(const Xsxml_Children *children)
+{
+    return sizeof(Xsxml_Children) 
+         + 2 * (children->number_of_nodes + 1) * sizeof(size_t);
+}
+
+
+/* The bytes held by the tag index, along with its name table. */
+static size_t tag_index_memory_bytes(const Xsxml_Tag_Index *tag_index)
+{
+    return sizeof(Xsxml_Tag_Index) 
+         + (tag_index->number_of_names + 1) * sizeof(size_t) 
+         + (tag_index->number_of_nodes + 1) * sizeof(size_t) 
+         + sizeof(Xsxml_Name_Table) 
+         + tag_index->name_table->capacity * 2 * sizeof(size_t);
+}
+
+
+/* The bytes held by the attribute index, along with its name table. */
+static size_t attribute_index_memory_bytes(const Xsxml_Attribute_Index *attribute_index)
+{
+    return sizeof(Xsxml_Attribute_Index) 
+         + (attribute_index->number_of_pairs   + 1) * 2 * sizeof(size_t) 
+         + (attribute_index->number_of_entries + 1) * sizeof(size_t) 
+         + sizeof(Xsxml_Name_Table) 
+         + attribute_index->name_table->capacity * 2 * sizeof(size_t);
+}
+
+
+/* The bytes held by the content index, along with its name table. */
+static size_t content_index_memory_bytes(const Xsxml_Content_Index *content_index)
+{
+    return sizeof(Xsxml_Content_Index) 
+         + (content_index->number_of_trigrams + 1) * 2 * sizeof(size_t) 
+         + (content_index->number_of_entries  + 1) * sizeof(size_t) 
+         + sizeof(Xsxml_Name_Table) 
+         + content_index->name_table->capacity * 2 * sizeof(size_t);
+}
+
+
+Xsxml_Columns *xsxml_columns(Xsxml *xsxml_object)
+{
+    if (xsxml_object->columns != NULL) return xsxml_object->columns;
+
+    xsxml_renumber_nodes(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    size_t n_attributes = 0;
+    size_t n_contents   = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        n_attributes += xsxml_object->node[i]->number_of_attributes;
+        n_contents   += xsxml_object->node[i]->number_of_contents;
+    }
+
+    Xsxml_Columns *columns = (Xsxml_Columns *) malloc(sizeof(Xsxml_Columns));
+
+    columns->number_of_nodes = n;
+    columns->number_of_names = 0;
+
+    /* The plus one (+1) prevents zero-sized allocations, and holds the */
+    /* end of the last range in the case of the range start arrays.     */
+    columns->name            = (char **)        malloc((n + 1) * sizeof(char *));
+    columns->depth           = (size_t *) malloc((n + 1) * sizeof(size_t));
+    columns->name_id         = (size_t *)       malloc((n + 1) * sizeof(size_t));
+    columns->parent          = (size_t *)       malloc((n + 1) * sizeof(size_t));
+    columns->attribute_start = (size_t *)       malloc((n + 1) * sizeof(size_t));
+    columns->content_start   = (size_t *)       malloc((n + 1) * sizeof(size_t));
+
+    columns->attribute_name  = (char **) malloc((n_attributes + 1) * sizeof(char *));
+    columns->attribute_value = (char **) malloc((n_attributes + 1) * sizeof(char *));
+    columns->content         = (char **) malloc((n_contents   + 1) * sizeof(char *));
+
+    columns->attribute_name_length  = (size_t *) malloc((n_attributes + 1) * sizeof(size_t));
+    columns->attribute_value_length = (size_t *) malloc((n_attributes + 1) * sizeof(size_t));
+    columns->content_length         = (size_t *) malloc((n_contents   + 1) * sizeof(size_t));
+
+    columns->name_table = new_name_table();
+
+    /* The index of the most recent node at every depth, in document order. */
+    size_t  last_node_at_depth_capacity = 16;
+    size_t *last_node_at_depth = 
+    (size_t *) malloc(last_node_at_depth_capacity * sizeof(size_t));
+
+    size_t attribute_i = 0;
+    size_t content_i   = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        Xsxml_Nodes *node = xsxml_object->node[i];
+
+        columns->depth[i] = node->depth;
+
+        const size_t NAME_HASH = hash_string(node->node_name, 0);
+
+        size_t name_id = name_table_find( columns->name_table, 
+                                          NAME_HASH, 
+                                          name_equals, 
+                                          columns->name, 
+                                          node->node_name);
+
+        if (name_id == XSXML_NO_NODE)
+        {
+            name_id = columns->number_of_names++;
+
+            columns->name[name_id] = node->node_name;
+
+            name_table_insert(columns->name_table, NAME_HASH, name_id);
+        }
+
+        columns->name_id[i] = name_id;
+
+        if (node->depth >= last_node_at_depth_capacity)
+        {
+            last_node_at_depth_capacity = 2 * node->depth + 1;
+
+            last_node_at_depth = 
+            (size_t *) realloc( last_node_at_depth, 
+                                last_node_at_depth_capacity * sizeof(size_t));
+        }
+
+        if (node->depth == 0)
+            columns->parent[i] = XSXML_NO_NODE;
+        else
+            columns->parent[i] = last_node_at_depth[node->depth - 1];
+
+        last_node_at_depth[node->depth] = i;
+
+        columns->attribute_start[i] = attribute_i;
+
+        for (size_t j = 0; j < node->number_of_attributes; j++)
+        {
+            columns->attribute_name [attribute_i] = node->attribute_name[j];
+            columns->attribute_value[attribute_i] = node->attribute_value[j];
+
+            columns->attribute_name_length [attribute_i] = node->attribute_name_length [j];
+            columns->attribute_value_length[attribute_i] = node->attribute_value_length[j];
+
+            attribute_i++;
+        }
+
+        columns->content_start[i] = content_i;
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            columns->content       [content_i] = node_content(xsxml_object, node, j);
+            columns->content_length[content_i] = node->content_length[j];
+
+            content_i++;
+        }
+    }
+
+    columns->attribute_start[n] = attribute_i;
+    columns->content_start  [n] = content_i;
+
+    free(last_node_at_depth);
+
+    xsxml_object->columns = columns;
+
+    /* The columns and their twelve arrays, and the name table and its two arrays. */
+    xsxml_object->memory_usage.index_bytes += columns_memory_bytes(columns);
+
+    xsxml_object->memory_usage.number_of_allocations += 16;
+
+    return columns;
+}
+
+
+Xsxml_Children *xsxml_children(Xsxml *xsxml_object)
+{
+    if (xsxml_object->children != NULL) return xsxml_object->children;
+
+    xsxml_renumber_nodes(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    Xsxml_Children *children = (Xsxml_Children *) malloc(sizeof(Xsxml_Children));
+
+    children->number_of_nodes = n;
+
+    /* The plus one (+1) prevents a zero-sized allocation, and holds the */
+    /* end of the last range in the case of the range start array.       */
+    children->child_start = (size_t *) malloc((n + 1) * sizeof(size_t));
+    children->child       = (size_t *) malloc((n + 1) * sizeof(size_t));
+
+    size_t child_i = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        children->child_start[i] = child_i;
+
+        child_i += xsxml_object->node[i]->number_of_children;
+    }
+
+    children->child_start[n] = child_i;
+
+    /* The index of the most recent node at every depth, in document order. */
+    size_t  last_node_at_depth_capacity = 16;
+    size_t *last_node_at_depth = 
+    (size_t *) malloc(last_node_at_depth_capacity * sizeof(size_t));
+
+    /* The children of a node are met in document order, and so each is */
+    /* placed after its previous siblings by advancing the range start  */
+    /* of its parent node, which is then moved back.                    */
+    for (size_t i = 0; i < n; i++)
+    {
+        const size_t DEPTH = xsxml_object->node[i]->depth;
+
+        if (DEPTH >= last_node_at_depth_capacity)
+        {
+            last_node_at_depth_capacity = 2 * DEPTH + 1;
+
+            last_node_at_depth = 
+            (size_t *) realloc( last_node_at_depth, 
+                                last_node_at_depth_capacity * sizeof(size_t));
+        }
+
+        if (DEPTH > 0)
+        {
+            children->child[children->child_start[last_node_at_depth[DEPTH - 1]]++] = i;
+        }
+
+        last_node_at_depth[DEPTH] = i;
+    }
+
+    /* Every range start has been advanced to the next range start. */
+    for (size_t i = n; i > 0; i--)
+    {
+        children->child_start[i] = children->child_start[i - 1];
+    }
+
+    children->child_start[0] = 0;
+
+    free(last_node_at_depth);
+
+    xsxml_object->children = children;
+
+    /* The child index and its two arrays. */
+    xsxml_object->memory_usage.index_bytes += children_memory_bytes(children);
+
+    xsxml_object->memory_usage.number_of_allocations += 3;
+
+    return children;
+}
+
+
+size_t xsxml_child( Xsxml *xsxml_object, 
+                    size_t node_index, 
+                    size_t child_position)
+{
+    Xsxml_Children *children = xsxml_children(xsxml_object);
+
+    if ((node_index >= children->number_of_nodes) 
+    ||  (child_position >= xsxml_object->node[node_index]->number_of_children))
+    {
+        return XSXML_NO_NODE;
+    }
+
+    return children->child[children->child_start[node_index] + child_position];
+}
+
+
+/* Returns the first child of the given tag name. */
+size_t xsxml_child_by_name( Xsxml *xsxml_object, 
+                            size_t node_index, 
+                            const char *tag_name)
+{
+    Xsxml_Children *children = xsxml_children(xsxml_object);
+
+    if ((node_index >= children->number_of_nodes) || (tag_name == NULL)) return XSXML_NO_NODE;
+
+    const size_t TAG_NAME_LEN = strlen(tag_name);
+
+    for (size_t k = children->child_start[node_index]; k < children->child_start[node_index + 1]; k++)
+    {
+        const Xsxml_Nodes *child_node = xsxml_object->node[children->child[k]];
+
+        if ((child_node->node_name_length == TAG_NAME_LEN) 
+        &&  (memcmp(child_node->node_name, tag_name, TAG_NAME_LEN) == 0))
+        {
+            return children->child[k];
+        }
+    }
+
+    return XSXML_NO_NODE;
+}
+
+
+static int strings_equal( const char *string_1, 
+                          size_t string_1_length, 
+                          const char *string_2, 
+                          size_t string_2_length)
+{
+    return (string_1_length == string_2_length) 
+        && (memcmp(string_1, string_2, string_1_length) == 0);
+}
+
+
+/* The context of the tag index's name table, through which the tag  */
+/* name of every identifier is that of its first node, in document   */
+/* order, as the tag names are not copied.                           */
+typedef struct Xsxml_Tag_Index_Context
+{
+    Xsxml_Nodes **node;
+
+    /* Laid out as node[node_start[id]] once the index is built, whereas */
+    /* node_start is the array of first nodes, and node is NULL, before. */
+    const size_t *node_start;
+    const size_t *tag_node;
+
+} Xsxml_Tag_Index_Context;
+
+
+static int tag_name_equals( const void *context, 
+                            size_t id, 
+                            const void *key)
+{
+    const Xsxml_Tag_Index_Context *tag_context = (const Xsxml_Tag_Index_Context *) context;
+
+    const size_t FIRST_NODE = (tag_context->tag_node == NULL) 
+                            ? tag_context->node_start[id] 
+                            : tag_context->tag_node[tag_context->node_start[id]];
+
+    return strcmp(tag_context->node[FIRST_NODE]->node_name, (const char *) key) == 0;
+}
+
+
+/* Returns the identifier of the given tag name, or XSXML_NO_NODE if no */
+/* node has the given tag name.                                          */
+static size_t tag_index_find( Xsxml *xsxml_object, 
+                              const Xsxml_Tag_Index *tag_index, 
+                              const char *tag_name)
+{
+    const Xsxml_Tag_Index_Context tag_context = 
+        { xsxml_object->node, tag_index->node_start, tag_index->node };
+
+    return name_table_find( tag_index->name_table, 
+                            hash_string(tag_name, 0), 
+                            tag_name_equals, 
+                            &tag_context, 
+                            tag_name);
+}
+
+
+Xsxml_Tag_Index *xsxml_tag_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->tag_index != NULL) return xsxml_object->tag_index;
+
+    xsxml_renumber_nodes(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    Xsxml_Tag_Index *tag_index = (Xsxml_Tag_Index *) malloc(sizeof(Xsxml_Tag_Index));
+
+    tag_index->number_of_nodes = n;
+    tag_index->number_of_names = 0;
+    tag_index->name_table      = new_name_table();
+
+    /* The name identifier of every node, and the first node of every */
+    /* tag name, until the ranges are laid out.                       */
+    size_t *name_id    = (size_t *) malloc((n + 1) * sizeof(size_t));
+    size_t *first_node = (size_t *) malloc((n + 1) * sizeof(size_t));
+
+    const Xsxml_Tag_Index_Context tag_context = { xsxml_object->node, first_node, NULL };
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const char *NODE_NAME = xsxml_object->node[i]->node_name;
+
+        const size_t NAME_HASH = hash_string(NODE_NAME, 0);
+
+        name_id[i] = name_table_find( tag_index->name_table, 
+                                      NAME_HASH, 
+                                      tag_name_equals, 
+                                      &tag_context, 
+                                      NODE_NAME);
+
+        if (name_id[i] == XSXML_NO_NODE)
+        {
+            name_id[i] = tag_index->number_of_names++;
+
+            first_node[name_id[i]] = i;
+
+            name_table_insert(tag_index->name_table, NAME_HASH, name_id[i]);
+        }
+    }
+
+    free(first_node);
+
+    /* The plus one (+1) holds the end of the last range. */
+    tag_index->node_start = 
+    (size_t *) calloc(tag_index->number_of_names + 1, sizeof(size_t));
+
+    tag_index->node = (size_t *) malloc((n + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < n; i++) tag_index->node_start[name_id[i] + 1]++;
+
+    for (size_t k = 0; k < tag_index->number_of_names; k++)
+    {
+        tag_index->node_start[k + 1] += tag_index->node_start[k];
+    }
+
+    /* The nodes are met in document order, and so each is placed after */
+    /* the previous nodes of its tag name by advancing the range start  */
+    /* of the tag name, which is then moved back.                       */
+    for (size_t i = 0; i < n; i++)
+    {
+        tag_index->node[tag_index->node_start[name_id[i]]++] = i;
+    }
+
+    for (size_t k = tag_index->number_of_names; k > 0; k--)
+    {
+        tag_index->node_start[k] = tag_index->node_start[k - 1];
+    }
+
+    tag_index->node_start[0] = 0;
+
+    free(name_id);
+
+    xsxml_object->tag_index = tag_index;
+
+    /* The tag index and its two arrays, and the name table and its two arrays. */
+    xsxml_object->memory_usage.index_bytes += tag_index_memory_bytes(tag_index);
+
+    xsxml_object->memory_usage.number_of_allocations += 6;
+
+    return tag_index;
+}
+
+
+/* The pair of attribute name and attribute value searched for. */
+typedef struct Xsxml_Attribute_Pair
+{
+    const char *name;
+    size_t name_length;
+
+    const char *value;
+    size_t value_length;
+
+} Xsxml_Attribute_Pair;
+
+
+/* The context of the attribute index's name table, which is laid out in */
+/* the same manner as that of the tag index, along with the attribute    */
+/* index of every pair within its first node.                            */
+typedef struct Xsxml_Attribute_Index_Context
+{
+    Xsxml_Nodes **node;
+
+    const size_t *node_start;
+    const size_t *pair_node;
+    const size_t *first_attribute;
+
+} Xsxml_Attribute_Index_Context;
+
+
+static size_t hash_attribute_pair( const char *attribute_name, 
+                                   const char *attribute_value)
+{
+    /* The null terminator of the name is hashed as well, so that the pairs */
+    /* whose concatenations are the same are still told apart.              */
+    size_t hash = hash_string(attribute_name, 0);
+
+    hash *= (size_t) 1099511628211ULL;
+
+    return hash_string(attribute_value, hash);
+}
+
+
+static int attribute_pair_equals( const void *context, 
+                                  size_t id, 
+                                  const void *key)
+{
+    const Xsxml_Attribute_Index_Context *pair_context = 
+        (const Xsxml_Attribute_Index_Context *) context;
+
+    const Xsxml_Attribute_Pair *pair = (const Xsxml_Attribute_Pair *) key;
+
+    const size_t FIRST_NODE = (pair_context->pair_node == NULL) 
+                            ? pair_context->node_start[id] 
+                            : pair_context->pair_node[pair_context->node_start[id]];
+
+    const Xsxml_Nodes *node = pair_context->node[FIRST_NODE];
+
+    const size_t j = pair_context->first_attribute[id];
+
+    return strings_equal( node->attribute_name[j], node->attribute_name_length[j], 
+                          pair->name, pair->name_length) 
+        && strings_equal( node->attribute_value[j], node->attribute_value_length[j], 
+                          pair->value, pair->value_length);
+}
+
+
+/* Returns the identifier of the given pair of attribute name and attribute */
+/* value, or XSXML_NO_NODE if no node has the given pair.                   */
+static size_t attribute_index_find( Xsxml *xsxml_object, 
+                                    const Xsxml_Attribute_Index *attribute_index, 
+                                    const char *attribute_name, 
+                                    const char *attribute_value)
+{
+    const Xsxml_Attribute_Index_Context pair_context = 
+        { xsxml_object->node, 
+          attribute_index->node_start, 
+          attribute_index->node, 
+          attribute_index->first_attribute };
+
+    const Xsxml_Attribute_Pair pair = 
+        { attribute_name, strlen(attribute_name), attribute_value, strlen(attribute_value) };
+
+    return name_table_find( attribute_index->name_table, 
+                            hash_attribute_pair(attribute_name, attribute_value), 
+                            attribute_pair_equals, 
+                            &pair_context, 
+                            &pair);
+}
+
+
+Xsxml_Attribute_Index *xsxml_attribute_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->attribute_index != NULL) return xsxml_object->attribute_index;
+
+    xsxml_renumber_nodes(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    size_t n_attributes = 0;
+
+    for (size_t i = 0; i < n; i++) n_attributes += xsxml_object->node[i]->number_of_attributes;
+
+    Xsxml_Attribute_Index *attribute_index = 
+    (Xsxml_Attribute_Index *) malloc(sizeof(Xsxml_Attribute_Index));
+
+    attribute_index->number_of_nodes   = n;
+    attribute_index->number_of_pairs   = 0;
+    attribute_index->number_of_entries = 0;
+    attribute_index->name_table        = new_name_table();
+
+    /* The pair identifier of every attribute, and the first node of every */
+    /* pair, until the ranges are laid out. The plus one (+1) prevents     */
+    /* zero-sized allocations.                                             */
+    size_t *pair_id    = (size_t *) malloc((n_attributes + 1) * sizeof(size_t));
+    size_t *first_node = (size_t *) malloc((n_attributes + 1) * sizeof(size_t));
+
+    attribute_index->first_attribute = (size_t *) malloc((n_attributes + 1) * sizeof(size_t));
+
+    const Xsxml_Attribute_Index_Context pair_context = 
+        { xsxml_object->node, first_node, NULL, attribute_index->first_attribute };
+
+    size_t attribute_i = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const Xsxml_Nodes *node = xsxml_object->node[i];
+
+        for (size_t j = 0; j < node->number_of_attributes; j++)
+        {
+            const Xsxml_Attribute_Pair pair = 
+                { node->attribute_name [j], node->attribute_name_length [j], 
+                  node->attribute_value[j], node->attribute_value_length[j] };
+
+            const size_t PAIR_HASH = hash_attribute_pair(pair.name, pair.value);
+
+            size_t id = name_table_find( attribute_index->name_table, 
+                                         PAIR_HASH, 
+                                         attribute_pair_equals, 
+                                         &pair_context, 
+                                         &pair);
+
+            if (id == XSXML_NO_NODE)
+            {
+                id = attribute_index->number_of_pairs++;
+
+                first_node[id] = i;
+
+                attribute_index->first_attribute[id] = j;
+
+                name_table_insert(attribute_index->name_table, PAIR_HASH, id);
+            }
+
+            pair_id[attribute_i++] = id;
+        }
+    }
+
+    /* The plus one (+1) holds the end of the last range. */
+    attribute_index->node_start = 
+    (size_t *) calloc(attribute_index->number_of_pairs + 1, sizeof(size_t));
+
+    /* A node that has the same pair twice is listed once, and so the last */
+    /* node listed for every pair is kept, in place of its first node.     */
+    for (size_t k = 0; k < attribute_index->number_of_pairs; k++) first_node[k] = XSXML_NO_NODE;
+
+    size_t *last_node = first_node;
+
+    attribute_i = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
+        {
+            const size_t id = pair_id[attribute_i++];
+
+            if (last_node[id] != i)
+            {
+                last_node[id] = i;
+
+                attribute_index->node_start[id + 1]++;
+
+                attribute_index->number_of_entries++;
+            }
+        }
+    }
+
+    for (size_t k = 0; k < attribute_index->number_of_pairs; k++)
+    {
+        attribute_index->node_start[k + 1] += attribute_index->node_start[k];
+
+        last_node[k] = XSXML_NO_NODE;
+    }
+
+    attribute_index->node = 
+    (size_t *) malloc((attribute_index->number_of_entries + 1) * sizeof(size_t));
+
+    /* The nodes are met in document order, and so each is placed after */
+    /* the previous nodes of its pair by advancing the range start of   */
+    /* the pair, which is then moved back.                              */
+    attribute_i = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
+        {
+            const size_t id = pair_id[attribute_i++];
+
+            if (last_node[id] != i)
+            {
+                last_node[id] = i;
+
+                attribute_index->node[attribute_index->node_start[id]++] = i;
+            }
+        }
+    }
+
+    for (size_t k = attribute_index->number_of_pairs; k > 0; k--)
+    {
+        attribute_index->node_start[k] = attribute_index->node_start[k - 1];
+    }
+
+    attribute_index->node_start[0] = 0;
+
+    free(pair_id);
+    free(last_node);
+
+    xsxml_object->attribute_index = attribute_index;
+
+    /* The attribute index and its three arrays, and the name table and its two arrays. */
+    xsxml_object->memory_usage.index_bytes += attribute_index_memory_bytes(attribute_index);
+
+    xsxml_object->memory_usage.number_of_allocations += 7;
+
+    return attribute_index;
+}
+
+
+/* The value of the three bytes at the start of the given string. */
+static size_t trigram_value(const char *string)
+{
+    return ((size_t) (unsigned char) string[0] << 16) 
+         | ((size_t) (unsigned char) string[1] << 8) 
+         |  (size_t) (unsigned char) string[2];
+}
+
+
+static size_t hash_trigram(const char *string)
+{
+    const char TRIGRAM [4] = { string[0], string[1], string[2], 0 };
+
+    return hash_string(TRIGRAM, 0);
+}
+
+
+static int trigram_equals( const void *context, 
+                           size_t id, 
+                           const void *key)
+{
+    return ((const size_t *) context)[id] == *((const size_t *) key);
+}
+
+
+/* Returns the identifier of the trigram at the start of the given string, */
+/* or XSXML_NO_NODE if no content holds the trigram.                       */
+static size_t content_index_find( const Xsxml_Content_Index *content_index, 
+                                  const char *string)
+{
+    const size_t TRIGRAM = trigram_value(string);
+
+    return name_table_find( content_index->name_table, 
+                            hash_trigram(string), 
+                            trigram_equals, 
+                            content_index->trigram, 
+                            &TRIGRAM);
+}
+
+
+static double seconds_since(const struct timespec *start_time)
+{
+    struct timespec end_time;
+
+    timespec_get(&end_time, TIME_UTC);
+
+    return (double) (end_time.tv_sec  - start_time->tv_sec) 
+         + (double) (end_time.tv_nsec - start_time->tv_nsec) / 1e9;
+}
+
+
+Xsxml_Content_Index *xsxml_content_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->content_index != NULL) return xsxml_object->content_index;
+
+    struct timespec start_time;
+
+    timespec_get(&start_time, TIME_UTC);
+
+    xsxml_renumber_nodes(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    Xsxml_Content_Index *content_index = 
+    (Xsxml_Content_Index *) malloc(sizeof(Xsxml_Content_Index));
+
+    content_index->number_of_nodes    = n;
+    content_index->number_of_trigrams = 0;
+    content_index->number_of_entries  = 0;
+    content_index->name_table         = new_name_table();
+
+    /* The trigram array grows geometrically, along with the last node */
+    /* counted for every trigram, as the trigrams are met.             */
+    size_t trigram_capacity = 64;
+
+    content_index->trigram = (size_t *) malloc(trigram_capacity * sizeof(size_t));
+
+    size_t *last_node = (size_t *) malloc(trigram_capacity * sizeof(size_t));
+    size_t *count     = (size_t *) malloc(trigram_capacity * sizeof(size_t));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        Xsxml_Nodes *node = xsxml_object->node[i];
+
+        materialise_contents(xsxml_object, node);
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            const char *CONTENT = node->content[j];
+
+            for (size_t p = 0; p + 3 <= node->content_length[j]; p++)
+            {
+                size_t id = content_index_find(content_index, &CONTENT[p]);
+
+                if (id == XSXML_NO_NODE)
+                {
+                    id = content_index->number_of_trigrams++;
+
+                    if (id == trigram_capacity)
+                    {
+                        trigram_capacity *= 2;
+
+                        content_index->trigram = 
+                        (size_t *) realloc( content_index->trigram, 
+                                            trigram_capacity * sizeof(size_t));
+
+                        last_node = (size_t *) realloc(last_node, trigram_capacity * sizeof(size_t));
+                        count     = (size_t *) realloc(count,     trigram_capacity * sizeof(size_t));
+                    }
+
+                    content_index->trigram[id] = trigram_value(&CONTENT[p]);
+
+                    last_node[id] = XSXML_NO_NODE;
+                    count    [id] = 0;
+
+                    name_table_insert(content_index->name_table, hash_trigram(&CONTENT[p]), id);
+                }
+
+                /* A node that holds the same trigram twice is listed once. */
+                if (last_node[id] != i)
+                {
+                    last_node[id] = i;
+
+                    count[id]++;
+
+                    content_index->number_of_entries++;
+                }
+            }
+        }
+    }
+
+    const size_t N_T = content_index->number_of_trigrams;
+
+    /* The trigram array is trimmed down to its size. The plus one (+1) */
+    /* prevents a zero-sized allocation.                                */
+    content_index->trigram = 
+    (size_t *) realloc(content_index->trigram, (N_T + 1) * sizeof(size_t));
+
+    /* The plus one (+1) holds the end of the last range. */
+    content_index->node_start = (size_t *) malloc((N_T + 1) * sizeof(size_t));
+
+    content_index->node_start[0] = 0;
+
+    for (size_t k = 0; k < N_T; k++)
+    {
+        content_index->node_start[k + 1] = content_index->node_start[k] + count[k];
+
+        last_node[k] = XSXML_NO_NODE;
+    }
+
+    content_index->node = 
+    (size_t *) malloc((content_index->number_of_entries + 1) * sizeof(size_t));
+
+    /* The nodes are met in document order, and so each is placed after */
+    /* the previous nodes of its trigram by advancing the range start   */
+    /* of the trigram, which is then moved back.                        */
+    for (size_t i = 0; i < n; i++)
+    {
+        const Xsxml_Nodes *node = xsxml_object->node[i];
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            const char *CONTENT = node->content[j];
+
+            for (size_t p = 0; p + 3 <= node->content_length[j]; p++)
+            {
+                const size_t id = content_index_find(content_index, &CONTENT[p]);
+
+                if (last_node[id] != i)
+                {
+                    last_node[id] = i;
+
+                    content_index->node[content_index->node_start[id]++] = i;
+                }
+            }
+        }
+    }
+
+    for (size_t k = N_T; k > 0; k--)
+    {
+        content_index->node_start[k] = content_index->node_start[k - 1];
+    }
+
+    content_index->node_start[0] = 0;
+
+    free(last_node);
+    free(count);
+
+    xsxml_object->content_index = content_index;
+
+    /* The content index and its three arrays, and the name table and its two arrays. */
+    xsxml_object->memory_usage.index_bytes += content_index_memory_bytes(content_index);
+
+    xsxml_object->memory_usage.number_of_allocations += 7;
+
+    content_index->build_seconds = seconds_since(&start_time);
+
+    return content_index;
+}
+
+
+static int compare_node_indices( const void *node_index_1, 
+                                 const void *node_index_2)
+{
+    const size_t NODE_INDEX_1 = *((const size_t *) node_index_1);
+    const size_t NODE_INDEX_2 = *((const size_t *) node_index_2);
+
+    return (NODE_INDEX_1 > NODE_INDEX_2) - (NODE_INDEX_1 < NODE_INDEX_2);
+}
+
+
+/*
+Lists the nodes, in document order, that hold every trigram of the given 
+string, which are the only nodes whose contents may contain the string, 
+and returns their number. The list is to be freed by the caller. If the 
+string is shorter than a trigram, the list is NULL, and every node may 
+contain the string.
+*/
+static size_t content_index_candidates( const Xsxml_Content_Index *content_index, 
+                                        const char *content, 
+                                        size_t content_length, 
+                                        size_t **candidate)
+{
+    *candidate = NULL;
+
+    if (content_length < 3) return content_index->number_of_nodes;
+
+    const size_t N_Q = content_length - 2;
+
+    size_t *trigram_id = (size_t *) malloc(N_Q * sizeof(size_t));
+
+    /* The trigram with the fewest nodes is the one the others filter. */
+    size_t shortest_q = 0;
+
+    for (size_t q = 0; q < N_Q; q++)
+    {
+        trigram_id[q] = content_index_find(content_index, &content[q]);
+
+        if (trigram_id[q] == XSXML_NO_NODE)
+        {
+            free(trigram_id);
+
+            *candidate = (size_t *) malloc(sizeof(size_t));
+
+            return 0;
+        }
+
+        const size_t *START = &content_index->node_start[trigram_id[q]];
+        const size_t *SHORTEST_START = &content_index->node_start[trigram_id[shortest_q]];
+
+        if (START[1] - START[0] < SHORTEST_START[1] - SHORTEST_START[0]) shortest_q = q;
+    }
+
+    const size_t SHORTEST_START = content_index->node_start[trigram_id[shortest_q]];
+
+    size_t number_of_candidates = 
+        content_index->node_start[trigram_id[shortest_q] + 1] - SHORTEST_START;
+
+    /* The plus one (+1) prevents a zero-sized allocation. */
+    *candidate = (size_t *) malloc((number_of_candidates + 1) * sizeof(size_t));
+
+    memcpy( *candidate, 
+            &content_index->node[SHORTEST_START], 
+            number_of_candidates * sizeof(size_t));
+
+    for (size_t q = 0; (q < N_Q) && (number_of_candidates > 0); q++)
+    {
+        if (trigram_id[q] == trigram_id[shortest_q]) continue;
+
+        const size_t START = content_index->node_start[trigram_id[q]];
+        const size_t END   = content_index->node_start[trigram_id[q] + 1];
+
+        size_t kept = 0;
+
+        for (size_t k = 0; k < number_of_candidates; k++)
+        {
+            if (bsearch( &(*candidate)[k], 
+                         &content_index->node[START], 
+                         END - START, 
+                         sizeof(size_t), 
+                         compare_node_indices) != NULL)
+            {
+                (*candidate)[kept++] = (*candidate)[k];
+            }
+        }
+
+        number_of_candidates = kept;
+    }
+
+    free(trigram_id);
+
+    return number_of_candidates;
+}
+
+
+/* Sets the links of the given nodes, which are in document order, from */
+/* their depths, in the same manner as in the parser.                   */
+static void link_nodes( Xsxml_Nodes **xsxml_node, 
+                        size_t number_of_nodes)
+{
+    /* The index of the most recent node at every depth, in document order. */
+    size_t  last_node_at_depth_capacity = 16;
+    size_t *last_node_at_depth = 
+    (size_t *) malloc(last_node_at_depth_capacity * sizeof(size_t));
+
+    for (size_t i = 0; i < number_of_nodes; i++)
+    {
+        const size_t DEPTH = xsxml_node[i]->depth;
+
+        xsxml_node[i]->ancestor         = NULL;
+        xsxml_node[i]->descendant       = NULL;
+        xsxml_node[i]->next_sibling     = NULL;
+        xsxml_node[i]->previous_sibling = NULL;
+
+        xsxml_node[i]->number_of_children = 0;
+
+        if (DEPTH >= last_node_at_depth_capacity)
+        {
+            last_node_at_depth_capacity = 2 * DEPTH + 1;
+
+            last_node_at_depth = 
+            (size_t *) realloc( last_node_at_depth, 
+                                last_node_at_depth_capacity * sizeof(size_t));
+        }
+
+        if (DEPTH > 0)
+        {
+            Xsxml_Nodes *parent_node = xsxml_node[last_node_at_depth[DEPTH - 1]];
+
+            xsxml_node[i]->ancestor = parent_node;
+
+            parent_node->number_of_children++;
+
+            /* Once the parent node has a descendant, the last node at */
+            /* this depth is the previous sibling.                     */
+            if (parent_node->descendant != NULL)
+            {
+                xsxml_node[i]->previous_sibling = xsxml_node[last_node_at_depth[DEPTH]];
+
+                xsxml_node[i]->previous_sibling->next_sibling = xsxml_node[i];
+            }
+            else
+            {
+                parent_node->descendant = xsxml_node[i];
+            }
+        }
+
+        last_node_at_depth[DEPTH] = i;
+    }
+
+    free(last_node_at_depth);
+}
+
+
+/* Returns the interned identifier (id) of the given name, and adds the  */
+/* bytes of a newly seen name to the given byte count.                   */
+static size_t intern_name( Xsxml_Name_Table *name_table, 
+                           const char **name, 
+                           size_t *name_length, 
+                           size_t *number_of_names, 
+                           const char *new_name, 
+                           size_t new_name_length, 
+                           size_t *string_bytes)
+{
+    const size_t NAME_HASH = hash_string(new_name, 0);
+
+    size_t name_id = name_table_find( name_table, 
+                                      NAME_HASH, 
+                                      name_equals, 
+                                      name, 
+                                      new_name);
+
+    if (name_id == XSXML_NO_NODE)
+    {
+        name_id = (*number_of_names)++;
+
+        name       [name_id] = new_name;
+        name_length[name_id] = new_name_length;
+
+        name_table_insert(name_table, NAME_HASH, name_id);
+
+        /* The plus one (+1) is for the char array's null terminator. */
+        *string_bytes += new_name_length + 1;
+    }
+
+    return name_id;
+}
+
+
+/*
+Copies the given number of nodes, starting at the given node, into a new, 
+standalone Xsxml object. The nodes must make up whole subtrees, and their 
+depths are shifted such that the first node is at depth zero (0).
+
+All the strings of the copy are stored within a single, exactly sized 
+string arena chunk, in which every distinct attribute name and long tag 
+name is stored only once. The node links are derived from the node depths.
+*/
+static Xsxml *copy_nodes( Xsxml *xsxml_object, 
+                          size_t first_node_i, 
+                          size_t number_of_nodes)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml *xsxml_copy = (Xsxml *) calloc(1, sizeof(Xsxml));
+
+    xsxml_copy->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+
+    xsxml_copy->result = XSXML_RESULT_SUCCESS;
+
+    xsxml_copy->number_of_nodes = number_of_nodes;
+
+    /* The plus one (+1) prevents a zero-sized allocation. */
+    xsxml_copy->node = (Xsxml_Nodes **) malloc((number_of_nodes + 1) * sizeof(Xsxml_Nodes *));
+
+    /* The object, its result message, and its node array. */
+    xsxml_copy->memory_usage.number_of_allocations = 3;
+
+    xsxml_copy->memory_usage.overhead_bytes = sizeof(Xsxml) + RESULT_MESSAGE_MAX_LENGTH;
+
+    if (number_of_nodes == 0) return xsxml_copy;
+
+    Xsxml_Nodes **source_node = &xsxml_object->node[first_node_i];
+
+    const size_t BASE_DEPTH = source_node[0]->depth;
+
+    /* The lazily parsed contents are decoded, as the copy is standalone. */
+    size_t number_of_attributes = 0;
+
+    for (size_t i = 0; i < number_of_nodes; i++)
+    {
+        materialise_contents(xsxml_object, source_node[i]);
+
+        number_of_attributes += source_node[i]->number_of_attributes;
+    }
+
+    /* The interned names, where the long tag names come first, and are */
+    /* then followed by the attribute names, in document order.         */
+    const size_t MAX_NAMES = number_of_nodes + number_of_attributes;
+
+    const char **name   = (const char **) malloc(MAX_NAMES * sizeof(char *));
+    size_t *name_length = (size_t *)      malloc(MAX_NAMES * sizeof(size_t));
+    size_t *name_id     = (size_t *)      malloc(MAX_NAMES * sizeof(size_t));
+
+    size_t number_of_names = 0;
+
+    Xsxml_Name_Table *name_table = new_name_table();
+
+    size_t string_bytes = 0;
+    size_t attribute_i  = number_of_nodes;
+
+    for (size_t i = 0; i < number_of_nodes; i++)
+    {
+        const Xsxml_Nodes *node = source_node[i];
+
+        if (node->node_name_length >= XSXML_SHORT_STRING_SIZE)
+        {
+            const size_t PREVIOUS_STRING_BYTES = string_bytes;
+
+            name_id[i] = intern_name( name_table, 
+                                      name, 
+                                      name_length, 
+                                      &number_of_names, 
+                                      node->node_name, 
+                                      node->node_name_length, 
+                                      &string_bytes);
+
+            xsxml_copy->memory_usage.name_bytes += string_bytes - PREVIOUS_STRING_BYTES;
+        }
+
+        for (size_t j = 0; j < node->number_of_attributes; j++)
+        {
+            const size_t PREVIOUS_STRING_BYTES = string_bytes;
+
+            name_id[attribute_i++] = intern_name( name_table, 
+                                                  name, 
+                                                  name_length, 
+                                                  &number_of_names, 
+                                                  node->attribute_name[j], 
+                                                  node->attribute_name_length[j], 
+                                                  &string_bytes);
+
+            xsxml_copy->memory_usage.attribute_bytes += string_bytes - PREVIOUS_STRING_BYTES;
+
+            string_bytes += node->attribute_value_length[j] + 1;
+
+            xsxml_copy->memory_usage.attribute_bytes += node->attribute_value_length[j] + 1;
+        }
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            string_bytes += node->content_length[j] + 1;
+
+            xsxml_copy->memory_usage.content_bytes += node->content_length[j] + 1;
+        }
+    }
+
+    xsxml_unset_name_table(&name_table);
+
+    char *string_chunk = (string_bytes > 0) ? 
+                         reserve_string_arena_chunk(xsxml_copy, string_bytes) : NULL;
+
+    size_t string_i = 0;
+
+    /* The interned names are copied over first. */
+    for (size_t k = 0; k < number_of_names; k++)
+    {
+        memcpy(&string_chunk[string_i], name[k], name_length[k] + 1);
+
+        name[k] = &string_chunk[string_i];
+
+        string_i += name_length[k] + 1;
+    }
+
+    attribute_i = number_of_nodes;
+
+    for (size_t i = 0; i < number_of_nodes; i++)
+    {
+        const Xsxml_Nodes *node = source_node[i];
+
+        Xsxml_Nodes *node_copy = (Xsxml_Nodes *) malloc(sizeof(Xsxml_Nodes));
+
+        xsxml_copy->node[i] = node_copy;
+
+        memcpy(node_copy, node, sizeof(Xsxml_Nodes));
+
+        if (node->node_name_length < XSXML_SHORT_STRING_SIZE)
+            node_copy->node_name = &node_copy->node_name_inline[0];
+        else
+            node_copy->node_name = (char *) name[name_id[i]];
+
+        node_copy->depth       = node->depth - BASE_DEPTH;
+        node_copy->subtree_end = node->subtree_end - first_node_i;
+
+        node_copy->lazy_content = NULL;
+
+        /* Every array holds at least one slot, as with the parsed nodes. */
+        const size_t N_C = (node->number_of_contents   > 0) ? node->number_of_contents   : 1;
+        const size_t N_A = (node->number_of_attributes > 0) ? node->number_of_attributes : 1;
+
+        node_copy->content                = (char **)  malloc(N_C * sizeof(char *));
+        node_copy->content_length         = (size_t *) malloc(N_C * sizeof(size_t));
+        node_copy->attribute_name         = (char **)  malloc(N_A * sizeof(char *));
+        node_copy->attribute_value        = (char **)  malloc(N_A * sizeof(char *));
+        node_copy->attribute_name_length  = (size_t *) malloc(N_A * sizeof(size_t));
+        node_copy->attribute_value_length = (size_t *) malloc(N_A * sizeof(size_t));
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            memcpy(&string_chunk[string_i], node->content[j], node->content_length[j] + 1);
+
+            node_copy->content       [j] = &string_chunk[string_i];
+            node_copy->content_length[j] = node->content_length[j];
+
+            string_i += node->content_length[j] + 1;
+        }
+
+        for (size_t j = 0; j < node->number_of_attributes; j++)
+        {
+            memcpy( &string_chunk[string_i], 
+                    node->attribute_value[j], 
+                    node->attribute_value_length[j] + 1);
+
+            node_copy->attribute_name [j] = (char *) name[name_id[attribute_i++]];
+            node_copy->attribute_value[j] = &string_chunk[string_i];
+
+            node_copy->attribute_name_length [j] = node->attribute_name_length [j];
+            node_copy->attribute_value_length[j] = node->attribute_value_length[j];
+
+            string_i += node->attribute_value_length[j] + 1;
+        }
+
+        /* The node, its slot in the node array, and its six arrays. */
+        xsxml_copy->memory_usage.node_bytes += 
+            sizeof(Xsxml_Nodes) + sizeof(Xsxml_Nodes *);
+
+        xsxml_copy->memory_usage.pointer_array_bytes += 
+            (N_C + 2 * N_A) * (sizeof(char *) + sizeof(size_t));
+
+        xsxml_copy->memory_usage.number_of_allocations += 7;
+    }
+
+    link_nodes(xsxml_copy->node, number_of_nodes);
+
+    free(name);
+    free(name_length);
+    free(name_id);
+
+    return xsxml_copy;
+}
+
+
+Xsxml *xsxml_clone(Xsxml *xsxml_object)
+{
+    xsxml_renumber_nodes(xsxml_object);
+
+    Xsxml *xsxml_clone_object = copy_nodes( xsxml_object, 
+                                            0, 
+                                            xsxml_object->number_of_nodes);
+
+    xsxml_clone_object->result = xsxml_object->result;
+
+    sprintf( &xsxml_clone_object->result_message[0], 
+             "%s", 
+             xsxml_object->result_message);
+
+    return xsxml_clone_object;
+}
+
+
+Xsxml *xsxml_extract_subtree( Xsxml *xsxml_object, 
+                              size_t node_index)
+{
+    xsxml_renumber_nodes(xsxml_object);
+
+    if (node_index >= xsxml_object->number_of_nodes)
+    {
+        Xsxml *xsxml_subtree_object = copy_nodes(xsxml_object, 0, 0);
+
+        xsxml_subtree_object->result = XSXML_RESULT_XML_FAILURE;
+
+        sprintf( &xsxml_subtree_object->result_message[0], 
+                 "The node index %zu is out of range.", 
+                 node_index);
+
+        return xsxml_subtree_object;
+    }
+
+    Xsxml *xsxml_subtree_object = copy_nodes( xsxml_object, 
+                                              node_index, 
+                                              xsxml_subtree_size(xsxml_object, node_index));
+
+    sprintf( &xsxml_subtree_object->result_message[0], 
+             "The subtree of node %zu has been successfully extracted.", 
+             node_index);
+
+    return xsxml_subtree_object;
+}
+
+
+void xsxml_memory_usage( Xsxml *xsxml_object, 
+                         Xsxml_Memory_Usage *memory_usage)
+{
+    *memory_usage = xsxml_object->memory_usage;
+
+    /* The overheads of a snapshot have been reckoned in full, beforehand, */
+    /* as the string arena it shares may since have grown.                 */
+    if (!xsxml_object->is_snapshot)
+    {
+        /* All the strings, except the tag names stored within their nodes, */
+        /* are held by the string arena.                                    */
+        if (xsxml_object->string_arena != NULL)
+        {
+            memory_usage->overhead_bytes += xsxml_object->string_arena->reserved_bytes 
+                                          - memory_usage->name_bytes 
+                                          - memory_usage->content_bytes 
+                                          - memory_usage->attribute_bytes;
+        }
+
+        memory_usage->overhead_bytes += memory_usage->number_of_allocations * ALLOCATION_OVERHEAD;
+    }
+
+    memory_usage->total_bytes = memory_usage->node_bytes 
+                              + memory_usage->name_bytes 
+                              + memory_usage->content_bytes 
+                              + memory_usage->attribute_bytes 
+                              + memory_usage->pointer_array_bytes 
+                              + memory_usage->source_bytes 
+                              + memory_usage->index_bytes 
+                              + memory_usage->overhead_bytes;
+
+    memory_usage->disk_bytes = 0;
+}
+
+
+void xsxml_files_memory_usage( Xsxml_Files *xsxml_files_object, 
+                               Xsxml_Memory_Usage *memory_usage)
+{
+    *memory_usage = xsxml_files_object->memory_usage;
+
+    memory_usage->overhead_bytes += memory_usage->number_of_allocations * ALLOCATION_OVERHEAD;
+
+    /* The nodes themselves are held on disk. */
+    memory_usage->total_bytes = memory_usage->overhead_bytes;
+}
+
+
+size_t xsxml_subtree_size( Xsxml *xsxml_object, 
+                           size_t node_index)
+{
+    xsxml_renumber_nodes(xsxml_object);
+
+    if (node_index >= xsxml_object->number_of_nodes) return 0;
+
+    return xsxml_object->node[node_index]->subtree_end - node_index + 1;
+}
+
+
+/* A node is considered to be within its own subtree. */
+int xsxml_is_within_subtree( Xsxml *xsxml_object, 
+                             size_t subtree_node_index, 
+                             size_t node_index)
+{
+    xsxml_renumber_nodes(xsxml_object);
+
+    if ((subtree_node_index >= xsxml_object->number_of_nodes) 
+    ||  (node_index         >= xsxml_object->number_of_nodes))
+    {
+        return 0;
+    }
+
+    return (node_index >= subtree_node_index) 
+        && (node_index <= xsxml_object->node[subtree_node_index]->subtree_end);
+}
+
+
+char *xsxml_content( Xsxml *xsxml_object, 
+                     size_t node_index, 
+                     size_t content_index)
+{
+    return node_content( xsxml_object, 
+                         xsxml_object->node[node_index], 
+                         content_index);
+}
+
+
+size_t xsxml_node_name_length( Xsxml *xsxml_object, 
+                               size_t node_index)
+{
+    return xsxml_object->node[node_index]->node_name_length;
+}
+
+
+size_t xsxml_content_length( Xsxml *xsxml_object, 
+                             size_t node_index, 
+                             size_t content_index)
+{
+    node_content( xsxml_object, 
+                  xsxml_object->node[node_index], 
+                  content_index);
+
+    return xsxml_object->node[node_index]->content_length[content_index];
+}
+
+
+size_t xsxml_attribute_name_length( Xsxml *xsxml_object, 
+                                    size_t node_index, 
+                                    size_t attribute_index)
+{
+    return xsxml_object->node[node_index]->attribute_name_length[attribute_index];
+}
+
+
+size_t xsxml_attribute_value_length( Xsxml *xsxml_object, 
+                                     size_t node_index, 
+                                     size_t attribute_index)
+{
+    return xsxml_object->node[node_index]->attribute_value_length[attribute_index];
+}
+
+
+/* The lengths are compared first, so that the strings of differing */
+/* lengths are never read.                                           */
+/* A node satisfies the attribute criteria if any one of its attributes */
+/* matches both the given attribute name and attribute value.           */
+static int attributes_match( char **attribute_names, 
+                             const size_t *attribute_name_lengths, 
+                             char **attribute_values, 
+                             const size_t *attribute_value_lengths, 
+                             size_t number_of_attributes, 
+                             const char *attribute_name, 
+                             size_t attribute_name_length, 
+                             const char *attribute_value, 
+                             size_t attribute_value_length)
+{
+    if ((attribute_name == NULL) && (attribute_value == NULL)) return 1;
+
+    for (size_t j = 0; j < number_of_attributes; j++)
+    {
+        if ((attribute_name != NULL) 
+        &&  !strings_equal( attribute_names[j], attribute_name_lengths[j], 
+                            attribute_name, attribute_name_length))
+        {
+            continue;
+        }
+
+        if ((attribute_value != NULL) 
+        &&  !strings_equal( attribute_values[j], attribute_value_lengths[j], 
+                            attribute_value, attribute_value_length))
+        {
+            continue;
+        }
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*
+The case-insensitive comparisons fold the ASCII letters of both strings as 
+they are compared, without copying either. All the other bytes, including 
+those of the multi-byte UTF-8 characters, are compared as they are. 
+*/
+static unsigned char fold_ascii_case(unsigned char character)
+{
+    return ((character >= 'A') && (character <= 'Z')) ? (unsigned char) (character | 0x20) : character;
+}
+
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+/* The upper case letters are the only bytes that the offset brings below */
+/* minus one hundred and two (-102), as signed bytes.                     */
+static __m128i sse2_fold_ascii_case(__m128i block)
+{
+    const __m128i OFFSET_BLOCK = _mm_add_epi8(block, _mm_set1_epi8(0x3F));
+
+    const __m128i IS_UPPER_CASE = _mm_cmpgt_epi8(_mm_set1_epi8(-102), OFFSET_BLOCK);
+
+    return _mm_or_si128(block, _mm_and_si128(IS_UPPER_CASE, _mm_set1_epi8(0x20)));
+}
+#endif
+
+
+/* Sixteen (16) bytes of each string are folded and compared at a time. */
+static int bytes_equal_ignoring_case( const char *bytes_1, 
+                                      const char *bytes_2, 
+                                      size_t number_of_bytes)
+{
+    size_t i = 0;
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+    for (; i + 16 <= number_of_bytes; i += 16)
+    {
+        const __m128i BLOCK_1 = sse2_fold_ascii_case(_mm_loadu_si128((const __m128i *) &bytes_1[i]));
+        const __m128i BLOCK_2 = sse2_fold_ascii_case(_mm_loadu_si128((const __m128i *) &bytes_2[i]));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(BLOCK_1, BLOCK_2)) != 0xFFFF) return 0;
+    }
+#endif
+
+    for (; i < number_of_bytes; i++)
+    {
+        if (fold_ascii_case((unsigned char) bytes_1[i]) != fold_ascii_case((unsigned char) bytes_2[i]))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static int strings_equal_ignoring_case( const char *string_1, 
+                                        size_t string_1_length, 
+                                        const char *string_2, 
+                                        size_t string_2_length)
+{
+    return (string_1_length == string_2_length) 
+        && bytes_equal_ignoring_case(string_1, string_2, string_1_length);
+}
+
+
+/*
+A substring search that is prepared once per query, and applied to every 
+content thereafter, through their stored lengths. Every block of starting 
+positions is checked at once for both the first and the last characters 
+of the searched string, and only the positions where both are found are 
+compared in full. The widest vector instructions of the processor are 
+chosen when the search is prepared, whereas the positions that are left 
+over are found through memchr(). Where there are no vector instructions, 
+the search is left to strstr() instead. 
+
+A case-insensitive search keeps the first and last characters in lower 
+case, along with the case bit (0x20) of those that are letters, so that 
+the blocks are folded by a single OR before they are compared, since only 
+the two cases of a letter become equal to it through its case bit. 
+*/
+typedef struct Xsxml_Substring_Matcher Xsxml_Substring_Matcher;
+
+struct Xsxml_Substring_Matcher
+{
+    const char *string;
+    size_t length;
+
+    char first_character;
+    char last_character;
+
+    int is_case_insensitive;
+
+    /* Zero (0), unless the search is case-insensitive, and the character */
+    /* is a letter.                                                       */
+    char first_case_bit;
+    char last_case_bit;
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+    /* Checks the blocks of the text up to the given last starting */
+    /* position, and sets the position at which the blocks end.    */
+    int (*blocks_match)( const Xsxml_Substring_Matcher *matcher, 
+                         const char *text, 
+                         size_t last_start, 
+                         size_t *position);
+#endif
+};
+
+
+/* Compares the characters in between the first and last ones of the */
+/* searched string with those from the given starting position.      */
+static int substring_middle_matches( const Xsxml_Substring_Matcher *matcher, 
+                                     const char *text, 
+                                     size_t start)
+{
+    const size_t MIDDLE_LEN = (matcher->length > 2) ? matcher->length - 2 : 0;
+
+    if (matcher->is_case_insensitive)
+    {
+        return bytes_equal_ignoring_case(&text[start + 1], &matcher->string[1], MIDDLE_LEN);
+    }
+
+    return (memcmp(&text[start + 1], &matcher->string[1], MIDDLE_LEN) == 0);
+}
+
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+/* Compares the characters in between the first and last ones at each of */
+/* the starting positions given as bits, counted from the given position. */
+static int substring_candidates_match( const Xsxml_Substring_Matcher *matcher, 
+                                       const char *text, 
+                                       size_t position, 
+                                       unsigned long long mask)
+{
+    while (mask != 0)
+    {
+        const size_t START = position + (size_t) __builtin_ctzll(mask);
+
+        if (substring_middle_matches(matcher, text, START)) return 1;
+
+        mask &= mask - 1;
+    }
+
+    return 0;
+}
+
+
+/* The starting positions of the block that hold both the first and the */
+/* last characters of the searched string, as bits.                      */
+static unsigned long long sse2_block_mask( const char *block, 
+                                           size_t length, 
+                                           __m128i first, 
+                                           __m128i last, 
+                                           __m128i first_case_bit, 
+                                           __m128i last_case_bit)
+{
+    const __m128i BLOCK_FIRST = _mm_loadu_si128((const __m128i *) &block[0]);
+    const __m128i BLOCK_LAST  = _mm_loadu_si128((const __m128i *) &block[length - 1]);
+
+    return (unsigned int) _mm_movemask_epi8(
+        _mm_and_si128( _mm_cmpeq_epi8(_mm_or_si128(BLOCK_FIRST, first_case_bit), first), 
+                       _mm_cmpeq_epi8(_mm_or_si128(BLOCK_LAST,  last_case_bit),  last)));
+}
+
+
+/* The sixty-four (64) starting positions of each step are checked in */
+/* blocks, and the last step ends at the last character of the text. */
+static int sse2_blocks_match( const Xsxml_Substring_Matcher *matcher, 
+                              const char *text, 
+                              size_t last_start, 
+                              size_t *position)
+{
+    const size_t N = matcher->length;
+
+    const __m128i FIRST = _mm_set1_epi8(matcher->first_character);
+    const __m128i LAST  = _mm_set1_epi8(matcher->last_character);
+
+    const __m128i FIRST_CASE_BIT = _mm_set1_epi8(matcher->first_case_bit);
+    const __m128i LAST_CASE_BIT  = _mm_set1_epi8(matcher->last_case_bit);
+
+    size_t i = 0;
+
+    for (; i + 64 <= last_start + 1; i += 64)
+    {
+        const unsigned long long MASK = 
+              sse2_block_mask(&text[i],      N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) 
+            | sse2_block_mask(&text[i + 16], N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) << 16 
+            | sse2_block_mask(&text[i + 32], N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) << 32 
+            | sse2_block_mask(&text[i + 48], N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) << 48;
+
+        if ((MASK != 0) && substring_candidates_match(matcher, text, i, MASK)) return 1;
+    }
+
+    *position = i;
+
+    return 0;
+}
+
+
+__attribute__((target("avx2"))) 
+static unsigned long long avx2_block_mask( const char *block, 
+                                           size_t length, 
+                                           __m256i first, 
+                                           __m256i last, 
+                                           __m256i first_case_bit, 
+                                           __m256i last_case_bit)
+{
+    const __m256i BLOCK_FIRST = _mm256_loadu_si256((const __m256i *) &block[0]);
+    const __m256i BLOCK_LAST  = _mm256_loadu_si256((const __m256i *) &block[length - 1]);
+
+    return (unsigned int) _mm256_movemask_epi8(
+        _mm256_and_si256( _mm256_cmpeq_epi8(_mm256_or_si256(BLOCK_FIRST, first_case_bit), first), 
+                          _mm256_cmpeq_epi8(_mm256_or_si256(BLOCK_LAST,  last_case_bit),  last)));
+}
+
+
+__attribute__((target("avx2"))) 
+static int avx2_blocks_match( const Xsxml_Substring_Matcher *matcher, 
+                              const char *text, 
+                              size_t last_start, 
+                              size_t *position)
+{
+    const size_t N = matcher->length;
+
+    const __m256i FIRST = _mm256_set1_epi8(matcher->first_character);
+    const __m256i LAST  = _mm256_set1_epi8(matcher->last_character);
+
+    const __m256i FIRST_CASE_BIT = _mm256_set1_epi8(matcher->first_case_bit);
+    const __m256i LAST_CASE_BIT  = _mm256_set1_epi8(matcher->last_case_bit);
+
+    size_t i = 0;
+
+    for (; i + 64 <= last_start + 1; i += 64)
+    {
+        const unsigned long long MASK = 
+              avx2_block_mask(&text[i],      N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) 
+            | avx2_block_mask(&text[i + 32], N, FIRST, LAST, FIRST_CASE_BIT, LAST_CASE_BIT) << 32;
+
+        if ((MASK != 0) && substring_candidates_match(matcher, text, i, MASK)) return 1;
+    }
+
+    *position = i;
+
+    return 0;
+}
+
+
+/* The sixty-four (64) starting positions of each step make up one block. */
+__attribute__((target("avx512bw"))) 
+static int avx512_blocks_match( const Xsxml_Substring_Matcher *matcher, 
+                                const char *text, 
+                                size_t last_start, 
+                                size_t *position)
+{
+    const size_t N = matcher->length;
+
+    const __m512i FIRST = _mm512_set1_epi8(matcher->first_character);
+    const __m512i LAST  = _mm512_set1_epi8(matcher->last_character);
+
+    const __m512i FIRST_CASE_BIT = _mm512_set1_epi8(matcher->first_case_bit);
+    const __m512i LAST_CASE_BIT  = _mm512_set1_epi8(matcher->last_case_bit);
+
+    size_t i = 0;
+
+    for (; i + 64 <= last_start + 1; i += 64)
+    {
+        const __m512i BLOCK_FIRST = _mm512_loadu_si512((const void *) &text[i]);
+        const __m512i BLOCK_LAST  = _mm512_loadu_si512((const void *) &text[i + N - 1]);
+
+        const unsigned long long MASK = 
+            _mm512_cmpeq_epi8_mask(_mm512_or_si512(BLOCK_FIRST, FIRST_CASE_BIT), FIRST) 
+          & _mm512_cmpeq_epi8_mask(_mm512_or_si512(BLOCK_LAST,  LAST_CASE_BIT),  LAST);
+
+        if ((MASK != 0) && substring_candidates_match(matcher, text, i, MASK)) return 1;
+    }
+
+    *position = i;
+
+    return 0;
+}
+#endif
+
+
+/* Returns the case bit (0x20) of the given character, if it is a letter. */
+static char case_bit_of(unsigned char character)
+{
+    const unsigned char FOLDED_CHARACTER = fold_ascii_case(character);
+
+    return ((FOLDED_CHARACTER >= 'a') && (FOLDED_CHARACTER <= 'z')) ? 0x20 : 0;
+}
+
+
+static void prepare_substring_matcher( Xsxml_Substring_Matcher *matcher, 
+                                       const char *string, 
+                                       size_t length, 
+                                       int is_case_insensitive)
+{
+    matcher->string = string;
+    matcher->length = length;
+
+    matcher->first_character = (length > 0) ? string[0]          : 0;
+    matcher->last_character  = (length > 0) ? string[length - 1] : 0;
+
+    matcher->is_case_insensitive = is_case_insensitive;
+
+    matcher->first_case_bit = 0;
+    matcher->last_case_bit  = 0;
+
+    if (is_case_insensitive)
+    {
+        matcher->first_case_bit = case_bit_of((unsigned char) matcher->first_character);
+        matcher->last_case_bit  = case_bit_of((unsigned char) matcher->last_character);
+
+        matcher->first_character = (char) fold_ascii_case((unsigned char) matcher->first_character);
+        matcher->last_character  = (char) fold_ascii_case((unsigned char) matcher->last_character);
+    }
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+    if (__builtin_cpu_supports("avx512bw"))
+    {
+        matcher->blocks_match = avx512_blocks_match;
+    }
+    else if (__builtin_cpu_supports("avx2"))
+    {
+        matcher->blocks_match = avx2_blocks_match;
+    }
+    else
+    {
+        matcher->blocks_match = sse2_blocks_match;
+    }
+#endif
+}
+
+
+static int substring_found( const Xsxml_Substring_Matcher *matcher, 
+                            const char *text, 
+                            size_t text_length)
+{
+    const size_t N = matcher->length;
+
+    if (N == 0) return 1;
+
+    /* A text shorter than the searched string cannot contain it. */
+    if (text_length < N) return 0;
+
+    const size_t LAST_START = text_length - N;
+
+    size_t i = 0;
+
+#if defined(SUBSTRING_SEARCH_IS_VECTORISED)
+    if (matcher->blocks_match(matcher, text, LAST_START, &i)) return 1;
+#else
+    if (!matcher->is_case_insensitive) return (strstr(text, matcher->string) != NULL);
+#endif
+
+    /* The remaining starting positions are found through memchr(), unless */
+    /* the first character is a letter of a case-insensitive search.       */
+    while (i <= LAST_START)
+    {
+        if (matcher->first_case_bit == 0)
+        {
+            const char *first = 
+            (const char *) memchr(&text[i], matcher->first_character, LAST_START - i + 1);
+
+            if (first == NULL) return 0;
+
+            i = (size_t) (first - text);
+        }
+        else if ((char) (text[i] | matcher->first_case_bit) != matcher->first_character)
+        {
+            i++;
+
+            continue;
+        }
+
+        if (((char) (text[i + N - 1] | matcher->last_case_bit) == matcher->last_character) 
+        &&  substring_middle_matches(matcher, text, i))
+        {
+            return 1;
+        }
+
+        i++;
+    }
+
+    return 0;
+}
+
+
+/*
+The automata of the glob and regular expression match modes. A pattern is 
+compiled once per search into a Thompson NFA, which is then turned into a 
+DFA by subset construction, so that every string is matched in a single 
+pass over its bytes, at one table lookup per byte, however the pattern is 
+written. The symbols that no part of the pattern tells apart share one 
+column of the table, as a symbol class. 
+
+The caret (^) and the dollar sign ($) are anchors, whose states hold the 
+symbols of the start and the end of the text instead of bytes, and which 
+are passed without reading any byte, at the start and the end of the text 
+alone. A regular expression may be preceded and followed by any bytes, and 
+so it is searched for anywhere within the text, whereas a glob is anchored 
+at both ends, and so it must match the whole text. 
+*/
+typedef struct Xsxml_Nfa_State
+{
+    /* The symbols that lead to the next state, if any, as bits. */
+    unsigned char symbol_set[PATTERN_SYMBOL_SET_SIZE];
+    int has_symbol_set;
+    size_t next;
+
+    /* The states that are reached without reading any symbol, if any. */
+    size_t epsilon[2];
+
+} Xsxml_Nfa_State;
+
+
+typedef struct Xsxml_Nfa_Fragment
+{
+    size_t start;
+
+    /* The end state has no transitions until the fragment is joined. */
+    size_t end;
+
+} Xsxml_Nfa_Fragment;
+
+
+typedef struct Xsxml_Nfa
+{
+    Xsxml_Nfa_State *state;
+    size_t number_of_states;
+    size_t capacity;
+
+    const char *pattern;
+    size_t pattern_length;
+    size_t p;
+
+    int is_case_insensitive;
+
+    /* Set upon the first error, which stops the parsing of the pattern. */
+    int is_invalid;
+    int is_too_complex;
+    size_t error_position;
+
+} Xsxml_Nfa;
+
+
+typedef struct Xsxml_Pattern
+{
+    unsigned short byte_class[256];
+    size_t number_of_classes;
+
+    /* The state zero (0) is the dead state, from which no text matches, */
+    /* and the state one (1) is the state at the start of the text.      */
+    size_t number_of_states;
+    size_t *transition;
+
+    /* Whether the text is matched upon reaching the state, or upon */
+    /* reaching it at the end of the text.                          */
+    unsigned char *is_accepting;
+    unsigned char *is_accepting_at_end;
+
+    int is_empty_text_accepted;
+
+} Xsxml_Pattern;
+
+
+static void add_symbol_range( unsigned char *symbol_set, 
+                              unsigned int first_symbol, 
+                              unsigned int last_symbol)
+{
+    for (unsigned int symbol = first_symbol; symbol <= last_symbol; symbol++)
+    {
+        symbol_set[symbol >> 3] |= (unsigned char) (1u << (symbol & 7));
+    }
+}
+
+
+static int has_symbol( const unsigned char *symbol_set, 
+                       unsigned int symbol)
+{
+    return (symbol_set[symbol >> 3] >> (symbol & 7)) & 1;
+}
+
+
+/* Only the bytes are inverted, and never the start and end of the text. */
+static void invert_byte_set(unsigned char *symbol_set)
+{
+    for (size_t k = 0; k < 256 / 8; k++) symbol_set[k] = (unsigned char) ~symbol_set[k];
+}
+
+
+/* Adds the other case of every ASCII letter of the set, if the pattern */
+/* is case-insensitive. The set stays closed under the case once it is  */
+/* inverted, and so a negated bracket expression is folded beforehand.  */
+static void fold_symbol_set( const Xsxml_Nfa *nfa, 
+                             unsigned char *symbol_set)
+{
+    if (!nfa->is_case_insensitive) return;
+
+    for (unsigned int letter = 'a'; letter <= 'z'; letter++)
+    {
+        const unsigned int UPPER_CASE_LETTER = letter - ('a' - 'A');
+
+        if (has_symbol(symbol_set, letter) || has_symbol(symbol_set, UPPER_CASE_LETTER))
+        {
+            add_symbol_range(symbol_set, letter, letter);
+            add_symbol_range(symbol_set, UPPER_CASE_LETTER, UPPER_CASE_LETTER);
+        }
+    }
+}
+
+
+static int nfa_has_failed(const Xsxml_Nfa *nfa)
+{
+    return nfa->is_invalid || nfa->is_too_complex;
+}
+
+
+static void set_nfa_error( Xsxml_Nfa *nfa, 
+                           size_t position)
+{
+    if (nfa_has_failed(nfa)) return;
+
+    nfa->is_invalid     = 1;
+    nfa->error_position = position;
+}
+
+
+static size_t new_nfa_state(Xsxml_Nfa *nfa)
+{
+    if (nfa->number_of_states >= PATTERN_MAX_NFA_STATES) nfa->is_too_complex = 1;
+
+    if (nfa->number_of_states == nfa->capacity)
+    {
+        nfa->capacity = 2 * nfa->capacity + 16;
+
+        nfa->state = 
+        (Xsxml_Nfa_State *) realloc(nfa->state, nfa->capacity * sizeof(Xsxml_Nfa_State));
+    }
+
+    Xsxml_Nfa_State *nfa_state = &nfa->state[nfa->number_of_states];
+
+    memset(nfa_state->symbol_set, 0, PATTERN_SYMBOL_SET_SIZE);
+
+    nfa_state->has_symbol_set = 0;
+    nfa_state->next           = XSXML_NO_NODE;
+    nfa_state->epsilon[0]     = XSXML_NO_NODE;
+    nfa_state->epsilon[1]     = XSXML_NO_NODE;
+
+    return nfa->number_of_states++;
+}
+
+
+static Xsxml_Nfa_Fragment nfa_empty_fragment(Xsxml_Nfa *nfa)
+{
+    const size_t STATE = new_nfa_state(nfa);
+
+    return (Xsxml_Nfa_Fragment) { STATE, STATE };
+}
+
+
+/* A fragment that reads one symbol of the given set. */
+static Xsxml_Nfa_Fragment nfa_symbol_fragment( Xsxml_Nfa *nfa, 
+                                               const unsigned char *symbol_set)
+{
+    const size_t START = new_nfa_state(nfa);
+    const size_t END   = new_nfa_state(nfa);
+
+    memcpy(nfa->state[START].symbol_set, symbol_set, PATTERN_SYMBOL_SET_SIZE);
+
+    fold_symbol_set(nfa, nfa->state[START].symbol_set);
+
+    nfa->state[START].has_symbol_set = 1;
+    nfa->state[START].next           = END;
+
+    return (Xsxml_Nfa_Fragment) { START, END };
+}
+
+
+static Xsxml_Nfa_Fragment nfa_concatenation( Xsxml_Nfa *nfa, 
+                                             Xsxml_Nfa_Fragment first, 
+                                             Xsxml_Nfa_Fragment second)
+{
+    nfa->state[first.end].epsilon[0] = second.start;
+
+    return (Xsxml_Nfa_Fragment) { first.start, second.end };
+}
+
+
+static Xsxml_Nfa_Fragment nfa_alternation( Xsxml_Nfa *nfa, 
+                                           Xsxml_Nfa_Fragment first, 
+                                           Xsxml_Nfa_Fragment second)
+{
+    const size_t START = new_nfa_state(nfa);
+    const size_t END   = new_nfa_state(nfa);
+
+    nfa->state[START].epsilon[0] = first.start;
+    nfa->state[START].epsilon[1] = second.start;
+
+    nfa->state[first.end ].epsilon[0] = END;
+    nfa->state[second.end].epsilon[0] = END;
+
+    return (Xsxml_Nfa_Fragment) { START, END };
+}
+
+
+/* Zero (0) or more repetitions of the fragment, or one (1) or more. */
+static Xsxml_Nfa_Fragment nfa_repetition( Xsxml_Nfa *nfa, 
+                                          Xsxml_Nfa_Fragment fragment, 
+                                          int may_be_absent)
+{
+    const size_t END = new_nfa_state(nfa);
+
+    nfa->state[fragment.end].epsilon[0] = fragment.start;
+    nfa->state[fragment.end].epsilon[1] = END;
+
+    if (!may_be_absent) return (Xsxml_Nfa_Fragment) { fragment.start, END };
+
+    const size_t START = new_nfa_state(nfa);
+
+    nfa->state[START].epsilon[0] = fragment.start;
+    nfa->state[START].epsilon[1] = END;
+
+    return (Xsxml_Nfa_Fragment) { START, END };
+}
+
+
+static Xsxml_Nfa_Fragment nfa_option( Xsxml_Nfa *nfa, 
+                                      Xsxml_Nfa_Fragment fragment)
+{
+    const size_t START = new_nfa_state(nfa);
+
+    nfa->state[START].epsilon[0] = fragment.start;
+    nfa->state[START].epsilon[1] = fragment.end;
+
+    return (Xsxml_Nfa_Fragment) { START, fragment.end };
+}
+
+
+/*
+Adds the bytes of the escape sequence that follows a backslash to the given 
+set, and returns its byte, or -1 if it stands for a class of bytes. In a 
+regular expression, \d, \w and \s stand for the digits, the word characters 
+and the space characters, and \D, \W and \S for all the other bytes, \n, \t 
+and \r for their control characters, and any other escaped character for 
+itself, as it does in a glob. 
+*/
+static int parse_pattern_escape( Xsxml_Nfa *nfa, 
+                                 int is_glob, 
+                                 unsigned char *symbol_set)
+{
+    if (nfa->p >= nfa->pattern_length)
+    {
+        set_nfa_error(nfa, nfa->p - 1);
+
+        return -1;
+    }
+
+    int character = (unsigned char) nfa->pattern[nfa->p++];
+
+    if (!is_glob)
+    {
+        const int LOWER_CHARACTER = tolower(character);
+
+        if ((LOWER_CHARACTER == 'd') || (LOWER_CHARACTER == 'w') || (LOWER_CHARACTER == 's'))
+        {
+            unsigned char class_set[PATTERN_SYMBOL_SET_SIZE] = { 0 };
+
+            if (LOWER_CHARACTER == 'd')
+            {
+                add_symbol_range(class_set, '0', '9');
+            }
+            else if (LOWER_CHARACTER == 'w')
+            {
+                add_symbol_range(class_set, '0', '9');
+                add_symbol_range(class_set, 'A', 'Z');
+                add_symbol_range(class_set, 'a', 'z');
+                add_symbol_range(class_set, '_', '_');
+            }
+            else /* if (LOWER_CHARACTER == 's') */
+            {
+                add_symbol_range(class_set, ' ', ' ');
+                add_symbol_range(class_set, '\t', '\r');
+            }
+
+            if (character != LOWER_CHARACTER) invert_byte_set(class_set);
+
+            for (size_t k = 0; k < PATTERN_SYMBOL_SET_SIZE; k++) symbol_set[k] |= class_set[k];
+
+            return -1;
+        }
+
+        if (character == 'n') character = '\n';
+        if (character == 't') character = '\t';
+        if (character == 'r') character = '\r';
+    }
+
+    add_symbol_range(symbol_set, (unsigned int) character, (unsigned int) character);
+
+    return character;
+}
+
+
+static const char *BRACKET_CLASS_NAMES_LIST[12] = 
+{
+    "alnum", "alpha", "blank", "cntrl", "digit", "graph", 
+    "lower", "print", "punct", "space", "upper", "xdigit"
+
+};
+
+static int (*const BRACKET_CLASS_TESTS_LIST[12])(int) = 
+{
+    isalnum, isalpha, isblank, iscntrl, isdigit, isgraph, 
+    islower, isprint, ispunct, isspace, isupper, isxdigit
+
+};
+
+
+/*
+Adds the bytes of the named class, such as [:alpha:], that follows the 
+opening bracket ([) of a member of a bracket expression to the given set. 
+The classes hold the ASCII bytes alone, whereas an unknown or unterminated 
+class name makes the pattern invalid. 
+*/
+static void parse_bracket_class( Xsxml_Nfa *nfa, 
+                                 unsigned char *symbol_set)
+{
+    const size_t CLASS_POSITION = nfa->p - 1;
+
+    const size_t NAME_START = nfa->p + 1;
+
+    size_t name_end = NAME_START;
+
+    while ((name_end + 1 < nfa->pattern_length)
+    &&     ((nfa->pattern[name_end] != ':') || (nfa->pattern[name_end + 1] != ']')))
+    {
+        name_end++;
+    }
+
+    if (name_end + 1 >= nfa->pattern_length)
+    {
+        set_nfa_error(nfa, CLASS_POSITION);
+
+        return;
+    }
+
+    const size_t NAME_LENGTH = name_end - NAME_START;
+
+    for (size_t k = 0; k < 12; k++)
+    {
+        if ((strlen(BRACKET_CLASS_NAMES_LIST[k]) == NAME_LENGTH)
+        &&  (memcmp(&nfa->pattern[NAME_START], BRACKET_CLASS_NAMES_LIST[k], NAME_LENGTH) == 0))
+        {
+            for (int character = 0; character < 128; character++)
+            {
+                if (BRACKET_CLASS_TESTS_LIST[k](character))
+                {
+                    add_symbol_range(symbol_set, (unsigned int) character, (unsigned int) character);
+                }
+            }
+
+            nfa->p = name_end + 2;
+
+            return;
+        }
+    }
+
+    set_nfa_error(nfa, CLASS_POSITION);
+}
+
+
+/* Adds the bytes of one member of a bracket expression to the given set, */
+/* and returns its byte, or -1 if it stands for a class of bytes.        */
+static int parse_bracket_member( Xsxml_Nfa *nfa, 
+                                 int is_glob, 
+                                 unsigned char *symbol_set)
+{
+    const int CHARACTER = (unsigned char) nfa->pattern[nfa->p++];
+
+    if (CHARACTER == '\\') return parse_pattern_escape(nfa, is_glob, symbol_set);
+
+    if ((CHARACTER == '[') && (nfa->p < nfa->pattern_length) && (nfa->pattern[nfa->p] == ':'))
+    {
+        parse_bracket_class(nfa, symbol_set);
+
+        return -1;
+    }
+
+    add_symbol_range(symbol_set, (unsigned int) CHARACTER, (unsigned int) CHARACTER);
+
+    return CHARACTER;
+}
+
+
+/* Adds the bytes of the bracket expression that follows an opening */
+/* bracket ([) to the given set.                                   */
+static void parse_pattern_bracket( Xsxml_Nfa *nfa, 
+                                   int is_glob, 
+                                   unsigned char *symbol_set)
+{
+    const size_t BRACKET_POSITION = nfa->p - 1;
+
+    int is_negated = 0;
+
+    if ((nfa->p < nfa->pattern_length)
+    &&  ((nfa->pattern[nfa->p] == '^') || (is_glob && (nfa->pattern[nfa->p] == '!'))))
+    {
+        is_negated = 1;
+
+        nfa->p++;
+    }
+
+    /* A closing bracket (]) is a member of its own if it comes first. */
+    for (size_t number_of_members = 0; !nfa_has_failed(nfa); number_of_members++)
+    {
+        if (nfa->p >= nfa->pattern_length)
+        {
+            set_nfa_error(nfa, BRACKET_POSITION);
+
+            return;
+        }
+
+        if ((nfa->pattern[nfa->p] == ']') && (number_of_members > 0))
+        {
+            nfa->p++;
+
+            break;
+        }
+
+        const int FIRST_CHARACTER = parse_bracket_member(nfa, is_glob, symbol_set);
+
+        /* A hyphen (-) is a member of its own if it comes last. */
+        if ((FIRST_CHARACTER >= 0)
+        &&  (nfa->p + 1 < nfa->pattern_length)
+        &&  (nfa->pattern[nfa->p] == '-')
+        &&  (nfa->pattern[nfa->p + 1] != ']'))
+        {
+            const size_t RANGE_POSITION = nfa->p++;
+
+            const int LAST_CHARACTER = parse_bracket_member(nfa, is_glob, symbol_set);
+
+            if (LAST_CHARACTER < FIRST_CHARACTER)
+            {
+                set_nfa_error(nfa, RANGE_POSITION);
+
+                return;
+            }
+
+            add_symbol_range( symbol_set, 
+                              (unsigned int) FIRST_CHARACTER, 
+                              (unsigned int) LAST_CHARACTER);
+        }
+    }
+
+    if (is_negated)
+    {
+        fold_symbol_set(nfa, symbol_set);
+
+        invert_byte_set(symbol_set);
+    }
+}
+
+
+/* A glob consists of the wildcards '*', for any number of bytes, and '?', */
+/* for any one byte, bracket expressions, and the bytes that match alone. */
+static Xsxml_Nfa_Fragment parse_glob(Xsxml_Nfa *nfa)
+{
+    Xsxml_Nfa_Fragment fragment = nfa_empty_fragment(nfa);
+
+    while ((nfa->p < nfa->pattern_length) && !nfa_has_failed(nfa))
+    {
+        const char CHARACTER = nfa->pattern[nfa->p++];
+
+        unsigned char symbol_set[PATTERN_SYMBOL_SET_SIZE] = { 0 };
+
+        if ((CHARACTER == '*') || (CHARACTER == '?'))
+        {
+            add_symbol_range(symbol_set, 0, 255);
+        }
+        else if (CHARACTER == '[')
+        {
+            parse_pattern_bracket(nfa, 1, symbol_set);
+        }
+        else if (CHARACTER == '\\')
+        {
+            parse_pattern_escape(nfa, 1, symbol_set);
+        }
+        else
+        {
+            add_symbol_range(symbol_set, (unsigned char) CHARACTER, (unsigned char) CHARACTER);
+        }
+
+        Xsxml_Nfa_Fragment symbol_fragment = nfa_symbol_fragment(nfa, symbol_set);
+
+        if (CHARACTER == '*') symbol_fragment = nfa_repetition(nfa, symbol_fragment, 1);
+
+        fragment = nfa_concatenation(nfa, fragment, symbol_fragment);
+    }
+
+    return fragment;
+}
+
+
+static Xsxml_Nfa_Fragment parse_regex_alternation( Xsxml_Nfa *nfa, 
+                                                   size_t depth);
+
+
+static Xsxml_Nfa_Fragment parse_regex_atom( Xsxml_Nfa *nfa, 
+                                            size_t depth)
+{
+    const size_t ATOM_POSITION = nfa->p;
+
+    const char CHARACTER = nfa->pattern[nfa->p++];
+
+    unsigned char symbol_set[PATTERN_SYMBOL_SET_SIZE] = { 0 };
+
+    if (CHARACTER == '(')
+    {
+        if (depth >= PATTERN_MAX_NESTING)
+        {
+            nfa->is_too_complex = 1;
+
+            return nfa_empty_fragment(nfa);
+        }
+
+        const Xsxml_Nfa_Fragment GROUP = parse_regex_alternation(nfa, depth + 1);
+
+        if ((nfa->p >= nfa->pattern_length) || (nfa->pattern[nfa->p] != ')'))
+        {
+            set_nfa_error(nfa, ATOM_POSITION);
+        }
+
+        nfa->p++;
+
+        return GROUP;
+    }
+    else if (CHARACTER == '[')
+    {
+        parse_pattern_bracket(nfa, 0, symbol_set);
+    }
+    else if (CHARACTER == '.')
+    {
+        add_symbol_range(symbol_set, 0, 255);
+    }
+    else if (CHARACTER == '^')
+    {
+        add_symbol_range(symbol_set, PATTERN_TEXT_START, PATTERN_TEXT_START);
+    }
+    else if (CHARACTER == '$')
+    {
+        add_symbol_range(symbol_set, PATTERN_TEXT_END, PATTERN_TEXT_END);
+    }
+    else if (CHARACTER == '\\')
+    {
+        parse_pattern_escape(nfa, 0, symbol_set);
+    }
+    else if ((CHARACTER == '*') || (CHARACTER == '+') || (CHARACTER == '?') || (CHARACTER == '{'))
+    {
+        /* A quantifier must follow an atom. */
+        set_nfa_error(nfa, ATOM_POSITION);
+
+        return nfa_empty_fragment(nfa);
+    }
+    else
+    {
+        add_symbol_range(symbol_set, (unsigned char) CHARACTER, (unsigned char) CHARACTER);
+    }
+
+    return nfa_symbol_fragment(nfa, symbol_set);
+}
+
+
+/* Reads the number at the position of the pattern, which is at most the */
+/* greatest number of repetitions, or returns XSXML_NO_LIMIT if none.    */
+static size_t parse_regex_bound(Xsxml_Nfa *nfa)
+{
+    size_t bound = XSXML_NO_LIMIT;
+
+    while ((nfa->p < nfa->pattern_length) && isdigit((unsigned char) nfa->pattern[nfa->p]))
+    {
+        if (bound == XSXML_NO_LIMIT) bound = 0;
+
+        bound = 10 * bound + (size_t) (nfa->pattern[nfa->p++] - '0');
+
+        if (bound > PATTERN_MAX_REPETITIONS) nfa->is_too_complex = 1;
+    }
+
+    return bound;
+}
+
+
+/*
+Repeats the atom at the given position from the minimum to the maximum 
+number of times, or any number of times beyond the minimum if there is no 
+maximum. The given fragment is the first copy of the atom, and the other 
+copies are parsed again from the position of the atom. 
+*/
+static Xsxml_Nfa_Fragment repeat_regex_atom( Xsxml_Nfa *nfa, 
+                                             size_t depth, 
+                                             Xsxml_Nfa_Fragment first_copy, 
+                                             size_t atom_position, 
+                                             size_t min_repetitions, 
+                                             size_t max_repetitions)
+{
+    const size_t NUMBER_OF_COPIES = (max_repetitions == XSXML_NO_LIMIT)
+                                  ? min_repetitions + 1
+                                  : max_repetitions;
+
+    const size_t QUANTIFIER_END = nfa->p;
+
+    Xsxml_Nfa_Fragment fragment = nfa_empty_fragment(nfa);
+
+    for (size_t k = 0; (k < NUMBER_OF_COPIES) && !nfa_has_failed(nfa); k++)
+    {
+        Xsxml_Nfa_Fragment copy = first_copy;
+
+        if (k > 0)
+        {
+            nfa->p = atom_position;
+
+            copy = parse_regex_atom(nfa, depth);
+        }
+
+        if (k >= min_repetitions)
+        {
+            copy = (max_repetitions == XSXML_NO_LIMIT)
+                 ? nfa_repetition(nfa, copy, 1)
+                 : nfa_option(nfa, copy);
+        }
+
+        fragment = nfa_concatenation(nfa, fragment, copy);
+    }
+
+    nfa->p = QUANTIFIER_END;
+
+    return fragment;
+}
+
+
+/* An atom is followed by at most one quantifier, which is '*', '+', '?', */
+/* or a number of repetitions, as {m}, {m,}, or {m,n}.                    */
+static Xsxml_Nfa_Fragment parse_regex_repetition( Xsxml_Nfa *nfa, 
+                                                  size_t depth)
+{
+    const size_t ATOM_POSITION = nfa->p;
+
+    Xsxml_Nfa_Fragment fragment = parse_regex_atom(nfa, depth);
+
+    if (nfa_has_failed(nfa) || (nfa->p >= nfa->pattern_length)) return fragment;
+
+    const size_t QUANTIFIER_POSITION = nfa->p;
+
+    const char QUANTIFIER = nfa->pattern[nfa->p];
+
+    if (QUANTIFIER == '*')
+    {
+        nfa->p++;
+
+        fragment = nfa_repetition(nfa, fragment, 1);
+    }
+    else if (QUANTIFIER == '+')
+    {
+        nfa->p++;
+
+        fragment = nfa_repetition(nfa, fragment, 0);
+    }
+    else if (QUANTIFIER == '?')
+    {
+        nfa->p++;
+
+        fragment = nfa_option(nfa, fragment);
+    }
+    else if (QUANTIFIER == '{')
+    {
+        nfa->p++;
+
+        const size_t MIN_REPETITIONS = parse_regex_bound(nfa);
+
+        size_t max_repetitions = MIN_REPETITIONS;
+
+        if ((nfa->p < nfa->pattern_length) && (nfa->pattern[nfa->p] == ','))
+        {
+            nfa->p++;
+
+            max_repetitions = parse_regex_bound(nfa);
+        }
+
+        if ((MIN_REPETITIONS == XSXML_NO_LIMIT)
+        ||  (max_repetitions < MIN_REPETITIONS)
+        ||  (nfa->p >= nfa->pattern_length)
+        ||  (nfa->pattern[nfa->p] != '}'))
+        {
+            set_nfa_error(nfa, QUANTIFIER_POSITION);
+
+            return fragment;
+        }
+
+        nfa->p++;
+
+        fragment = repeat_regex_atom( nfa, 
+                                      depth, 
+                                      fragment, 
+                                      ATOM_POSITION, 
+                                      MIN_REPETITIONS, 
+                                      max_repetitions);
+    }
+    else
+    {
+        return fragment;
+    }
+
+    if ((nfa->p < nfa->pattern_length)
+    &&  ((nfa->pattern[nfa->p] == '*') || (nfa->pattern[nfa->p] == '+')
+     ||  (nfa->pattern[nfa->p] == '?') || (nfa->pattern[nfa->p] == '{')))
+    {
+        set_nfa_error(nfa, nfa->p);
+    }
+
+    return fragment;
+}
+
+
+static Xsxml_Nfa_Fragment parse_regex_concatenation( Xsxml_Nfa *nfa, 
+                                                     size_t depth)
+{
+    Xsxml_Nfa_Fragment fragment = nfa_empty_fragment(nfa);
+
+    while ((nfa->p < nfa->pattern_length)
+    &&     (nfa->pattern[nfa->p] != '|')
+    &&     (nfa->pattern[nfa->p] != ')')
+    &&     !nfa_has_failed(nfa))
+    {
+        fragment = nfa_concatenation(nfa, fragment, parse_regex_repetition(nfa, depth));
+    }
+
+    return fragment;
+}
+
+
+static Xsxml_Nfa_Fragment parse_regex_alternation( Xsxml_Nfa *nfa, 
+                                                   size_t depth)
+{
+    Xsxml_Nfa_Fragment fragment = parse_regex_concatenation(nfa, depth);
+
+    while ((nfa->p < nfa->pattern_length)
+    &&     (nfa->pattern[nfa->p] == '|')
+    &&     !nfa_has_failed(nfa))
+    {
+        nfa->p++;
+
+        fragment = nfa_alternation(nfa, fragment, parse_regex_concatenation(nfa, depth));
+    }
+
+    return fragment;
+}
+
+
+static void free_pattern(Xsxml_Pattern *pattern)
+{
+    if (pattern == NULL) return;
+
+    free(pattern->transition);
+    free(pattern->is_accepting);
+    free(pattern->is_accepting_at_end);
+    free(pattern);
+}
+
+
+/* Whether the given state is an anchor that is passed at the given */
+/* positions of the text.                                            */
+static int nfa_anchor_holds( const Xsxml_Nfa_State *nfa_state, 
+                             int is_at_start, 
+                             int is_at_end)
+{
+    return nfa_state->has_symbol_set 
+        && ((is_at_start && has_symbol(nfa_state->symbol_set, PATTERN_TEXT_START)) 
+         || (is_at_end   && has_symbol(nfa_state->symbol_set, PATTERN_TEXT_END)));
+}
+
+
+/* Adds the given state, and every state that it leads to without reading */
+/* any byte, to the given set of states, which is closed already.         */
+static void add_nfa_closure( const Xsxml_Nfa *nfa, 
+                             unsigned long long *state_set, 
+                             size_t *stack, 
+                             size_t nfa_state, 
+                             int is_at_start, 
+                             int is_at_end)
+{
+    if ((state_set[nfa_state >> 6] >> (nfa_state & 63)) & 1) return;
+
+    state_set[nfa_state >> 6] |= 1ULL << (nfa_state & 63);
+
+    size_t stack_size = 0;
+
+    stack[stack_size++] = nfa_state;
+
+    while (stack_size > 0)
+    {
+        const Xsxml_Nfa_State *STATE = &nfa->state[stack[--stack_size]];
+
+        const size_t NEXT_STATES[3] = 
+        { 
+            STATE->epsilon[0], 
+            STATE->epsilon[1], 
+            nfa_anchor_holds(STATE, is_at_start, is_at_end) ? STATE->next : XSXML_NO_NODE 
+        };
+
+        for (size_t e = 0; e < 3; e++)
+        {
+            const size_t NEXT = NEXT_STATES[e];
+
+            if ((NEXT == XSXML_NO_NODE) || ((state_set[NEXT >> 6] >> (NEXT & 63)) & 1)) continue;
+
+            state_set[NEXT >> 6] |= 1ULL << (NEXT & 63);
+
+            stack[stack_size++] = NEXT;
+        }
+    }
+}
+
+
+/* Whether the given set of states holds the accepting state, once the */
+/* anchors of the given positions of the text have been passed.        */
+static int nfa_set_accepts( const Xsxml_Nfa *nfa, 
+                            const unsigned long long *state_set, 
+                            unsigned long long *closed_set, 
+                            size_t *stack, 
+                            size_t accepting_state, 
+                            int is_at_start, 
+                            int is_at_end)
+{
+    const size_t N_WORDS = (nfa->number_of_states + 63) / 64;
+
+    memcpy(closed_set, state_set, N_WORDS * sizeof(unsigned long long));
+
+    for (size_t w = 0; w < N_WORDS; w++)
+    {
+        for (unsigned long long bits = state_set[w]; bits != 0; bits &= bits - 1)
+        {
+            const Xsxml_Nfa_State *STATE = &nfa->state[64 * w + (size_t) __builtin_ctzll(bits)];
+
+            if (nfa_anchor_holds(STATE, is_at_start, is_at_end))
+            {
+                add_nfa_closure(nfa, closed_set, stack, STATE->next, is_at_start, is_at_end);
+            }
+        }
+    }
+
+    return (closed_set[accepting_state >> 6] >> (accepting_state & 63)) & 1;
+}
+
+
+/* Returns the DFA state of the given set of NFA states, or XSXML_NO_NODE */
+/* along with the slot of the table at which it is to be added.         */
+static size_t find_dfa_state( const size_t *table, 
+                              const unsigned long long *state_sets, 
+                              const unsigned long long *state_set, 
+                              size_t number_of_words, 
+                              size_t *slot)
+{
+    const size_t TABLE_SIZE = 2 * PATTERN_MAX_DFA_STATES;
+
+    /* The FNV-1a hash of the set of states. */
+    size_t hash = (size_t) 14695981039346656037ULL;
+
+    for (size_t w = 0; w < number_of_words; w++)
+    {
+        hash = (hash ^ (size_t) state_set[w]) * (size_t) 1099511628211ULL;
+    }
+
+    for (*slot = hash & (TABLE_SIZE - 1); 
+         table[*slot] != XSXML_NO_NODE; 
+         *slot = (*slot + 1) & (TABLE_SIZE - 1))
+    {
+        if (memcmp( state_set, 
+                    &state_sets[table[*slot] * number_of_words], 
+                    number_of_words * sizeof(unsigned long long)) == 0)
+        {
+            return table[*slot];
+        }
+    }
+
+    return XSXML_NO_NODE;
+}
+
+
+/*
+Turns the given NFA into a DFA, whose states are the sets of NFA states 
+that the NFA may be in at once, as found from the state of the start of 
+every search. The sets are found by their hashes, through an open 
+addressing table. Returns NULL if there are too many states. 
+*/
+static Xsxml_Pattern *build_pattern_dfa( const Xsxml_Nfa *nfa, 
+                                         size_t start_state, 
+                                         size_t accepting_state)
+{
+    Xsxml_Pattern *pattern = (Xsxml_Pattern *) malloc(sizeof(Xsxml_Pattern));
+
+    /* The byte classes are split by the symbol set of every NFA state. */
+    memset(pattern->byte_class, 0, sizeof(pattern->byte_class));
+
+    pattern->number_of_classes = 1;
+
+    size_t class_renumbering[2 * 256];
+
+    for (size_t s = 0; s < nfa->number_of_states; s++)
+    {
+        if (!nfa->state[s].has_symbol_set) continue;
+
+        for (size_t k = 0; k < 2 * pattern->number_of_classes; k++)
+        {
+            class_renumbering[k] = XSXML_NO_NODE;
+        }
+
+        size_t number_of_classes = 0;
+
+        for (unsigned int byte = 0; byte < 256; byte++)
+        {
+            const size_t KEY = 2 * pattern->byte_class[byte] 
+                             + (size_t) has_symbol(nfa->state[s].symbol_set, byte);
+
+            if (class_renumbering[KEY] == XSXML_NO_NODE)
+            {
+                class_renumbering[KEY] = number_of_classes++;
+            }
+
+            pattern->byte_class[byte] = (unsigned short) class_renumbering[KEY];
+        }
+
+        pattern->number_of_classes = number_of_classes;
+    }
+
+    const size_t N_CLASSES = pattern->number_of_classes;
+
+    /* The first byte of every class stands for all of them. */
+    unsigned int class_byte[256];
+
+    for (unsigned int byte = 256; byte > 0; byte--)
+    {
+        class_byte[pattern->byte_class[byte - 1]] = byte - 1;
+    }
+
+    const size_t N_WORDS = (nfa->number_of_states + 63) / 64;
+
+    const size_t TABLE_SIZE = 2 * PATTERN_MAX_DFA_STATES;
+
+    size_t *table = (size_t *) malloc(TABLE_SIZE * sizeof(size_t));
+
+    for (size_t k = 0; k < TABLE_SIZE; k++) table[k] = XSXML_NO_NODE;
+
+    size_t capacity = 16;
+
+    unsigned long long *state_sets = 
+    (unsigned long long *) calloc(capacity * N_WORDS, sizeof(unsigned long long));
+
+    unsigned long long *next_set = 
+    (unsigned long long *) malloc(N_WORDS * sizeof(unsigned long long));
+
+    unsigned long long *closed_set = 
+    (unsigned long long *) malloc(N_WORDS * sizeof(unsigned long long));
+
+    size_t *stack = (size_t *) malloc(nfa->number_of_states * sizeof(size_t));
+
+    pattern->transition          = (size_t *) malloc(capacity * N_CLASSES * sizeof(size_t));
+    pattern->is_accepting        = (unsigned char *) malloc(capacity);
+    pattern->is_accepting_at_end = (unsigned char *) malloc(capacity);
+
+    /* The dead state is the empty set, and the initial state the closure */
+    /* of the start state, which are the first two (2) states.            */
+    pattern->number_of_states = 2;
+
+    add_nfa_closure(nfa, &state_sets[N_WORDS], stack, start_state, 1, 0);
+
+    pattern->is_empty_text_accepted = 
+        nfa_set_accepts(nfa, &state_sets[N_WORDS], closed_set, stack, accepting_state, 1, 1);
+
+    for (size_t d = 0; d < 2; d++)
+    {
+        size_t slot = 0;
+
+        find_dfa_state(table, state_sets, &state_sets[d * N_WORDS], N_WORDS, &slot);
+
+        table[slot] = d;
+    }
+
+    int is_too_complex = 0;
+
+    for (size_t d = 0; (d < pattern->number_of_states) && !is_too_complex; d++)
+    {
+        for (size_t c = 0; (c < N_CLASSES) && !is_too_complex; c++)
+        {
+            memset(next_set, 0, N_WORDS * sizeof(unsigned long long));
+
+            for (size_t w = 0; w < N_WORDS; w++)
+            {
+                for (unsigned long long bits = state_sets[d * N_WORDS + w]; bits != 0; bits &= bits - 1)
+                {
+                    const Xsxml_Nfa_State *STATE = 
+                        &nfa->state[64 * w + (size_t) __builtin_ctzll(bits)];
+
+                    if (STATE->has_symbol_set && has_symbol(STATE->symbol_set, class_byte[c]))
+                    {
+                        add_nfa_closure(nfa, next_set, stack, STATE->next, 0, 0);
+                    }
+                }
+            }
+
+            size_t slot = 0;
+
+            size_t next_state = find_dfa_state(table, state_sets, next_set, N_WORDS, &slot);
+
+            if (next_state == XSXML_NO_NODE)
+            {
+                if (pattern->number_of_states == PATTERN_MAX_DFA_STATES)
+                {
+                    is_too_complex = 1;
+
+                    break;
+                }
+
+                if (pattern->number_of_states == capacity)
+                {
+                    capacity *= 2;
+
+                    state_sets = (unsigned long long *)
+                    realloc(state_sets, capacity * N_WORDS * sizeof(unsigned long long));
+
+                    pattern->transition = (size_t *)
+                    realloc(pattern->transition, capacity * N_CLASSES * sizeof(size_t));
+
+                    pattern->is_accepting = (unsigned char *)
+                    realloc(pattern->is_accepting, capacity);
+
+                    pattern->is_accepting_at_end = (unsigned char *)
+                    realloc(pattern->is_accepting_at_end, capacity);
+                }
+
+                next_state = pattern->number_of_states++;
+
+                memcpy( &state_sets[next_state * N_WORDS], 
+                        next_set, 
+                        N_WORDS * sizeof(unsigned long long));
+
+                table[slot] = next_state;
+            }
+
+            pattern->transition[d * N_CLASSES + c] = next_state;
+        }
+
+        pattern->is_accepting[d] = 
+            (unsigned char) ((state_sets[d * N_WORDS + (accepting_state >> 6)] 
+                              >> (accepting_state & 63)) & 1);
+
+        pattern->is_accepting_at_end[d] = (unsigned char) 
+            nfa_set_accepts(nfa, &state_sets[d * N_WORDS], closed_set, stack, accepting_state, 0, 1);
+    }
+
+    free(table);
+    free(state_sets);
+    free(next_set);
+    free(closed_set);
+    free(stack);
+
+    if (is_too_complex)
+    {
+        free_pattern(pattern);
+
+        return NULL;
+    }
+
+    return pattern;
+}
+
+
+/*
+Compiles the given glob or regular expression. Returns NULL if the pattern 
+is invalid, in which case the error position is set, or too complex, in 
+which case it is set to XSXML_NO_NODE. A case-insensitive pattern matches 
+either case of its ASCII letters, which costs nothing once it is compiled. 
+*/
+static Xsxml_Pattern *compile_pattern( const char *pattern_string, 
+                                       size_t pattern_length, 
+                                       Xsxml_Match_Mode match_mode, 
+                                       int is_case_insensitive, 
+                                       size_t *error_position)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml_Nfa nfa = { 0 };
+
+    nfa.pattern             = pattern_string;
+    nfa.pattern_length      = pattern_length;
+    nfa.is_case_insensitive = is_case_insensitive;
+
+    /* The sets of the anchors of a glob, or of the bytes that may precede */
+    /* and follow a regular expression.                                    */
+    unsigned char start_set[PATTERN_SYMBOL_SET_SIZE] = { 0 };
+    unsigned char end_set  [PATTERN_SYMBOL_SET_SIZE] = { 0 };
+
+    Xsxml_Nfa_Fragment prefix;
+    Xsxml_Nfa_Fragment fragment;
+    Xsxml_Nfa_Fragment suffix;
+
+    if (match_mode == XSXML_MATCH_GLOB)
+    {
+        add_symbol_range(start_set, PATTERN_TEXT_START, PATTERN_TEXT_START);
+        add_symbol_range(end_set,   PATTERN_TEXT_END,   PATTERN_TEXT_END);
+
+        prefix   = nfa_symbol_fragment(&nfa, start_set);
+        fragment = parse_glob(&nfa);
+        suffix   = nfa_symbol_fragment(&nfa, end_set);
+    }
+    else /* if (match_mode == XSXML_MATCH_REGEX) */
+    {
+        add_symbol_range(start_set, 0, 255);
+        add_symbol_range(end_set,   0, 255);
+
+        prefix   = nfa_repetition(&nfa, nfa_symbol_fragment(&nfa, start_set), 1);
+        fragment = parse_regex_alternation(&nfa, 0);
+        suffix   = nfa_repetition(&nfa, nfa_symbol_fragment(&nfa, end_set), 1);
+
+        /* Only an unmatched closing parenthesis stops the parsing early. */
+        if (nfa.p < nfa.pattern_length) set_nfa_error(&nfa, nfa.p);
+    }
+
+    fragment = nfa_concatenation(&nfa, nfa_concatenation(&nfa, prefix, fragment), suffix);
+
+    Xsxml_Pattern *pattern = NULL;
+
+    if (!nfa_has_failed(&nfa)) pattern = build_pattern_dfa(&nfa, fragment.start, fragment.end);
+
+    if (nfa.is_invalid)
+    {
+        *error_position = nfa.error_position;
+    }
+    else if (pattern == NULL)
+    {
+        *error_position = XSXML_NO_NODE;
+    }
+
+    free(nfa.state);
+
+    return pattern;
+}
+
+
+/* The text is matched as soon as the DFA reaches an accepting state, */
+/* which it never leaves, and not once it reaches the dead state.     */
+static int pattern_matches( const Xsxml_Pattern *pattern, 
+                            const char *text, 
+                            size_t text_length)
+{
+    if (text_length == 0) return pattern->is_empty_text_accepted;
+
+    const size_t N_CLASSES = pattern->number_of_classes;
+
+    size_t state = 1;
+
+    for (size_t i = 0; i < text_length; i++)
+    {
+        if (pattern->is_accepting[state]) return 1;
+
+        state = pattern->transition[state * N_CLASSES 
+                                    + pattern->byte_class[(unsigned char) text[i]]];
+
+        if (state == 0) return 0;
+    }
+
+    return pattern->is_accepting_at_end[state];
+}
+
+
+/*
+A criterion of a search, which is a string matched in one of the match 
+modes, where a predicate without a string denotes the absence of its 
+criterion. 
+*/
+typedef struct Xsxml_String_Predicate
+{
+    const char *string;
+    size_t length;
+
+    /* Never XSXML_MATCH_DEFAULT, which is resolved once prepared. */
+    Xsxml_Match_Mode match_mode;
+
+    int is_case_insensitive;
+
+    Xsxml_Substring_Matcher substring_matcher;
+
+    /* Only compiled for the glob and regular expression match modes. */
+    Xsxml_Pattern *pattern;
+
+} Xsxml_String_Predicate;
+
+
+/* Returns zero (0), with the reason in the given result message, if the */
+/* match mode or the pattern of the criterion is invalid.               */
+static int prepare_string_predicate( Xsxml_String_Predicate *predicate, 
+                                     const char *string, 
+                                     Xsxml_Match_Mode match_mode, 
+                                     Xsxml_Match_Mode default_match_mode, 
+                                     int is_case_insensitive, 
+                                     const char *criterion_name, 
+                                     char *result_message)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    *predicate = (Xsxml_String_Predicate) { 0 };
+
+    predicate->string     = string;
+    predicate->length     = (string == NULL) ? 0 : strlen(string);
+    predicate->match_mode = (match_mode == XSXML_MATCH_DEFAULT) ? default_match_mode : match_mode;
+
+    predicate->is_case_insensitive = (is_case_insensitive != 0);
+
+    if ((unsigned int) predicate->match_mode > (unsigned int) XSXML_MATCH_REGEX)
+    {
+        snprintf( result_message, 
+                  RESULT_MESSAGE_MAX_LENGTH, 
+                  "The match mode of the %s is invalid.", 
+                  criterion_name);
+
+        return 0;
+    }
+
+    if (string == NULL) return 1;
+
+    if (predicate->match_mode == XSXML_MATCH_SUBSTRING)
+    {
+        prepare_substring_matcher( &predicate->substring_matcher, 
+                                   string, 
+                                   predicate->length, 
+                                   predicate->is_case_insensitive);
+    }
+    else if ((predicate->match_mode == XSXML_MATCH_GLOB) || (predicate->match_mode == XSXML_MATCH_REGEX))
+    {
+        size_t error_position = 0;
+
+        predicate->pattern = compile_pattern( string, 
+                                              predicate->length, 
+                                              predicate->match_mode, 
+                                              predicate->is_case_insensitive, 
+                                              &error_position);
+
+        if (predicate->pattern == NULL)
+        {
+            if (error_position == XSXML_NO_NODE)
+            {
+                snprintf( result_message, 
+                          RESULT_MESSAGE_MAX_LENGTH, 
+                          "The %s pattern is too complex.", 
+                          criterion_name);
+            }
+            else
+            {
+                snprintf( result_message, 
+                          RESULT_MESSAGE_MAX_LENGTH, 
+                          "The %s pattern is invalid at position %zu.", 
+                          criterion_name, 
+                          error_position + 1);
+            }
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static int predicate_matches( const Xsxml_String_Predicate *predicate, 
+                              const char *text, 
+                              size_t text_length)
+{
+    const Xsxml_Match_Mode MATCH_MODE = predicate->match_mode;
+
+    if ((MATCH_MODE == XSXML_MATCH_EXACT) && predicate->is_case_insensitive)
+    {
+        return strings_equal_ignoring_case(text, text_length, predicate->string, predicate->length);
+    }
+    else if (MATCH_MODE == XSXML_MATCH_EXACT)
+    {
+        return strings_equal(text, text_length, predicate->string, predicate->length);
+    }
+    else if (MATCH_MODE == XSXML_MATCH_SUBSTRING)
+    {
+        return substring_found(&predicate->substring_matcher, text, text_length);
+    }
+    else if ((MATCH_MODE == XSXML_MATCH_PREFIX) && predicate->is_case_insensitive)
+    {
+        return (text_length >= predicate->length)
+            && bytes_equal_ignoring_case(text, predicate->string, predicate->length);
+    }
+    else if (MATCH_MODE == XSXML_MATCH_PREFIX)
+    {
+        return (text_length >= predicate->length)
+            && (memcmp(text, predicate->string, predicate->length) == 0);
+    }
+    else /* if ((MATCH_MODE == XSXML_MATCH_GLOB) || (MATCH_MODE == XSXML_MATCH_REGEX)) */
+    {
+        return pattern_matches(predicate->pattern, text, text_length);
+    }
+}
+
+
+/* A node satisfies the attribute predicates if any one of its attributes */
+/* satisfies both of them.                                                */
+static int attribute_predicates_match( char **attribute_names, 
+                                       const size_t *attribute_name_lengths, 
+                                       char **attribute_values, 
+                                       const size_t *attribute_value_lengths, 
+                                       size_t number_of_attributes, 
+                                       const Xsxml_String_Predicate *attribute_name, 
+                                       const Xsxml_String_Predicate *attribute_value)
+{
+    if ((attribute_name->string == NULL) && (attribute_value->string == NULL)) return 1;
+
+    for (size_t j = 0; j < number_of_attributes; j++)
+    {
+        if ((attribute_name->string != NULL)
+        &&  !predicate_matches(attribute_name, attribute_names[j], attribute_name_lengths[j]))
+        {
+            continue;
+        }
+
+        if ((attribute_value->string != NULL)
+        &&  !predicate_matches(attribute_value, attribute_values[j], attribute_value_lengths[j]))
+        {
+            continue;
+        }
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/* A node satisfies the content predicate if any one of its contents does. */
+static int contents_match( char **contents, 
+                           const size_t *content_lengths, 
+                           size_t number_of_contents, 
+                           const Xsxml_String_Predicate *content)
+{
+    if (content->string == NULL) return 1;
+
+    for (size_t k = 0; k < number_of_contents; k++)
+    {
+        if (predicate_matches(content, contents[k], content_lengths[k])) return 1;
+    }
+
+    return 0;
+}
+
+
+/*
+Lists the nodes of the given subtree in document order, if a list is given, 
+and returns their number. The subtree ends of the nodes are set relative to 
+the start of the list.
+*/
+static size_t collect_subtree( Xsxml_Nodes *subtree_root, 
+                               Xsxml_Nodes **node_list)
+{
+    size_t number_of_nodes = 0;
+
+    Xsxml_Nodes *xsxml_node = subtree_root;
+
+    while (xsxml_node != NULL)
+    {
+        if (node_list != NULL) node_list[number_of_nodes] = xsxml_node;
+
+        number_of_nodes++;
+
+        if (xsxml_node->descendant != NULL)
+        {
+            xsxml_node = xsxml_node->descendant;
+
+            continue;
+        }
+
+        /* The node is closed, along with the ancestors of which it is */
+        /* the last node, until a next sibling is found.               */
+        while (1)
+        {
+            xsxml_node->subtree_end = number_of_nodes - 1;
+
+            if (xsxml_node == subtree_root)
+            {
+                xsxml_node = NULL;
+                break;
+            }
+
+            if (xsxml_node->next_sibling != NULL)
+            {
+                xsxml_node = xsxml_node->next_sibling;
+                break;
+            }
+
+            xsxml_node = xsxml_node->ancestor;
+        }
+    }
+
+    return number_of_nodes;
+}
+
+
+static Xsxml_Edit_State *get_edit_state(Xsxml *xsxml_object)
+{
+    if (xsxml_object->edit_state == NULL)
+    {
+        xsxml_object->edit_state = 
+        (Xsxml_Edit_State *) calloc(1, sizeof(Xsxml_Edit_State));
+
+        /* The parser allocates the node array to its exact size. */
+        xsxml_object->edit_state->node_capacity = xsxml_object->number_of_nodes;
+
+        xsxml_object->memory_usage.overhead_bytes += sizeof(Xsxml_Edit_State);
+
+        xsxml_object->memory_usage.number_of_allocations++;
+    }
+
+    return xsxml_object->edit_state;
+}
+
+
+/* Records that the node order is out of date from the given index onwards, */
+/* which need only be a lower bound of the position of the edit.           */
+static void mark_out_of_order( Xsxml_Edit_State *edit_state, 
+                               size_t first_node_index)
+{
+    if (!edit_state->is_out_of_order 
+    ||  (first_node_index < edit_state->first_out_of_order_node))
+    {
+        edit_state->first_out_of_order_node = first_node_index;
+    }
+
+    edit_state->is_out_of_order = 1;
+}
+
+
+/* The columns point into the nodes, and so are discarded upon any edit. */
+static void discard_columns(Xsxml *xsxml_object)
+{
+    if (xsxml_object->columns != NULL)
+    {
+        xsxml_object->memory_usage.index_bytes -= columns_memory_bytes(xsxml_object->columns);
+
+        xsxml_object->memory_usage.number_of_allocations -= 16;
+
+        /* The columns of a shared version are freed along with its nodes. */
+        if ((xsxml_object->shared_version == NULL) 
+        ||  (xsxml_object->columns != xsxml_object->shared_version->columns))
+        {
+            xsxml_unset_columns(&xsxml_object->columns);
+        }
+        else /* if (xsxml_object->columns == xsxml_object->shared_version->columns) */
+        {
+            xsxml_object->columns = NULL;
+        }
+    }
+}
+
+
+/* The child indices no longer hold once nodes are inserted or removed. */
+static void discard_children(Xsxml *xsxml_object)
+{
+    if (xsxml_object->children != NULL)
+    {
+        xsxml_object->memory_usage.index_bytes -= 
+            children_memory_bytes(xsxml_object->children);
+
+        xsxml_object->memory_usage.number_of_allocations -= 3;
+
+        xsxml_unset_children(&xsxml_object->children);
+    }
+}
+
+
+/* The posting lists no longer hold once nodes are inserted or removed. */
+static void discard_tag_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->tag_index != NULL)
+    {
+        xsxml_object->memory_usage.index_bytes -= 
+            tag_index_memory_bytes(xsxml_object->tag_index);
+
+        xsxml_object->memory_usage.number_of_allocations -= 6;
+
+        xsxml_unset_tag_index(&xsxml_object->tag_index);
+    }
+}
+
+
+/* The posting lists no longer hold once attributes are set, or nodes */
+/* are inserted or removed.                                           */
+static void discard_attribute_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->attribute_index != NULL)
+    {
+        xsxml_object->memory_usage.index_bytes -= 
+            attribute_index_memory_bytes(xsxml_object->attribute_index);
+
+        xsxml_object->memory_usage.number_of_allocations -= 7;
+
+        xsxml_unset_attribute_index(&xsxml_object->attribute_index);
+    }
+}
+
+
+/* The posting lists no longer hold once contents are appended, or nodes */
+/* are inserted or removed.                                              */
+static void discard_content_index(Xsxml *xsxml_object)
+{
+    if (xsxml_object->content_index != NULL)
+    {
+        xsxml_object->memory_usage.index_bytes -= 
+            content_index_memory_bytes(xsxml_object->content_index);
+
+        xsxml_object->memory_usage.number_of_allocations -= 7;
+
+        xsxml_unset_content_index(&xsxml_object->content_index);
+    }
+}
+
+
+/* The generations are drawn from a counter that is shared by all the    */
+/* objects, so that no two states of any of the objects share the same */
+/* generation, even where an object takes the place of an unset one.    */
+static atomic_size_t last_generation;
+
+
+static void advance_generation(Xsxml *xsxml_object)
+{
+    xsxml_object->generation = atomic_fetch_add(&last_generation, 1) + 1;
+}
+
+
+size_t xsxml_generation(Xsxml *xsxml_object)
+{
+    if (xsxml_object->generation == 0) advance_generation(xsxml_object);
+
+    return xsxml_object->generation;
+}
+
+
+static void *copy_array( const void *array, 
+                         size_t array_size)
+{
+    void *array_copy = malloc(array_size);
+
+    memcpy(array_copy, array, array_size);
+
+    return array_copy;
+}
+
+
+/* Gives the object nodes of its own, in place of those shared with its */
+/* snapshots, before it is edited. The strings remain shared, as those  */
+/* in the string arena are never overwritten. All the nodes are copied, */
+/* and not merely those along the path of the edit, since each node is  */
+/* linked to its parent, which a shared node would then point past.     */
+static void unshare_nodes(Xsxml *xsxml_object)
+{
+    Xsxml_Shared_Version *shared_version = xsxml_object->shared_version;
+
+    if (shared_version == NULL) return;
+
+    discard_columns(xsxml_object);
+
+    xsxml_object->shared_version = NULL;
+
+    xsxml_object->memory_usage.overhead_bytes -= sizeof(Xsxml_Shared_Version);
+
+    xsxml_object->memory_usage.number_of_allocations--;
+
+    /* Once its snapshots have all been unset, the object is the only one */
+    /* left to refer to the nodes, which it then takes back as they are.  */
+    if (atomic_load(&shared_version->reference_count) == 1)
+    {
+        xsxml_unset_columns(&shared_version->columns);
+
+        free(shared_version);
+
+        return;
+    }
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    /* The plus one (+1) prevents a zero-sized allocation. */
+    Xsxml_Nodes **node_copy = (Xsxml_Nodes **) malloc((n + 1) * sizeof(Xsxml_Nodes *));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const Xsxml_Nodes *node = xsxml_object->node[i];
+
+        node_copy[i] = (Xsxml_Nodes *) copy_array(node, sizeof(Xsxml_Nodes));
+
+        if (node->node_name_length < XSXML_SHORT_STRING_SIZE)
+        {
+            node_copy[i]->node_name = &node_copy[i]->node_name_inline[0];
+        }
+
+        /* Every array holds at least one slot, as with the parsed nodes. */
+        const size_t N_C = (node->number_of_contents   > 0) ? node->number_of_contents   : 1;
+        const size_t N_A = (node->number_of_attributes > 0) ? node->number_of_attributes : 1;
+
+        node_copy[i]->content                = copy_array(node->content,                N_C * sizeof(char *));
+        node_copy[i]->content_length         = copy_array(node->content_length,         N_C * sizeof(size_t));
+        node_copy[i]->attribute_name         = copy_array(node->attribute_name,         N_A * sizeof(char *));
+        node_copy[i]->attribute_value        = copy_array(node->attribute_value,        N_A * sizeof(char *));
+        node_copy[i]->attribute_name_length  = copy_array(node->attribute_name_length,  N_A * sizeof(size_t));
+        node_copy[i]->attribute_value_length = copy_array(node->attribute_value_length, N_A * sizeof(size_t));
+
+        if (node->lazy_content != NULL)
+        {
+            node_copy[i]->lazy_content = 
+            copy_array(node->lazy_content, N_C * sizeof(Xsxml_Lazy_Content));
+        }
+    }
+
+    link_nodes(node_copy, n);
+
+    xsxml_object->node = node_copy;
 
-    free(file_name);
+    if (xsxml_object->edit_state != NULL) xsxml_object->edit_state->node_capacity = n + 1;
+
+    xsxml_unset_shared_version(&shared_version);
+}
+
+
+/* Returns whether the given node index refers to a node that is still */
+/* within the document, that is, one that has not been removed.        */
+static int is_editable_node( Xsxml *xsxml_object, 
+                             size_t node_index)
+{
+    if (node_index >= xsxml_object->number_of_nodes) return 0;
+
+    const Xsxml_Nodes *xsxml_node = xsxml_object->node[node_index];
+
+    while (xsxml_node->ancestor != NULL) xsxml_node = xsxml_node->ancestor;
+
+    return xsxml_node == xsxml_object->node[0];
+}
+
+
+static Xsxml_Result set_edit_result( Xsxml *xsxml_object, 
+                                     Xsxml_Result result, 
+                                     const char *result_message, 
+                                     size_t node_index)
+{
+    xsxml_object->result = result;
+
+    sprintf( &xsxml_object->result_message[0], 
+             result_message, 
+             node_index);
+
+    return result;
+}
+
+
+/*
+The contents of a node are positional, as the content k is compiled after 
+the child k - 1, and the content zero (0) before the first child. The slots 
+are thus opened, merged and filled so that every text keeps its place as 
+the children are inserted and removed. 
+*/
+static void insert_content_slot( Xsxml *xsxml_object, 
+                                 Xsxml_Nodes *xsxml_node, 
+                                 size_t content_index)
+{
+    const size_t n_c = xsxml_node->number_of_contents;
+
+    /* The first slot of every array is allocated along with the node. */
+    if (n_c > 0)
+    {
+        xsxml_node->content = 
+        (char **) realloc( xsxml_node->content, 
+                           (n_c + 1) * sizeof(char *));
+
+        xsxml_node->content_length = 
+        (size_t *) realloc( xsxml_node->content_length, 
+                            (n_c + 1) * sizeof(size_t));
+
+        xsxml_object->memory_usage.pointer_array_bytes += 
+            sizeof(char *) + sizeof(size_t);
+    }
+
+    memmove( &xsxml_node->content[content_index + 1], 
+             &xsxml_node->content[content_index], 
+             (n_c - content_index) * sizeof(char *));
+
+    memmove( &xsxml_node->content_length[content_index + 1], 
+             &xsxml_node->content_length[content_index], 
+             (n_c - content_index) * sizeof(size_t));
+
+    /* The lazy content array is kept in step with the content array. */
+    if (xsxml_node->lazy_content != NULL)
+    {
+        xsxml_node->lazy_content = 
+        (Xsxml_Lazy_Content *) realloc( xsxml_node->lazy_content, 
+                                        (n_c + 1) * sizeof(Xsxml_Lazy_Content));
+
+        memmove( &xsxml_node->lazy_content[content_index + 1], 
+                 &xsxml_node->lazy_content[content_index], 
+                 (n_c - content_index) * sizeof(Xsxml_Lazy_Content));
+
+        xsxml_node->lazy_content[content_index] = (Xsxml_Lazy_Content) { 0 };
+
+        xsxml_object->memory_usage.pointer_array_bytes += sizeof(Xsxml_Lazy_Content);
+    }
+
+    xsxml_node->content[content_index] = xsxml_copy_string(xsxml_object, "", 0);
+
+    xsxml_node->content_length[content_index] = 0;
+
+    xsxml_object->memory_usage.content_bytes += 1;
+
+    xsxml_node->number_of_contents++;
+}
+
+
+/* The string of the removed slot is left unused within the string arena. */
+static void remove_content_slot( Xsxml *xsxml_object, 
+                                 Xsxml_Nodes *xsxml_node, 
+                                 size_t content_index)
+{
+    const size_t n_c = xsxml_node->number_of_contents;
+
+    if (xsxml_node->content[content_index] != NULL)
+    {
+        xsxml_object->memory_usage.content_bytes -= 
+            xsxml_node->content_length[content_index] + 1;
+    }
+
+    memmove( &xsxml_node->content[content_index], 
+             &xsxml_node->content[content_index + 1], 
+             (n_c - content_index - 1) * sizeof(char *));
+
+    memmove( &xsxml_node->content_length[content_index], 
+             &xsxml_node->content_length[content_index + 1], 
+             (n_c - content_index - 1) * sizeof(size_t));
+
+    if (xsxml_node->lazy_content != NULL)
+    {
+        memmove( &xsxml_node->lazy_content[content_index], 
+                 &xsxml_node->lazy_content[content_index + 1], 
+                 (n_c - content_index - 1) * sizeof(Xsxml_Lazy_Content));
+
+        xsxml_object->memory_usage.pointer_array_bytes -= sizeof(Xsxml_Lazy_Content);
+    }
+
+    /* The first slot of every array is kept along with the node. */
+    if (n_c > 1)
+    {
+        xsxml_object->memory_usage.pointer_array_bytes -= 
+            sizeof(char *) + sizeof(size_t);
+    }
+
+    xsxml_node->number_of_contents--;
+}
+
+
+/* Appends the given text to that of the given content slot. */
+static void extend_content_slot( Xsxml *xsxml_object, 
+                                 Xsxml_Nodes *xsxml_node, 
+                                 size_t content_index, 
+                                 const char *data, 
+                                 size_t data_length)
+{
+    /* A lazily parsed content is decoded before it is extended. */
+    const char *CONTENT = node_content(xsxml_object, xsxml_node, content_index);
+
+    const size_t CONTENT_LEN = xsxml_node->content_length[content_index];
+
+    /* The plus one (+1) is for the char array's null terminator. */
+    char *joined_content = (char *) malloc(CONTENT_LEN + data_length + 1);
+
+    memcpy(&joined_content[0],           CONTENT, CONTENT_LEN);
+    memcpy(&joined_content[CONTENT_LEN], data,    data_length);
+
+    /* The previous string is left unused within the string arena. */
+    xsxml_node->content[content_index] = 
+    xsxml_copy_string(xsxml_object, joined_content, CONTENT_LEN + data_length);
+
+    xsxml_node->content_length[content_index] = CONTENT_LEN + data_length;
+
+    xsxml_object->memory_usage.content_bytes += data_length;
+
+    free(joined_content);
+}
+
+
+size_t xsxml_insert_child( Xsxml *xsxml_object, 
+                           size_t parent_node_index, 
+                           size_t child_position, 
+                           const char *tag_name)
+{
+    if (xsxml_object->is_snapshot)
+    {
+        set_edit_result( xsxml_object, 
+                         XSXML_RESULT_XML_FAILURE, 
+                         "The node %zu cannot be given a child, as it belongs to a snapshot.", 
+                         parent_node_index);
+
+        return XSXML_NO_NODE;
+    }
+
+    if ((tag_name == NULL) || (tag_name[0] == 0))
+    {
+        set_edit_result( xsxml_object, 
+                         XSXML_RESULT_XML_FAILURE, 
+                         "The tag name of node %zu's new child cannot be empty or NULL.", 
+                         parent_node_index);
+
+        return XSXML_NO_NODE;
+    }
+
+    /* Only an empty document may be given a node without a parent node. */
+    const int IS_ROOT_NODE = (parent_node_index == XSXML_NO_NODE) 
+                          && (xsxml_object->number_of_nodes == 0);
+
+    if (!IS_ROOT_NODE && !is_editable_node(xsxml_object, parent_node_index))
+    {
+        set_edit_result( xsxml_object, 
+                         XSXML_RESULT_XML_FAILURE, 
+                         "The node %zu does not exist, or has been removed.", 
+                         parent_node_index);
+
+        return XSXML_NO_NODE;
+    }
+
+    unshare_nodes(xsxml_object);
+
+    Xsxml_Edit_State *edit_state = get_edit_state(xsxml_object);
+
+    const size_t n = xsxml_object->number_of_nodes;
+
+    if (n + 1 > edit_state->node_capacity)
+    {
+        edit_state->node_capacity = 2 * (n + 1);
+
+        xsxml_object->node = 
+        (Xsxml_Nodes **) realloc( xsxml_object->node, 
+                                  edit_state->node_capacity * sizeof(Xsxml_Nodes *));
+    }
+
+    Xsxml_Nodes *parent_node = IS_ROOT_NODE ? NULL : xsxml_object->node[parent_node_index];
+
+    xsxml_object->node[n] = new_node( xsxml_object, 
+                                      tag_name, 
+                                      strlen(tag_name), 
+                                      IS_ROOT_NODE ? 0 : parent_node->depth + 1);
+
+    xsxml_object->node[n]->subtree_end = n;
+
+    xsxml_object->number_of_nodes++;
+
+    if (!IS_ROOT_NODE)
+    {
+        Xsxml_Nodes *child_node = xsxml_object->node[n];
+
+        child_node->ancestor = parent_node;
+
+        parent_node->number_of_children++;
+
+        /* The position of the child, once clamped to the number of children. */
+        size_t child_index = 0;
+
+        /* The child follows its parent, or the subtree of its previous */
+        /* sibling, in document order, as last numbered.               */
+        size_t first_node_index = parent_node_index + 1;
+
+        if ((child_position == 0) || (parent_node->descendant == NULL))
+        {
+            child_node->next_sibling = parent_node->descendant;
+
+            parent_node->descendant = child_node;
+        }
+        else /* if ((child_position > 0) && (parent_node->descendant != NULL)) */
+        {
+            /* The child is placed after its previous sibling, or after */
+            /* the last child, if the position is past the end.         */
+            Xsxml_Nodes *previous_node = parent_node->descendant;
+
+            child_index = 1;
+
+            while ((child_index < child_position) && (previous_node->next_sibling != NULL))
+            {
+                previous_node = previous_node->next_sibling;
+
+                child_index++;
+            }
+
+            child_node->previous_sibling = previous_node;
+            child_node->next_sibling     = previous_node->next_sibling;
+
+            previous_node->next_sibling = child_node;
+
+            first_node_index = previous_node->subtree_end + 1;
+        }
+
+        if (child_node->next_sibling != NULL)
+        {
+            child_node->next_sibling->previous_sibling = child_node;
+        }
+
+        /* The text before the child stays before it, whereas the child is */
+        /* followed by an empty slot, if any text follows the child.         */
+        if (parent_node->number_of_contents > child_index + 1)
+        {
+            insert_content_slot(xsxml_object, parent_node, child_index + 1);
+        }
+
+        mark_out_of_order(edit_state, first_node_index);
+    }
+
+    discard_columns(xsxml_object);
+    discard_children(xsxml_object);
+    discard_tag_index(xsxml_object);
+    discard_attribute_index(xsxml_object);
+    discard_content_index(xsxml_object);
+
+    advance_generation(xsxml_object);
+
+    set_edit_result( xsxml_object, 
+                     XSXML_RESULT_SUCCESS, 
+                     "The node %zu has been successfully inserted.", 
+                     n);
+
+    return n;
+}
+
+
+Xsxml_Result xsxml_remove_subtree( Xsxml *xsxml_object, 
+                                   size_t node_index)
+{
+    if (xsxml_object->is_snapshot)
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu cannot be edited, as it belongs to a snapshot.", 
+                                node_index);
+    }
+
+    if (!is_editable_node(xsxml_object, node_index))
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu does not exist, or has been removed.", 
+                                node_index);
+    }
+
+    unshare_nodes(xsxml_object);
+
+    Xsxml_Nodes *xsxml_node = xsxml_object->node[node_index];
+
+    if (xsxml_node->ancestor == NULL)
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The root node %zu cannot be removed.", 
+                                node_index);
+    }
+
+    Xsxml_Nodes *parent_node = xsxml_node->ancestor;
+
+    size_t child_index = 0;
+
+    for (const Xsxml_Nodes *sibling_node = xsxml_node->previous_sibling; 
+         sibling_node != NULL; 
+         sibling_node = sibling_node->previous_sibling)
+    {
+        child_index++;
+    }
+
+    /* The texts on either side of the child are joined into one. */
+    if (parent_node->number_of_contents > child_index + 1)
+    {
+        const char *FOLLOWING_CONTENT = node_content(xsxml_object, parent_node, child_index + 1);
+
+        extend_content_slot( xsxml_object, 
+                             parent_node, 
+                             child_index, 
+                             FOLLOWING_CONTENT, 
+                             parent_node->content_length[child_index + 1]);
+
+        remove_content_slot(xsxml_object, parent_node, child_index + 1);
+    }
+
+    xsxml_node->ancestor->number_of_children--;
+
+    if (xsxml_node->previous_sibling != NULL)
+        xsxml_node->previous_sibling->next_sibling = xsxml_node->next_sibling;
+    else
+        xsxml_node->ancestor->descendant = xsxml_node->next_sibling;
+
+    if (xsxml_node->next_sibling != NULL)
+    {
+        xsxml_node->next_sibling->previous_sibling = xsxml_node->previous_sibling;
+    }
+
+    xsxml_node->ancestor         = NULL;
+    xsxml_node->next_sibling     = NULL;
+    xsxml_node->previous_sibling = NULL;
+
+    Xsxml_Edit_State *edit_state = get_edit_state(xsxml_object);
+
+    if (edit_state->number_of_removed_subtrees == edit_state->removed_subtree_capacity)
+    {
+        if (edit_state->removed_subtree_capacity == 0)
+        {
+            xsxml_object->memory_usage.number_of_allocations++;
+        }
+
+        xsxml_object->memory_usage.overhead_bytes += 
+            (edit_state->removed_subtree_capacity + 1) * sizeof(Xsxml_Nodes *);
+
+        edit_state->removed_subtree_capacity = 2 * edit_state->removed_subtree_capacity + 1;
+
+        edit_state->removed_subtree = 
+        (Xsxml_Nodes **) realloc( edit_state->removed_subtree, 
+                                  edit_state->removed_subtree_capacity * sizeof(Xsxml_Nodes *));
+    }
+
+    edit_state->removed_subtree[edit_state->number_of_removed_subtrees++] = xsxml_node;
+
+    edit_state->number_of_removed_nodes += collect_subtree(xsxml_node, NULL);
+
+    mark_out_of_order(edit_state, node_index);
+
+    discard_columns(xsxml_object);
+    discard_children(xsxml_object);
+    discard_tag_index(xsxml_object);
+    discard_attribute_index(xsxml_object);
+    discard_content_index(xsxml_object);
+
+    advance_generation(xsxml_object);
+
+    return set_edit_result( xsxml_object, 
+                            XSXML_RESULT_SUCCESS, 
+                            "The subtree of node %zu has been successfully removed.", 
+                            node_index);
+}
+
+
+Xsxml_Result xsxml_set_attribute( Xsxml *xsxml_object, 
+                                  size_t node_index, 
+                                  const char *attribute_name, 
+                                  const char *attribute_value)
+{
+    if ((attribute_name == NULL) || (attribute_name[0] == 0) || (attribute_value == NULL))
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The attribute name of node %zu cannot be empty or NULL, "
+                                "and neither can its value be NULL.", 
+                                node_index);
+    }
+
+    if (xsxml_object->is_snapshot)
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu cannot be edited, as it belongs to a snapshot.", 
+                                node_index);
+    }
+
+    if (!is_editable_node(xsxml_object, node_index))
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu does not exist, or has been removed.", 
+                                node_index);
+    }
+
+    unshare_nodes(xsxml_object);
+
+    Xsxml_Nodes *xsxml_node = xsxml_object->node[node_index];
+
+    const size_t ATTRIBUTE_NAME_LEN  = strlen(attribute_name);
+    const size_t ATTRIBUTE_VALUE_LEN = strlen(attribute_value);
+
+    size_t j = 0;
+
+    while ((j < xsxml_node->number_of_attributes) 
+    &&     !strings_equal( xsxml_node->attribute_name[j], 
+                           xsxml_node->attribute_name_length[j], 
+                           attribute_name, 
+                           ATTRIBUTE_NAME_LEN))
+    {
+        j++;
+    }
+
+    if (j == xsxml_node->number_of_attributes)
+    {
+        xsxml_node->number_of_attributes++;
+
+        /* The first slot of every array is allocated along with the node. */
+        if (j > 0)
+        {
+            xsxml_node->attribute_name = 
+            (char **) realloc( xsxml_node->attribute_name, 
+                               (j + 1) * sizeof(char *));
+
+            xsxml_node->attribute_value = 
+            (char **) realloc( xsxml_node->attribute_value, 
+                               (j + 1) * sizeof(char *));
+
+            xsxml_node->attribute_name_length = 
+            (size_t *) realloc( xsxml_node->attribute_name_length, 
+                                (j + 1) * sizeof(size_t));
+
+            xsxml_node->attribute_value_length = 
+            (size_t *) realloc( xsxml_node->attribute_value_length, 
+                                (j + 1) * sizeof(size_t));
+
+            xsxml_object->memory_usage.pointer_array_bytes += 
+                2 * (sizeof(char *) + sizeof(size_t));
+        }
+
+        xsxml_node->attribute_name[j] = 
+        xsxml_copy_string(xsxml_object, attribute_name, ATTRIBUTE_NAME_LEN);
+
+        xsxml_node->attribute_name_length[j] = ATTRIBUTE_NAME_LEN;
+
+        xsxml_object->memory_usage.attribute_bytes += ATTRIBUTE_NAME_LEN + 1;
+    }
+    else /* if (j < xsxml_node->number_of_attributes) */
+    {
+        /* The previous value is left unused within the string arena. */
+        xsxml_object->memory_usage.attribute_bytes -= xsxml_node->attribute_value_length[j] + 1;
+    }
+
+    xsxml_node->attribute_value[j] = 
+    xsxml_copy_string(xsxml_object, attribute_value, ATTRIBUTE_VALUE_LEN);
+
+    xsxml_node->attribute_value_length[j] = ATTRIBUTE_VALUE_LEN;
+
+    xsxml_object->memory_usage.attribute_bytes += ATTRIBUTE_VALUE_LEN + 1;
+
+    discard_columns(xsxml_object);
+    discard_attribute_index(xsxml_object);
+
+    advance_generation(xsxml_object);
+
+    return set_edit_result( xsxml_object, 
+                            XSXML_RESULT_SUCCESS, 
+                            "The attribute of node %zu has been successfully set.", 
+                            node_index);
+}
+
+
+Xsxml_Result xsxml_append_content( Xsxml *xsxml_object, 
+                                   size_t node_index, 
+                                   const char *content)
+{
+    if (content == NULL)
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The content appended to node %zu cannot be NULL.", 
+                                node_index);
+    }
+
+    if (xsxml_object->is_snapshot)
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu cannot be edited, as it belongs to a snapshot.", 
+                                node_index);
+    }
+
+    if (!is_editable_node(xsxml_object, node_index))
+    {
+        return set_edit_result( xsxml_object, 
+                                XSXML_RESULT_XML_FAILURE, 
+                                "The node %zu does not exist, or has been removed.", 
+                                node_index);
+    }
+
+    unshare_nodes(xsxml_object);
+
+    Xsxml_Nodes *xsxml_node = xsxml_object->node[node_index];
+
+    /* The content is appended after the last child, to the text that is */
+    /* already there, if any, through the slots in between, left empty.  */
+    const size_t LAST_CONTENT_INDEX = xsxml_node->number_of_children;
+
+    while (xsxml_node->number_of_contents <= LAST_CONTENT_INDEX)
+    {
+        insert_content_slot(xsxml_object, xsxml_node, xsxml_node->number_of_contents);
+    }
+
+    extend_content_slot( xsxml_object, 
+                         xsxml_node, 
+                         LAST_CONTENT_INDEX, 
+                         content, 
+                         strlen(content));
+
+    discard_columns(xsxml_object);
+    discard_content_index(xsxml_object);
+
+    advance_generation(xsxml_object);
+
+    return set_edit_result( xsxml_object, 
+                            XSXML_RESULT_SUCCESS, 
+                            "The content of node %zu has been successfully appended.", 
+                            node_index);
+}
+
+
+/* The memory held by a removed node, excluding its strings, which are */
+/* left unused within the string arena.                                */
+static void discard_node_memory( Xsxml *xsxml_object, 
+                                 const Xsxml_Nodes *xsxml_node)
+{
+    const size_t N_C = (xsxml_node->number_of_contents   > 0) ? xsxml_node->number_of_contents   : 1;
+    const size_t N_A = (xsxml_node->number_of_attributes > 0) ? xsxml_node->number_of_attributes : 1;
+
+    xsxml_object->memory_usage.node_bytes -= sizeof(Xsxml_Nodes) + sizeof(Xsxml_Nodes *);
+
+    xsxml_object->memory_usage.pointer_array_bytes -= 
+        (N_C + 2 * N_A) * (sizeof(char *) + sizeof(size_t));
+
+    xsxml_object->memory_usage.number_of_allocations -= 7;
+
+    if (xsxml_node->lazy_content != NULL)
+    {
+        xsxml_object->memory_usage.pointer_array_bytes -= 
+            xsxml_node->number_of_contents * sizeof(Xsxml_Lazy_Content);
+
+        xsxml_object->memory_usage.number_of_allocations--;
+    }
+
+    if (xsxml_node->node_name_length >= XSXML_SHORT_STRING_SIZE)
+    {
+        xsxml_object->memory_usage.name_bytes -= xsxml_node->node_name_length + 1;
+    }
+
+    for (size_t j = 0; j < xsxml_node->number_of_contents; j++)
+    {
+        if (xsxml_node->content[j] != NULL)
+        {
+            xsxml_object->memory_usage.content_bytes -= xsxml_node->content_length[j] + 1;
+        }
+    }
+
+    for (size_t j = 0; j < xsxml_node->number_of_attributes; j++)
+    {
+        xsxml_object->memory_usage.attribute_bytes -= 
+            xsxml_node->attribute_name_length [j] + 1 
+          + xsxml_node->attribute_value_length[j] + 1;
+    }
 }
 
 
-static int parse_sub_operation_file_mode( Xsxml_Files **xsxml_files_object, 
-                                          Xsxml_Parse_Mode parse_mode, 
-                                          unsigned int node_level, 
-                                          char *data)
+/*
+Numbers the nodes that follow the given index in document order, resuming 
+the walk of collect_subtree() right after the node at the index before it, 
+whose ancestors are closed along the way. Returns the number of nodes. 
+*/
+static size_t renumber_following_nodes( Xsxml_Nodes **node_list, 
+                                        size_t first_node_index)
 {
-    Xsxml_Char_File_IO io_obj;
-    io_obj.temporary_dir_path  = (*xsxml_files_object)->node_directory_path;
-    io_obj.temporary_file_name = (*xsxml_files_object)->node_file_name;
+    Xsxml_Nodes *root_node = node_list[0];
 
-    const size_t n = (*xsxml_files_object)->number_of_nodes;
+    Xsxml_Nodes *xsxml_node = node_list[first_node_index - 1];
 
-    if (parse_mode == XSXML_TAG)
+    size_t number_of_nodes = first_node_index;
+
+    while (1)
     {
-        if (node_level == 0)
+        if (xsxml_node->descendant != NULL)
         {
-            if ((*xsxml_files_object)->number_of_nodes > 0) return 0;
+            xsxml_node = xsxml_node->descendant;
         }
+        else /* if (xsxml_node->descendant == NULL) */
+        {
+            /* The node is closed, along with the ancestors of which it is */
+            /* the last node, until a next sibling is found.               */
+            while (1)
+            {
+                xsxml_node->subtree_end = number_of_nodes - 1;
 
-        (*xsxml_files_object)->number_of_nodes++;
+                if (xsxml_node == root_node) return number_of_nodes;
 
-        const size_t NODE_FILE_NAME_LEN = strlen((*xsxml_files_object)->node_file_name);
+                if (xsxml_node->next_sibling != NULL)
+                {
+                    xsxml_node = xsxml_node->next_sibling;
+                    break;
+                }
 
-        char *temp_file_name = (char *) malloc(NODE_FILE_NAME_LEN + 5);
+                xsxml_node = xsxml_node->ancestor;
+            }
+        }
 
-        io_obj.property_term = "l";
-        io_obj.node_i_value  =  n;
-        io_obj.node_j_value  = -1;
-        io_obj.data_int      = node_level;
-        io_obj.data_str      = NULL;
-        write_to_char_file(&io_obj);
+        node_list[number_of_nodes++] = xsxml_node;
+    }
+}
 
-        io_obj.property_term = "cN";
-        io_obj.node_i_value  =  n;
-        io_obj.data_int      =  0;
-        write_to_char_file(&io_obj);
 
-        io_obj.property_term = "aN";
-        write_to_char_file(&io_obj);
+void xsxml_renumber_nodes(Xsxml *xsxml_object)
+{
+    Xsxml_Edit_State *edit_state = xsxml_object->edit_state;
 
-        io_obj.property_term = "nn";
-        io_obj.data_str      = data;
-        write_to_char_file(&io_obj);
+    if ((edit_state == NULL) || !edit_state->is_out_of_order) return;
 
-        io_obj.property_term = "d";
-        temp_file_name = get_io_file_name(&io_obj);
-        delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+    for (size_t k = 0; k < edit_state->number_of_removed_subtrees; k++)
+    {
+        Xsxml_Nodes *subtree_root = edit_state->removed_subtree[k];
 
-        io_obj.property_term = "ns";
-        temp_file_name = get_io_file_name(&io_obj);
-        delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+        const size_t SUBTREE_SIZE = collect_subtree(subtree_root, NULL);
 
-        if (node_level != 0)
+        Xsxml_Nodes **removed_node = 
+        (Xsxml_Nodes **) malloc(SUBTREE_SIZE * sizeof(Xsxml_Nodes *));
+
+        collect_subtree(subtree_root, removed_node);
+
+        for (size_t i = 0; i < SUBTREE_SIZE; i++)
         {
-            io_obj.property_term = "l";
-            io_obj.node_i_value  =  n - 1;
-            read_from_char_file(&io_obj);
+            discard_node_memory(xsxml_object, removed_node[i]);
 
-            /* The variable io_obj.data_int plays the role of   */
-            /* (*xsxml_object)->node[n-1]->depth                */
-            if (io_obj.data_int == node_level)
-            {
-                io_obj.property_term = "a";
-                read_from_char_file(&io_obj);
+            xsxml_unset_node(&removed_node[i]);
+        }
 
-                io_obj.node_i_value  = n;
-                io_obj.data_str      = NULL;
-                write_to_char_file(&io_obj);
+        free(removed_node);
+    }
 
-                io_obj.property_term = "ns";
-                io_obj.node_i_value  = n - 1;
-                io_obj.data_str      = "dummy";
-                io_obj.data_int      = n;
-                write_to_char_file(&io_obj);
+    const size_t n = xsxml_object->number_of_nodes - edit_state->number_of_removed_nodes;
 
-                io_obj.property_term = "ps";
-                io_obj.node_i_value  = n;
-                io_obj.data_int      = n - 1;
-                write_to_char_file(&io_obj);
-            }
-            else
-            {
-                io_obj.property_term = "a";
-                io_obj.node_i_value  = n;
-                io_obj.data_int      = n - 1;
-                write_to_char_file(&io_obj);
+    /* The nodes are renumbered in place, as the walk follows their links, */
+    /* from the first edited position onwards alone, since those before it */
+    /* have kept their indices. Their subtree ends are closed by the walk.  */
+    if (edit_state->first_out_of_order_node == 0)
+    {
+        if (n > 0) collect_subtree(xsxml_object->node[0], xsxml_object->node);
+    }
+    else /* if (edit_state->first_out_of_order_node > 0) */
+    {
+        renumber_following_nodes(xsxml_object->node, edit_state->first_out_of_order_node);
+    }
 
-                io_obj.property_term = "d";
-                io_obj.node_i_value  = n - 1;
-                io_obj.data_int      = n;
-                write_to_char_file(&io_obj);
+    xsxml_object->number_of_nodes = n;
 
-                for (int i = n - 1; i >= 0; i--)
-                {
-                    io_obj.node_i_value  =  i;
-                    io_obj.property_term = "l";
-                    io_obj.data_str      = "dummy";
-                    read_from_char_file(&io_obj);
+    edit_state->number_of_removed_subtrees = 0;
+    edit_state->number_of_removed_nodes    = 0;
 
-                    if (io_obj.data_int == node_level)
-                    {
-                        io_obj.property_term = "ps";
-                        io_obj.node_i_value  = n;
-                        io_obj.data_int      = i;
-                        io_obj.data_str      = NULL;
-                        write_to_char_file(&io_obj);
-
-                        io_obj.property_term = "ns";
-                        io_obj.node_i_value  = i;
-                        io_obj.data_int      = n;
-                        write_to_char_file(&io_obj);
-
-                        break;
-                    }
-                }
-            }
-        }
-        else /* if (node_level == 0) */
+    edit_state->is_out_of_order = 0;
+}
+
+
+Xsxml *xsxml_snapshot(Xsxml *xsxml_object)
+{
+    Xsxml_Shared_Version *shared_version = xsxml_object->shared_version;
+
+    if (!xsxml_object->is_snapshot)
+    {
+        if (shared_version == NULL)
         {
-            io_obj.property_term = "a";
-            temp_file_name = get_io_file_name(&io_obj);
-            delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+            /* The snapshots are never written to, and so the nodes are put */
+            /* into document order, and their contents decoded, beforehand. */
+            xsxml_renumber_nodes(xsxml_object);
 
-            io_obj.property_term = "ps";
-            temp_file_name = get_io_file_name(&io_obj);
-            delete_char_file((*xsxml_files_object)->node_directory_path, temp_file_name);
+            for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
+            {
+                materialise_contents(xsxml_object, xsxml_object->node[i]);
+            }
+
+            shared_version = 
+            (Xsxml_Shared_Version *) malloc(sizeof(Xsxml_Shared_Version));
+
+            atomic_init(&shared_version->reference_count, 1);
+
+            shared_version->node            = xsxml_object->node;
+            shared_version->number_of_nodes = xsxml_object->number_of_nodes;
+            shared_version->columns         = xsxml_object->columns;
+
+            xsxml_object->shared_version = shared_version;
+
+            xsxml_object->memory_usage.overhead_bytes += sizeof(Xsxml_Shared_Version);
+
+            xsxml_object->memory_usage.number_of_allocations++;
         }
+    }
 
-        free(temp_file_name);
+    Xsxml *xsxml_snapshot_object = (Xsxml *) calloc(1, sizeof(Xsxml));
+
+    xsxml_snapshot_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+
+    atomic_fetch_add(&shared_version->reference_count, 1);
+
+    xsxml_snapshot_object->shared_version  = shared_version;
+    xsxml_snapshot_object->is_snapshot     = 1;
+    xsxml_snapshot_object->node            = shared_version->node;
+    xsxml_snapshot_object->number_of_nodes = shared_version->number_of_nodes;
+    xsxml_snapshot_object->columns         = shared_version->columns;
+
+    if (xsxml_object->string_arena != NULL)
+    {
+        atomic_fetch_add(&xsxml_object->string_arena->reference_count, 1);
+
+        xsxml_snapshot_object->string_arena = xsxml_object->string_arena;
     }
-    else if (parse_mode == XSXML_ATTRIBUTE_NAME)
+
+    /* The memory usage of a snapshot is that of the shared memory, as at */
+    /* the time, and so excludes the columns that are not shared.          */
+    Xsxml_Memory_Usage *memory_usage = &xsxml_snapshot_object->memory_usage;
+
+    if (xsxml_object->is_snapshot)
+        *memory_usage = xsxml_object->memory_usage;
+    else
+        xsxml_memory_usage(xsxml_object, memory_usage);
+
+    size_t number_of_unshared_allocations = 0;
+
+    if ((xsxml_object->columns != NULL) && (xsxml_object->columns != shared_version->columns))
     {
-        io_obj.node_j_value  = -1;
+        memory_usage->index_bytes -= columns_memory_bytes(xsxml_object->columns);
 
-        io_obj.property_term = "aN";
-        io_obj.node_i_value  =  n - 1;
-        io_obj.data_str      = "dummy";
-        read_from_char_file(&io_obj);
+        number_of_unshared_allocations += 16;
+    }
 
-        const size_t n_a = io_obj.data_int;
+    /* The child, tag, attribute and content indices belong to the object alone. */
+    if (xsxml_object->children != NULL)
+    {
+        memory_usage->index_bytes -= children_memory_bytes(xsxml_object->children);
 
-        for (unsigned int i = 0; i < n_a; i++)
-        {
-            io_obj.property_term = "an";
-            io_obj.node_j_value  = i;
-            io_obj.data_str      = NULL;
-            read_from_char_file(&io_obj);
+        number_of_unshared_allocations += 3;
+    }
 
-            if (strcmp( (const char*)  data, 
-                        (const char*) io_obj.data_str) == 0)
-            {
-                return 0;
-            }
-        }
+    if (xsxml_object->tag_index != NULL)
+    {
+        memory_usage->index_bytes -= tag_index_memory_bytes(xsxml_object->tag_index);
 
-        io_obj.data_str = NULL;
-        io_obj.node_j_value  = -1;
-        io_obj.data_int = n_a + 1;
-        write_to_char_file(&io_obj);
+        number_of_unshared_allocations += 6;
+    }
 
-        io_obj.property_term = "an";
-        io_obj.node_j_value  = n_a;
-        io_obj.data_str      = data;
-        write_to_char_file(&io_obj);
+    if (xsxml_object->attribute_index != NULL)
+    {
+        memory_usage->index_bytes -= attribute_index_memory_bytes(xsxml_object->attribute_index);
+
+        number_of_unshared_allocations += 7;
     }
-    else if (parse_mode == XSXML_ATTRIBUTE_VALUE)
+
+    if (xsxml_object->content_index != NULL)
     {
-        io_obj.node_j_value  = -1;
+        memory_usage->index_bytes -= content_index_memory_bytes(xsxml_object->content_index);
 
-        io_obj.property_term = "aN";
-        io_obj.node_i_value  =  n - 1;
-        io_obj.data_str      = "dummy";
-        read_from_char_file(&io_obj);
+        number_of_unshared_allocations += 7;
+    }
 
-        const size_t n_a = io_obj.data_int;
+    memory_usage->number_of_allocations -= number_of_unshared_allocations;
 
-        io_obj.property_term = "av";
-        io_obj.node_j_value  = n_a - 1;
-        io_obj.data_str      = data;
-        write_to_char_file(&io_obj);
+    if (!xsxml_object->is_snapshot)
+    {
+        memory_usage->overhead_bytes -= number_of_unshared_allocations * ALLOCATION_OVERHEAD;
     }
-    else if (parse_mode == XSXML_PCDATA_CONTENT)
+
+    xsxml_snapshot_object->result = XSXML_RESULT_SUCCESS;
+
+    sprintf( &xsxml_snapshot_object->result_message[0], 
+             "The snapshot of %zu nodes has been successfully taken.", 
+             (size_t) xsxml_snapshot_object->number_of_nodes);
+
+    return xsxml_snapshot_object;
+}
+
+
+Xsxml_Result xsxml_parse_into( Xsxml *xsxml_object, 
+                               const char *input_file_path, 
+                               unsigned int parse_options)
+{
+    Xsxml_Parse_Context parse_context = { 0 };
+
+    discard_columns(xsxml_object);
+    discard_children(xsxml_object);
+    discard_tag_index(xsxml_object);
+    discard_attribute_index(xsxml_object);
+    discard_content_index(xsxml_object);
+
+    advance_generation(xsxml_object);
+
+    if (xsxml_object->shared_version != NULL)
+    {
+        /* The nodes shared with snapshots are left to them. */
+        xsxml_unset_shared_version(&xsxml_object->shared_version);
+
+        xsxml_object->node            = NULL;
+        xsxml_object->number_of_nodes = 0;
+        xsxml_object->is_snapshot     = 0;
+    }
+    else /* if (xsxml_object->shared_version == NULL) */
+    {
+        /* The removed nodes are freed, and the others put back in order. */
+        xsxml_renumber_nodes(xsxml_object);
+
+        parse_context.number_of_spare_nodes = xsxml_object->number_of_nodes;
+
+        parse_context.node_capacity = (xsxml_object->edit_state != NULL) 
+                                    ? xsxml_object->edit_state->node_capacity 
+                                    : xsxml_object->number_of_nodes;
+    }
+
+    if (xsxml_object->edit_state != NULL)
+    {
+        free(xsxml_object->edit_state->removed_subtree);
+
+        free(xsxml_object->edit_state);
+
+        xsxml_object->edit_state = NULL;
+    }
+
+    if (!(parse_options & XSXML_PARSE_OPTION_LAZY_CONTENT))
     {
-        const int is_within_current_tag = node_level;
+        free(xsxml_object->source_buffer);
+
+        xsxml_object->source_buffer = NULL;
+        xsxml_object->source_length = 0;
+    }
+
+    /* The object and its result message. */
+    xsxml_object->memory_usage = (Xsxml_Memory_Usage) { 0 };
 
-        io_obj.node_i_value = n - 1;
-        io_obj.node_j_value = -1;
+    xsxml_object->memory_usage.number_of_allocations = 2;
 
-        if (!is_within_current_tag)
+    xsxml_object->memory_usage.overhead_bytes = sizeof(Xsxml) + RESULT_MESSAGE_MAX_LENGTH;
+
+    /* A string arena that is shared with snapshots, or that holds chunks */
+    /* of various sizes, is replaced instead.                             */
+    if (xsxml_object->string_arena != NULL)
+    {
+        if ((atomic_load(&xsxml_object->string_arena->reference_count) > 1) 
+        ||  xsxml_object->string_arena->has_bulk_chunks)
         {
-            io_obj.property_term = "a";
-            io_obj.data_str      = "dummy";
-            read_from_char_file(&io_obj);
-            io_obj.node_i_value  = io_obj.data_int;
+            xsxml_unset_string_arena(&xsxml_object->string_arena);
+        }
+        else
+        {
+            reset_string_arena(xsxml_object);
         }
+    }
 
-        io_obj.property_term = "cN";
-        io_obj.node_i_value  =  n - 1;
-        io_obj.data_str      = "dummy";
-        read_from_char_file(&io_obj);
+    xsxml_object->parse_context = &parse_context;
 
-        const size_t n_c = io_obj.data_int;
+    parse_file(xsxml_object, input_file_path, parse_options);
 
-        io_obj.data_str = NULL;
-        io_obj.data_int = n_c + 1;
-        write_to_char_file(&io_obj);
+    xsxml_object->parse_context = NULL;
 
-        io_obj.property_term = "c";
-        io_obj.node_j_value  = n_c;
-        io_obj.data_str      = data;
-        write_to_char_file(&io_obj);
+    /* The spares that the new document has not needed are freed. */
+    for (size_t i = xsxml_object->number_of_nodes; i < parse_context.number_of_spare_nodes; i++)
+    {
+        xsxml_unset_node(&xsxml_object->node[i]);
+    }
+
+    if (xsxml_object->string_arena != NULL) trim_string_arena(xsxml_object->string_arena);
+
+    return xsxml_object->result;
+}
+
+
+/* Returns the position of the first node index that is not less than the */
+/* given node index, within the given node indices in document order.     */
+static size_t lower_bound_node_index( const size_t *node, 
+                                      size_t number_of_nodes, 
+                                      size_t node_index)
+{
+    size_t low  = 0;
+    size_t high = number_of_nodes;
+
+    while (low < high)
+    {
+        const size_t MIDDLE = low + (high - low) / 2;
+
+        if (node[MIDDLE] < node_index)
+            low  = MIDDLE + 1;
+        else
+            high = MIDDLE;
+    }
+
+    return low;
+}
+
+
+/*
+The state of a search for the nodes that match the criteria of the 
+occurrence functions, which are found lazily, one candidate at a time. 
+The candidates are visited from the next one onwards, by the step of the 
+direction, until none remain. 
+*/
+struct Xsxml_Match_Iter
+{
+    /* Only the object of the mode of the search is set. */
+    Xsxml       *xsxml_object;
+    Xsxml_Files *xsxml_files_object;
+
+    Xsxml_String_Predicate tag_name;
+    Xsxml_String_Predicate attribute_name;
+    Xsxml_String_Predicate attribute_value;
+    Xsxml_String_Predicate content;
+
+    /* The candidates are all the nodes, unless a list of them is given. */
+    const size_t *candidate;
+    size_t *tag_candidate;
+    size_t *content_candidate;
+
+    int candidates_have_tag_name;
+    int candidates_all_match;
+
+    size_t next_candidate;
+    size_t number_of_remaining_candidates;
+    size_t step;
+
+    /* A share owns neither the candidate lists nor the patterns, which */
+    /* remain those of the iterator that it is a share of.               */
+    int is_share;
+
+    Xsxml_Char_File_IO io_obj;
+};
+
+
+/* Sets the candidates to be visited by the given direction. */
+static void set_match_candidates( Xsxml_Match_Iter *match_iter, 
+                                  size_t number_of_candidates, 
+                                  Xsxml_Direction direction)
+{
+    match_iter->number_of_remaining_candidates = number_of_candidates;
+
+    if (direction == XSXML_DIRECTION_FORWARD)
+    {
+        match_iter->next_candidate = 0;
+        match_iter->step = 1;
+    }
+    else /* if (direction == XSXML_DIRECTION_BACKWARD) */
+    {
+        match_iter->next_candidate = number_of_candidates - 1;
+        match_iter->step = (size_t) -1;
     }
+}
+
+
+/* Returns zero (0), with the reason in the given result, if any criterion */
+/* of the query is invalid, in which case no node is a match.              */
+static int init_match_iter( Xsxml_Match_Iter *match_iter, 
+                            const Xsxml_Occurrence_Query *query, 
+                            Xsxml_Result *result, 
+                            char *result_message)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    *match_iter = (Xsxml_Match_Iter) { 0 };
+
+    const int IS_VALID = 
+           prepare_string_predicate( &match_iter->tag_name, 
+                                     query->tag_name, 
+                                     query->tag_name_match_mode, 
+                                     XSXML_MATCH_EXACT, 
+                                     query->is_tag_name_case_insensitive, 
+                                     "tag name", 
+                                     result_message)
+        && prepare_string_predicate( &match_iter->attribute_name, 
+                                     query->attribute_name, 
+                                     query->attribute_name_match_mode, 
+                                     XSXML_MATCH_EXACT, 
+                                     query->is_attribute_name_case_insensitive, 
+                                     "attribute name", 
+                                     result_message)
+        && prepare_string_predicate( &match_iter->attribute_value, 
+                                     query->attribute_value, 
+                                     query->attribute_value_match_mode, 
+                                     XSXML_MATCH_EXACT, 
+                                     query->is_attribute_value_case_insensitive, 
+                                     "attribute value", 
+                                     result_message)
+        && prepare_string_predicate( &match_iter->content, 
+                                     query->content, 
+                                     query->content_match_mode, 
+                                     XSXML_MATCH_SUBSTRING, 
+                                     query->is_content_case_insensitive, 
+                                     "content", 
+                                     result_message);
+
+    if (!IS_VALID) *result = XSXML_RESULT_XML_FAILURE;
+
+    return IS_VALID;
+}
+
+
+/* Frees the candidate lists and the patterns of the given iterator. */
+static void finish_match_iter(Xsxml_Match_Iter *match_iter)
+{
+    if (match_iter->is_share) return;
+
+    free(match_iter->tag_candidate);
+    free(match_iter->content_candidate);
+
+    free_pattern(match_iter->tag_name.pattern);
+    free_pattern(match_iter->attribute_name.pattern);
+    free_pattern(match_iter->attribute_value.pattern);
+    free_pattern(match_iter->content.pattern);
+}
+
+
+/*
+Lists the nodes, in document order, of every tag name of the tag index 
+that satisfies the tag name criterion, which is thus matched once per 
+distinct tag name, rather than once per node, and returns their number. 
+The nodes of a single tag name are those of the index itself. 
+*/
+static size_t match_tag_index_names( Xsxml_Match_Iter *match_iter, 
+                                     const Xsxml_Tag_Index *tag_index)
+{
+    Xsxml *xsxml_object = match_iter->xsxml_object;
 
-    return 1;
-}
+    size_t *name_id = (size_t *) malloc((tag_index->number_of_names + 1) * sizeof(size_t));
 
+    size_t number_of_names      = 0;
+    size_t number_of_candidates = 0;
 
-static Xsxml_Private_Result *parse_operation( void **object, 
-                                              const Xml_Data_Access_Mode access_mode, 
-                                              FILE *file_pointer)
-{
-    Xsxml_Private_Result *result_obj = 
-    (Xsxml_Private_Result *) malloc(sizeof(Xsxml_Private_Result));
+    for (size_t id = 0; id < tag_index->number_of_names; id++)
+    {
+        const Xsxml_Nodes *FIRST_NODE = 
+            xsxml_object->node[tag_index->node[tag_index->node_start[id]]];
 
-    result_obj->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+        if (predicate_matches( &match_iter->tag_name, 
+                               FIRST_NODE->node_name, 
+                               FIRST_NODE->node_name_length))
+        {
+            name_id[number_of_names++] = id;
 
-    int XML_X                   = 0;    /* X */
-    int XML_M                   = 0;    /* M */
-    int XML_EQUAL               = 0;    /* = */
-    int XML_HYPHEN              = 0;    /* - */
-    int XML_QUESTION            = 0;    /* ? */
-    int XML_AMPERSAND           = 0;    /* & */
-    int XML_WHITESPACE          = 0;    /*   */
-    int XML_SINGLE_QUOTE        = 0;    /* - */
-    int XML_DOUBLE_QUOTE        = 0;    /* - */
-    int XML_FORWARD_SLASH_END   = 0;    /* / */
-    int XML_FORWARD_SLASH_START = 0;    /* / */
-    int XML_END_SQUARE_BRACKET  = 0;    /* ] */
+            number_of_candidates += tag_index->node_start[id + 1] - tag_index->node_start[id];
+        }
+    }
 
-    int XML_HEADING             = 0;
-    int XML_COMMENT_CONTENT     = 0;
-    int XML_COMMENT_START_TAG   = 0;
-    int XML_TAG                 = 0;
-    int XML_ATTRIBUTE           = 0;
-    int XML_ATTRIBUTE_NAME      = 0;
-    int XML_ATTRIBUTE_VALUE     = 0;
-    int XML_CDATA_CONTENT       = 0;
-    int XML_CDATA_START_TAG     = 0;
-    int XML_PCDATA_CONTENT      = 0;
+    if (number_of_names == 1)
+    {
+        match_iter->candidate = &tag_index->node[tag_index->node_start[name_id[0]]];
+    }
+    else if (number_of_names > 1)
+    {
+        /* The plus one (+1) prevents a zero-sized allocation. */
+        match_iter->tag_candidate = 
+        (size_t *) malloc((number_of_candidates + 1) * sizeof(size_t));
 
-    int XML_TAG_RECENTLY_CLOSED = 0;
+        size_t number_copied = 0;
 
+        for (size_t n = 0; n < number_of_names; n++)
+        {
+            const size_t START = tag_index->node_start[name_id[n]];
+            const size_t END   = tag_index->node_start[name_id[n] + 1];
 
-    int cer_i      = 0;                 /* Character entry reference count */
-    int word_len   = 0;                 /* Word characters count           */
-    int node_level = 0;                 /* Current hierarchical depth      */
+            memcpy( &match_iter->tag_candidate[number_copied], 
+                    &tag_index->node[START], 
+                    (END - START) * sizeof(size_t));
 
+            number_copied += END - START;
+        }
 
-    char *word = (char *) calloc(1, sizeof(char));
+        qsort( match_iter->tag_candidate, 
+               number_of_candidates, 
+               sizeof(size_t), 
+               compare_node_indices);
 
-    char *character_entry_reference = 
-    (char *) calloc( CHARACTER_ENTRY_REFERENCE_MAX_LENGTH + 1, sizeof(char));
+        match_iter->candidate = match_iter->tag_candidate;
+    }
 
-    character_entry_reference [CHARACTER_ENTRY_REFERENCE_MAX_LENGTH] = 0;
+    free(name_id);
 
+    return number_of_candidates;
+}
 
-    while (1)
+
+/* Returns zero (0) if any criterion of the query is invalid. */
+static int start_match_iter( Xsxml_Match_Iter *match_iter, 
+                             Xsxml *xsxml_object, 
+                             const Xsxml_Occurrence_Query *query)
+{
+    const int IS_VALID = init_match_iter( match_iter, 
+                                          query, 
+                                          &xsxml_object->result, 
+                                          xsxml_object->result_message);
+
+    match_iter->xsxml_object = xsxml_object;
+
+    const char *TAG_NAME        = match_iter->tag_name.string;
+    const char *ATTRIBUTE_NAME  = match_iter->attribute_name.string;
+    const char *ATTRIBUTE_VALUE = match_iter->attribute_value.string;
+    const char *CONTENT         = match_iter->content.string;
+
+    /* Without any valid criteria, no node is a match. */
+    if (!IS_VALID
+    ||  ((TAG_NAME == NULL) && (ATTRIBUTE_NAME  == NULL)
+    &&   (CONTENT  == NULL) && (ATTRIBUTE_VALUE == NULL)))
     {
-        char file_data_character = fgetc(file_pointer);
+        return IS_VALID;
+    }
 
-        if (feof(file_pointer)) break;
+    xsxml_renumber_nodes(xsxml_object);
 
-        /* The below code is just a test code for debugging purposes. */
-        /* printf("%c", file_data_character);                         */
+    /* The candidates are all the nodes, unless a tag name narrows them */
+    /* down to the nodes of that tag name, through the tag index.       */
+    size_t number_of_candidates = xsxml_object->number_of_nodes;
 
+    if (TAG_NAME != NULL)
+    {
+        const Xsxml_Tag_Index *tag_index = xsxml_tag_index(xsxml_object);
 
-/* ########################################################################## */
-/*                                  XML HEADING                               */
-/* ########################################################################## */
-        if (XML_HEADING)
+        if ((match_iter->tag_name.match_mode == XSXML_MATCH_EXACT)
+        &&  !match_iter->tag_name.is_case_insensitive)
         {
-            if (file_data_character == '?')
-            {
-                XML_QUESTION = 1;
-                continue;
-            }
-
-            if (XML_QUESTION)
-            {
-                if (file_data_character == '>')
-                {
-                    XML_QUESTION = 0;
-                    XML_HEADING  = 0;
-                    continue;
-                }
-            }
+            const size_t NAME_ID = tag_index_find(xsxml_object, tag_index, TAG_NAME);
 
-            XML_QUESTION = 0;
-            continue;
-        }
+            /* No node has the given tag name. */
+            if (NAME_ID == XSXML_NO_NODE) return 1;
 
+            match_iter->candidate = &tag_index->node[tag_index->node_start[NAME_ID]];
 
-/* ########################################################################## */
-/*                            XML COMMENT CONTENT                             */
-/* ########################################################################## */
-        if (XML_COMMENT_CONTENT)
+            number_of_candidates = tag_index->node_start[NAME_ID + 1]
+                                 - tag_index->node_start[NAME_ID];
+        }
+        else /* if (the tag name is not matched exactly, or regardless of the case) */
         {
-            if (file_data_character == '-')
-            {
-                if (XML_HYPHEN == 1)
-                {
-                    XML_HYPHEN = 2;
-                    continue;
-                }
-                else if (XML_HYPHEN == 2)
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+            number_of_candidates = match_tag_index_names(match_iter, tag_index);
 
-                    sprintf( &result_obj->result_message[0], 
-                             "A double hyphen (--) within comments "
-                             "is not allowed.");
+            /* No tag name satisfies the criterion. */
+            if (number_of_candidates == 0) return 1;
+        }
 
-                    return result_obj;
-                }
+        match_iter->candidates_have_tag_name = 1;
 
-                XML_HYPHEN = 1;
-                continue;
-            }
+        /* Every node of the tag name is a match. */
+        match_iter->candidates_all_match = 
+            (ATTRIBUTE_NAME == NULL) && (ATTRIBUTE_VALUE == NULL) && (CONTENT == NULL);
+    }
 
-            if (XML_HYPHEN)
-            {
-                if (file_data_character == '>')
-                {
-                    XML_HYPHEN  = 0;
-                    XML_COMMENT_CONTENT = 0;
-                    continue;
-                }
-            }
+    /* An exact attribute name and value narrow the candidates down to the */
+    /* nodes that have both, through the attribute index, if they are fewer. */
+    if ((ATTRIBUTE_NAME != NULL) && (ATTRIBUTE_VALUE != NULL)
+    &&  (match_iter->attribute_name.match_mode  == XSXML_MATCH_EXACT)
+    &&  (match_iter->attribute_value.match_mode == XSXML_MATCH_EXACT)
+    &&  !match_iter->attribute_name.is_case_insensitive
+    &&  !match_iter->attribute_value.is_case_insensitive)
+    {
+        const Xsxml_Attribute_Index *attribute_index = xsxml_attribute_index(xsxml_object);
 
-            XML_HYPHEN = 0;
-            continue;
-        }
+        const size_t PAIR_ID = attribute_index_find( xsxml_object, 
+                                                     attribute_index, 
+                                                     ATTRIBUTE_NAME, 
+                                                     ATTRIBUTE_VALUE);
 
+        /* No node has the given attribute name and value. */
+        if (PAIR_ID == XSXML_NO_NODE) return 1;
 
-/* ########################################################################## */
-/*                            XML COMMENT START TAG                           */
-/* ########################################################################## */
-        if (XML_COMMENT_START_TAG)
-        {
-            if (file_data_character == '-')
-            {
-                XML_COMMENT_CONTENT   = 1;
-                XML_COMMENT_START_TAG = 0;
-                continue;
-            }
+        const size_t NUMBER_OF_PAIR_NODES = attribute_index->node_start[PAIR_ID + 1]
+                                          - attribute_index->node_start[PAIR_ID];
 
-            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        if (NUMBER_OF_PAIR_NODES < number_of_candidates)
+        {
+            match_iter->candidate = &attribute_index->node[attribute_index->node_start[PAIR_ID]];
 
-            sprintf( &result_obj->result_message[0], 
-                     "Tag names must start with an alphabetical character "
-                     "[a-zA-Z] or underscore (_)");
+            number_of_candidates = NUMBER_OF_PAIR_NODES;
 
-            return result_obj;
+            match_iter->candidates_have_tag_name = 0;
         }
+    }
 
+    /* A content narrows the candidates down to the nodes that hold every */
+    /* trigram of the content, through the content index, if it has been */
+    /* built, and if they are fewer. Only the match modes in which every  */
+    /* matching content holds the whole criterion can be narrowed down,  */
+    /* and only if the case is matched, as the trigrams are case-sensitive. */
+    const Xsxml_Match_Mode CONTENT_MATCH_MODE = match_iter->content.match_mode;
+
+    if ((CONTENT != NULL) && (xsxml_object->content_index != NULL)
+    &&  !match_iter->content.is_case_insensitive
+    &&  ((CONTENT_MATCH_MODE == XSXML_MATCH_EXACT)
+     ||  (CONTENT_MATCH_MODE == XSXML_MATCH_SUBSTRING)
+     ||  (CONTENT_MATCH_MODE == XSXML_MATCH_PREFIX)))
+    {
+        const size_t NUMBER_OF_CONTENT_CANDIDATES = 
+            content_index_candidates( xsxml_object->content_index, 
+                                      CONTENT, 
+                                      match_iter->content.length, 
+                                      &match_iter->content_candidate);
 
-/* ########################################################################## */
-/*                             XML CDATA CONTENT                              */
-/* ########################################################################## */
-        if (XML_CDATA_CONTENT)
+        if (NUMBER_OF_CONTENT_CANDIDATES < number_of_candidates)
         {
-            if (file_data_character == ']')
-            {
-                XML_END_SQUARE_BRACKET++;
-                continue;
-            }
-
-            if ((XML_END_SQUARE_BRACKET == 2) && (file_data_character == '>'))
-            {
-                /* Working on CDATA. */
+            match_iter->candidate = match_iter->content_candidate;
 
-                /* The below code is just a test code for debugging purposes.       */
-                /* printf("\n\n%*sCDATA = %s", node_level * INDENTATION, "", word); */
+            number_of_candidates = NUMBER_OF_CONTENT_CANDIDATES;
 
-                XML_CDATA_CONTENT      = 0;
-                XML_END_SQUARE_BRACKET = 0;
-                continue;
-            }
+            match_iter->candidates_have_tag_name = 0;
+        }
+    }
 
-            while (XML_END_SQUARE_BRACKET > 0)
-            {
-                append_character_to_word(&word, ']', &word_len);
+    set_match_candidates(match_iter, number_of_candidates, query->direction);
 
-                XML_END_SQUARE_BRACKET--;
-            }
+    return 1;
+}
 
-            append_character_to_word(&word, file_data_character, &word_len);
 
-            continue;
-        }
+/* Restricts the candidates of a newly started search to the nodes from */
+/* the first to the last given one, in document order.                  */
+static void scope_match_iter( Xsxml_Match_Iter *match_iter, 
+                              size_t first_node_index, 
+                              size_t last_node_index, 
+                              Xsxml_Direction direction)
+{
+    if (match_iter->number_of_remaining_candidates == 0) return;
 
+    size_t scope_start = first_node_index;
+    size_t scope_end   = last_node_index + 1;
 
-/* ########################################################################## */
-/*                              XML CDATA START TAG                           */
-/* ########################################################################## */
-        if (XML_CDATA_START_TAG)
-        {
-            if (file_data_character == '-')
-            {
-                XML_COMMENT_START_TAG = 1;
-                XML_CDATA_START_TAG   = 0;
-                continue;
-            }
+    /* The candidate lists of the indices are in document order, and so */
+    /* those within the scope are contiguous.                            */
+    if (match_iter->candidate != NULL)
+    {
+        const size_t NUMBER_OF_CANDIDATES = match_iter->number_of_remaining_candidates;
 
-            if (((XML_CDATA_START_TAG == 1) && (file_data_character == '[')) 
-            ||  ((XML_CDATA_START_TAG == 2) && (file_data_character == 'C')) 
-            ||  ((XML_CDATA_START_TAG == 3) && (file_data_character == 'D')) 
-            ||  ((XML_CDATA_START_TAG == 4) && (file_data_character == 'A')) 
-            ||  ((XML_CDATA_START_TAG == 5) && (file_data_character == 'T')) 
-            ||  ((XML_CDATA_START_TAG == 6) && (file_data_character == 'A')))
-            {
-                XML_CDATA_START_TAG++;
-                continue;
-            }
+        scope_start = lower_bound_node_index( match_iter->candidate, 
+                                              NUMBER_OF_CANDIDATES, 
+                                              first_node_index);
 
-            if ((XML_CDATA_START_TAG == 7) && (file_data_character == '['))
-            {
-                XML_CDATA_CONTENT      = 1;
-                XML_PCDATA_CONTENT     = 1;
-                XML_CDATA_START_TAG    = 0;
-                XML_END_SQUARE_BRACKET = 0;
-                continue;
-            }
+        scope_end = lower_bound_node_index( match_iter->candidate, 
+                                            NUMBER_OF_CANDIDATES, 
+                                            last_node_index + 1);
+    }
 
-            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    set_match_candidates(match_iter, scope_end - scope_start, direction);
 
-            sprintf( &result_obj->result_message[0], 
-                     "Tag names must start with an alphabetical character "
-                     "[a-zA-Z] or underscore (_)");
+    match_iter->next_candidate += scope_start;
+}
 
-            return result_obj;
-        }
 
+static int start_files_match_iter( Xsxml_Match_Iter *match_iter, 
+                                   Xsxml_Files *xsxml_files_object, 
+                                   const Xsxml_Occurrence_Query *query)
+{
+    const int IS_VALID = init_match_iter( match_iter, 
+                                          query, 
+                                          &xsxml_files_object->result, 
+                                          xsxml_files_object->result_message);
 
-/* ########################################################################## */
-/*                                  XML TAG                                   */
-/* ########################################################################## */
-        if (XML_TAG)
-        {
-            if (XML_PCDATA_CONTENT)
-            {
-                if (file_data_character == '!')
-                {
-                    XML_TAG = 0;
-                    XML_PCDATA_CONTENT  = 0;
-                    XML_CDATA_START_TAG = 1;
-                    continue;
-                }
+    match_iter->xsxml_files_object = xsxml_files_object;
 
-                /* Working on PCDATA. */
+    match_iter->io_obj.temporary_dir_path  = xsxml_files_object->node_directory_path;
+    match_iter->io_obj.temporary_file_name = xsxml_files_object->node_file_name;
 
-                word [word_len] = 0;
+    /* Without any valid criteria, no node is a match. */
+    if (!IS_VALID
+    ||  ((match_iter->tag_name.string == NULL) && (match_iter->attribute_name.string  == NULL)
+    &&   (match_iter->content.string  == NULL) && (match_iter->attribute_value.string == NULL)))
+    {
+        return IS_VALID;
+    }
 
-                if (word[word_len - 1] == ' ')
-                {
-                    word[word_len - 1] = '\0';
+    set_match_candidates(match_iter, xsxml_files_object->number_of_nodes, query->direction);
 
-                    word_len--;
-                }
+    return 1;
+}
 
-                if (strstr(word, "<![CDATA[") != NULL)
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
 
-                    sprintf( &result_obj->result_message[0], 
-                             "Nested CDATA is not allowed.");
+static int node_matches( const Xsxml_Match_Iter *match_iter, 
+                         size_t i)
+{
+    Xsxml *xsxml_object = match_iter->xsxml_object;
 
-                    return result_obj;
-                }
+    if ((match_iter->tag_name.string != NULL) && !match_iter->candidates_have_tag_name
+    &&  !predicate_matches( &match_iter->tag_name, 
+                            xsxml_object->node[i]->node_name, 
+                            xsxml_object->node[i]->node_name_length))
+    {
+        return 0;
+    }
 
-                if (access_mode == XSXML_RAM_MODE)
-                {
-                    parse_sub_operation_ram_mode( (Xsxml **) object, 
-                                                   XSXML_PCDATA_CONTENT, 
-                                                   !XML_TAG_RECENTLY_CLOSED, 
-                                                   word);
-                }
-                else /* if (access_mode == XSXML_FILE_MODE) */
-                {
-                    parse_sub_operation_file_mode( (Xsxml_Files **) object, 
-                                                    XSXML_PCDATA_CONTENT, 
-                                                    !XML_TAG_RECENTLY_CLOSED, 
-                                                    word);
-                }
+    /* The columnar form, if present, is scanned instead of the nodes. */
+    const Xsxml_Columns *columns = xsxml_object->columns;
 
-                /* The below code is just a test code for debugging purposes.        */
-                /* printf("\n\n%*sPCDATA = %s", node_level * INDENTATION, "", word); */
+    if (columns != NULL)
+    {
+        const size_t A_START = columns->attribute_start[i];
+        const size_t C_START = columns->content_start[i];
+
+        return attribute_predicates_match( &columns->attribute_name [A_START], 
+                                           &columns->attribute_name_length [A_START], 
+                                           &columns->attribute_value[A_START], 
+                                           &columns->attribute_value_length[A_START], 
+                                           columns->attribute_start[i + 1] - A_START, 
+                                           &match_iter->attribute_name, 
+                                           &match_iter->attribute_value)
+            && contents_match( &columns->content[C_START], 
+                               &columns->content_length[C_START], 
+                               columns->content_start[i + 1] - C_START, 
+                               &match_iter->content);
+    }
+    else /* if (columns == NULL) */
+    {
+        Xsxml_Nodes *node = xsxml_object->node[i];
+
+        if (match_iter->content.string != NULL) materialise_contents(xsxml_object, node);
+
+        return attribute_predicates_match( node->attribute_name, 
+                                           node->attribute_name_length, 
+                                           node->attribute_value, 
+                                           node->attribute_value_length, 
+                                           node->number_of_attributes, 
+                                           &match_iter->attribute_name, 
+                                           &match_iter->attribute_value)
+            && contents_match( node->content, 
+                               node->content_length, 
+                               node->number_of_contents, 
+                               &match_iter->content);
+    }
+}
 
-                reset_word(&word, &word_len);
 
-                XML_PCDATA_CONTENT = 0;
-            }
+/* Reads the given string property of the node, which is matched against */
+/* the given predicate, and freed.                                       */
+static int files_property_matches( Xsxml_Char_File_IO *io_obj, 
+                                   char *property_term, 
+                                   size_t node_j_value, 
+                                   const Xsxml_String_Predicate *predicate)
+{
+    io_obj->node_j_value  = node_j_value;
+    io_obj->property_term = property_term;
+    io_obj->data_str      = NULL;
+    read_from_char_file(io_obj);
 
-            if (!XML_ATTRIBUTE && word_len == 0)
-            {
-                if (file_data_character == '!')
-                {
-                    XML_TAG = 0;
-                    XML_CDATA_START_TAG = 1;
-                    continue;
-                }
+    const int IS_MATCH = predicate_matches(predicate, io_obj->data_str, strlen(io_obj->data_str));
 
-                if (file_data_character == '/')
-                {
-                    XML_FORWARD_SLASH_START = 1;
-                    continue;
-                }
+    free(io_obj->data_str);
 
-                if (file_data_character == '?')
-                {
-                    XML_TAG      = 0;
-                    XML_QUESTION = 0;
-                    XML_HEADING  = 1;
-                    continue;
-                }
+    io_obj->data_str = NULL;
 
-                if (!isalpha(file_data_character) && file_data_character != '_')
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    return IS_MATCH;
+}
 
-                    sprintf( &result_obj->result_message[0], 
-                             "Tag names must start with an alphabetical character "
-                             "[a-zA-Z] or underscore (_)");
 
-                    return result_obj;
-                }
+/* The criteria are checked in the same manner as in RAM mode, where the */
+/* files of a node are only read until one of the criteria fails.       */
+static int files_node_matches( Xsxml_Match_Iter *match_iter, 
+                               size_t i)
+{
+    Xsxml_Char_File_IO *io_obj = &match_iter->io_obj;
 
-                if ((file_data_character == 'x') || (file_data_character == 'X'))
-                {
-                    XML_X = 1;
-                    append_character_to_word(&word, file_data_character, &word_len);
+    io_obj->node_i_value = i;
 
-                    continue;
-                }
-            }
+    if ((match_iter->tag_name.string != NULL)
+    &&  !files_property_matches(io_obj, "nn", XSXML_NO_NODE, &match_iter->tag_name))
+    {
+        return 0;
+    }
 
-            if (XML_X)
-            {
-                if ((file_data_character == 'm') || (file_data_character == 'M'))
-                {
-                    XML_M = 1;
-                    append_character_to_word(&word, file_data_character, &word_len);
-                    continue;
-                }
-                XML_X = 0;
-            }
+    if ((match_iter->attribute_name.string != NULL) || (match_iter->attribute_value.string != NULL))
+    {
+        int attribute_is_true = 0;
 
-            if (XML_M)
-            {
-                if ((file_data_character == 'l') || (file_data_character == 'L'))
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        io_obj->node_j_value  = XSXML_NO_NODE;
+        io_obj->property_term = "aN";
+        io_obj->data_str      = "dummy";
+        read_from_char_file(io_obj);
 
-                    sprintf( &result_obj->result_message[0], 
-                             "Tag names cannot start with 'xml' or "
-                             "any of its variants like XML, Xml, etc.");
+        const size_t N_A = io_obj->data_int;
 
-                    return result_obj;
-                }
-                XML_X = 0;
-                XML_M = 0;
-            }
+        for (size_t j = 0; (j < N_A) && !attribute_is_true; j++)
+        {
+            attribute_is_true = 
+                ((match_iter->attribute_name.string == NULL)
+              || files_property_matches(io_obj, "an", j, &match_iter->attribute_name))
+             && ((match_iter->attribute_value.string == NULL)
+              || files_property_matches(io_obj, "av", j, &match_iter->attribute_value));
+        }
 
+        if (!attribute_is_true) return 0;
+    }
 
-/* ########################################################################## */
-/*                              XML ATTRIBUTE VALUE                           */
-/* ########################################################################## */
-            if (XML_ATTRIBUTE_VALUE)
-            {
-                if (file_data_character == '<')
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    if (match_iter->content.string != NULL)
+    {
+        int content_is_true = 0;
 
-                    sprintf( &result_obj->result_message[0], 
-                             "Attribute values may not contain the "
-                             "less-than (<) characters.");
+        io_obj->node_j_value  = XSXML_NO_NODE;
+        io_obj->property_term = "cN";
+        io_obj->data_str      = "dummy";
+        read_from_char_file(io_obj);
 
-                    return result_obj;
-                }
+        const size_t N_C = io_obj->data_int;
 
-                if (file_data_character == '&')
-                {
-                    if (!XML_AMPERSAND)
-                    {
-                        cer_i = 0;
+        for (size_t k = 0; (k < N_C) && !content_is_true; k++)
+        {
+            content_is_true = files_property_matches(io_obj, "c", k, &match_iter->content);
+        }
 
-                        memset( &character_entry_reference[0], 
-                                0, 
-                                CHARACTER_ENTRY_REFERENCE_MAX_LENGTH);
+        if (!content_is_true) return 0;
+    }
 
-                        character_entry_reference[0] = '&';
+    return 1;
+}
 
-                        XML_AMPERSAND = 1;
 
-                        continue;
-                    }
-                }
+size_t xsxml_match_iter_next(Xsxml_Match_Iter *match_iter)
+{
+    while (match_iter->number_of_remaining_candidates > 0)
+    {
+        const size_t K = match_iter->next_candidate;
 
-                if (file_data_character == ';')
-                {
-                    if (parse_cer(&character_entry_reference))
-                    {
-                        append_character_to_word( &word, 
-                                                  character_entry_reference[0], 
-                                                  &word_len);
-                    }
-                    else
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        match_iter->next_candidate += match_iter->step;
+        match_iter->number_of_remaining_candidates--;
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "Attribute values may contain the ampersand (&) "
-                                 "characters only as character entity references.");
+        const size_t i = (match_iter->candidate == NULL) ? K : match_iter->candidate[K];
 
-                        return result_obj;
-                    }
+        if ((match_iter->xsxml_object != NULL) 
+            ? node_matches(match_iter, i) 
+            : files_node_matches(match_iter, i))
+        {
+            return i;
+        }
+    }
 
-                    XML_AMPERSAND = 0;
-                    continue;
-                }
+    return XSXML_NO_NODE;
+}
 
-                if (XML_AMPERSAND)
-                {
-                    if (cer_i == (CHARACTER_ENTRY_REFERENCE_MAX_LENGTH - 1))
-                    {
-                        const char *MESSAGE_PART_1 = "Attribute values may contain "
-                                                     "the ampersand (&) characters "
-                                                     "only as character entity "
-                                                     "references. ";
 
-                        const char *MESSAGE_PART_2 = "Character entry references "
-                                                     "may contain atmost ";
+size_t xsxml_match_iter_next_batch( Xsxml_Match_Iter *match_iter, 
+                                    size_t *node_indices, 
+                                    size_t capacity)
+{
+    size_t number_of_matches = 0;
 
-                        const char *MESSAGE_PART_3 = " number of characters.";
+    /* The candidates that are all matches are copied without checks. */
+    if (match_iter->candidates_all_match)
+    {
+        number_of_matches = (match_iter->number_of_remaining_candidates < capacity) 
+                          ? match_iter->number_of_remaining_candidates 
+                          : capacity;
 
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        for (size_t n = 0; n < number_of_matches; n++)
+        {
+            node_indices[n] = match_iter->candidate[match_iter->next_candidate];
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "%s%s%d%s", 
-                                 MESSAGE_PART_1, 
-                                 MESSAGE_PART_2, 
-                                 CHARACTER_ENTRY_REFERENCE_MAX_LENGTH, 
-                                 MESSAGE_PART_3);
+            match_iter->next_candidate += match_iter->step;
+        }
 
-                        return result_obj;
-                    }
+        match_iter->number_of_remaining_candidates -= number_of_matches;
 
-                    character_entry_reference [cer_i++] = file_data_character;
-                    continue;
-                }
+        return number_of_matches;
+    }
 
-                if (((file_data_character == '\'') && XML_SINGLE_QUOTE) 
-                ||  ((file_data_character == '\"') && XML_DOUBLE_QUOTE))
-                {
-                    if (XML_AMPERSAND)
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    while (number_of_matches < capacity)
+    {
+        const size_t NODE_INDEX = xsxml_match_iter_next(match_iter);
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "Attribute values may contain the ampersand (&) "
-                                 "characters only as character entity references.");
+        if (NODE_INDEX == XSXML_NO_NODE) break;
 
-                        return result_obj;
-                    }
+        node_indices[number_of_matches++] = NODE_INDEX;
+    }
 
-                    /* Working on attribute value. */
+    return number_of_matches;
+}
 
-                    word [word_len] = 0;
 
-                    if (access_mode == XSXML_RAM_MODE)
-                    {
-                        parse_sub_operation_ram_mode( (Xsxml **) object, 
-                                                       XSXML_ATTRIBUTE_VALUE, 
-                                                       node_level, 
-                                                       word);
-                    }
-                    else /* if (access_mode == XSXML_FILE_MODE) */
-                    {
-                        parse_sub_operation_file_mode( (Xsxml_Files **) object, 
-                                                        XSXML_ATTRIBUTE_VALUE, 
-                                                        node_level, 
-                                                        word);
-                    }
+Xsxml_Match_Iter *xsxml_match_iter_start( Xsxml *xsxml_object, 
+                                          char *tag_name, 
+                                          char *attribute_name, 
+                                          char *attribute_value, 
+                                          char *content, 
+                                          Xsxml_Direction direction)
+{
+    /* The criteria are matched in their default match modes. */
+    const Xsxml_Occurrence_Query QUERY = { .tag_name        = tag_name, 
+                                           .attribute_name  = attribute_name, 
+                                           .attribute_value = attribute_value, 
+                                           .content         = content, 
+                                           .direction       = direction };
 
-                    /* The below code is just a test code for debugging purposes. */
-                    /* printf("  &  ATTRIBUTE VALUE = %s", word);                 */
+    Xsxml_Match_Iter *match_iter = (Xsxml_Match_Iter *) malloc(sizeof(Xsxml_Match_Iter));
 
-                    reset_word(&word, &word_len);
+    start_match_iter(match_iter, xsxml_object, &QUERY);
 
-                    XML_ATTRIBUTE       = 1;
-                    XML_ATTRIBUTE_NAME  = 0;
-                    XML_ATTRIBUTE_VALUE = 0;
-                    XML_SINGLE_QUOTE    = 0;
-                    XML_DOUBLE_QUOTE    = 0;
-                    XML_EQUAL           = 0;
-                    continue;
-                }
+    return match_iter;
+}
 
-                append_character_to_word(&word, file_data_character, &word_len);
-                continue;
-            }
 
+Xsxml_Match_Iter *xsxml_files_match_iter_start( Xsxml_Files *xsxml_files_object, 
+                                                char *tag_name, 
+                                                char *attribute_name, 
+                                                char *attribute_value, 
+                                                char *content, 
+                                                Xsxml_Direction direction)
+{
+    /* The criteria are matched in their default match modes. */
+    const Xsxml_Occurrence_Query QUERY = { .tag_name        = tag_name, 
+                                           .attribute_name  = attribute_name, 
+                                           .attribute_value = attribute_value, 
+                                           .content         = content, 
+                                           .direction       = direction };
 
-/* ########################################################################## */
-/*                                 XML END TAG                                */
-/* ########################################################################## */
-            if (file_data_character == '>')
-            {
-                if (XML_ATTRIBUTE_NAME)
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    Xsxml_Match_Iter *match_iter = (Xsxml_Match_Iter *) malloc(sizeof(Xsxml_Match_Iter));
 
-                    sprintf( &result_obj->result_message[0], 
-                             "If empty, then attribute values must atleast "
-                             "contain the double quotes ("").");
+    start_files_match_iter(match_iter, xsxml_files_object, &QUERY);
 
-                    return result_obj;
-                }
+    return match_iter;
+}
 
-                XML_TAG_RECENTLY_CLOSED = 0;
 
-                if (XML_FORWARD_SLASH_END)
-                {
-                    node_level--;
-                    XML_FORWARD_SLASH_END   = 0;
+size_t xsxml_match_iter_number_of_candidates(const Xsxml_Match_Iter *match_iter)
+{
+    return match_iter->number_of_remaining_candidates;
+}
 
-                    XML_TAG_RECENTLY_CLOSED = 1;
-                }
 
-                if (XML_ATTRIBUTE)
-                {
-                    node_level++;
-                    XML_TAG       = 0;
-                    XML_ATTRIBUTE = 0;
-                    continue;
-                }
+Xsxml_Match_Iter *xsxml_match_iter_share( const Xsxml_Match_Iter *match_iter, 
+                                          size_t share_index, 
+                                          size_t number_of_shares)
+{
+    Xsxml_Match_Iter *share_iter = (Xsxml_Match_Iter *) malloc(sizeof(Xsxml_Match_Iter));
 
-                XML_TAG       = 0;
-                XML_ATTRIBUTE = 0;
+    *share_iter = *match_iter;
 
-                if (XML_FORWARD_SLASH_START)
-                {
-                    node_level--;
-                    XML_FORWARD_SLASH_START = 0;
-                    reset_word(&word, &word_len);
+    share_iter->is_share = 1;
 
-                    XML_TAG_RECENTLY_CLOSED = 1;
+    /* The candidates are split as evenly as possible, where the first */
+    /* shares are given the one (1) extra candidate, if any.           */
+    const size_t NUMBER_OF_CANDIDATES = match_iter->number_of_remaining_candidates;
 
-                    continue;
-                }
+    const size_t SHARE_SIZE      = NUMBER_OF_CANDIDATES / number_of_shares;
+    const size_t NUMBER_OF_EXTRA = NUMBER_OF_CANDIDATES % number_of_shares;
 
-                /* Working on tag. */
+    const size_t SHARE_START = share_index * SHARE_SIZE 
+                             + ((share_index < NUMBER_OF_EXTRA) ? share_index : NUMBER_OF_EXTRA);
 
-                word [word_len] = 0;
+    share_iter->next_candidate = match_iter->next_candidate + SHARE_START * match_iter->step;
 
-                if (access_mode == XSXML_RAM_MODE)
-                {
-                    if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
-                                                        XSXML_TAG, 
-                                                        node_level, 
-                                                        word))
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    share_iter->number_of_remaining_candidates = SHARE_SIZE + (share_index < NUMBER_OF_EXTRA);
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "There cannot be more than one outermost tag.");
+    /* The lazily parsed contents of the share are decoded beforehand, so */
+    /* that the nodes are only ever read by the search thereafter.        */
+    Xsxml *xsxml_object = share_iter->xsxml_object;
 
-                        return result_obj;
-                    }
-                }
-                else /* if (access_mode == XSXML_FILE_MODE) */
-                {
-                    if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
-                                                         XSXML_TAG, 
-                                                         node_level, 
-                                                         word))
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    if ((xsxml_object != NULL) && (share_iter->content.string != NULL) && (xsxml_object->columns == NULL))
+    {
+        size_t k = share_iter->next_candidate;
+
+        for (size_t n = 0; n < share_iter->number_of_remaining_candidates; n++)
+        {
+            const size_t i = (share_iter->candidate == NULL) ? k : share_iter->candidate[k];
+
+            materialise_contents(xsxml_object, xsxml_object->node[i]);
+
+            k += share_iter->step;
+        }
+    }
+
+    return share_iter;
+}
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "There cannot be more than one outermost tag.");
 
-                        return result_obj;
-                    }
-                }
+void xsxml_match_iter_unset(Xsxml_Match_Iter **match_iter)
+{
+    if (*match_iter == NULL) return;
 
-                /* The below code is just a test code for debugging purposes.     */
-                /* printf("\n\n%*sTAG = %s", node_level * INDENTATION, "", word); */
+    finish_match_iter(*match_iter);
 
-                reset_word(&word, &word_len);
+    free(*match_iter);
 
-                if (!XML_FORWARD_SLASH_END) /* && (!XML_FORWARD_SLASH_START) */
-                {
-                    node_level++;
-                }
+    *match_iter = NULL;
+}
 
-                continue;
-            }
 
+/*
+Gathers the matches of the iterator, up to the given limit, in the form 
+returned by the occurrence functions. The array grows geometrically, in 
+batches, rather than once per match, and is trimmed to size at the end.
+*/
+static size_t *collect_matches( Xsxml_Match_Iter *match_iter, 
+                                size_t max_results)
+{
+    /* The exact number of matches is known if all the candidates are. */
+    size_t capacity = match_iter->candidates_all_match 
+                    ? match_iter->number_of_remaining_candidates 
+                    : 16;
 
-/* ########################################################################## */
-/*                                 XML ATTRIBUTE                              */
-/* ########################################################################## */
-            if (XML_ATTRIBUTE)
-            {
-                if (file_data_character == ' ') continue;
+    if (capacity > max_results) capacity = max_results;
 
-                if (XML_FORWARD_SLASH_START)
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    /* The plus one (+1) is for the number of matches in front. */
+    size_t *return_node_indices = (size_t *) malloc((capacity + 1) * sizeof(size_t));
 
-                    sprintf( &result_obj->result_message[0], 
-                             "End tags cannot have any attributes.");
+    return_node_indices[0] = 0;
 
-                    return result_obj;
-                }
+    while (return_node_indices[0] < max_results)
+    {
+        if (return_node_indices[0] == capacity)
+        {
+            capacity = 2 * capacity + 16;
 
-                if (file_data_character == '=')
-                {
-                    if (!XML_ATTRIBUTE_NAME)
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+            if (capacity > max_results) capacity = max_results;
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "Attribute names cannot be empty "
-                                 "(i.e. contain a lone equal-to sign (=).");
+            return_node_indices = 
+            (size_t *) realloc(return_node_indices, (capacity + 1) * sizeof(size_t));
+        }
 
-                        return result_obj;
-                    }
+        const size_t NUMBER_WANTED = capacity - return_node_indices[0];
 
-                    /* Working on attribute name. */
+        const size_t NUMBER_FOUND = 
+            xsxml_match_iter_next_batch( match_iter, 
+                                         &return_node_indices[return_node_indices[0] + 1], 
+                                         NUMBER_WANTED);
 
-                    word [word_len] = 0;
+        return_node_indices[0] += NUMBER_FOUND;
 
-                    if (access_mode == XSXML_RAM_MODE)
-                    {
-                        if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
-                                                            XSXML_ATTRIBUTE_NAME, 
-                                                            node_level, 
-                                                            word))
-                        {
-                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        /* The search stops once the candidates have run out. */
+        if (NUMBER_FOUND < NUMBER_WANTED) break;
+    }
 
-                            sprintf( &result_obj->result_message[0], 
-                                     "Within a given tag, attributes "
-                                     "cannot share the same name.");
+    if (return_node_indices[0] < capacity)
+    {
+        return_node_indices = 
+        (size_t *) realloc( return_node_indices, 
+                            (return_node_indices[0] + 1) * sizeof(size_t));
+    }
 
-                            return result_obj;
-                        }
-                    }
-                    else /* if (access_mode == XSXML_FILE_MODE) */
-                    {
-                        if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
-                                                             XSXML_ATTRIBUTE_NAME, 
-                                                             node_level, 
-                                                             word))
-                        {
-                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    return return_node_indices;
+}
 
-                            sprintf( &result_obj->result_message[0], 
-                                     "Within a given tag, attributes "
-                                     "cannot share the same name.");
 
-                            return result_obj;
-                        }
-                    }
+size_t *xsxml_occurrence( Xsxml *xsxml_object, 
+                          char *tag_name, 
+                          char *attribute_name, 
+                          char *attribute_value, 
+                          char *content, 
+                          Xsxml_Direction direction)
+{
+    return xsxml_occurrence_with_limit( xsxml_object, 
+                                        tag_name, 
+                                        attribute_name, 
+                                        attribute_value, 
+                                        content, 
+                                        direction, 
+                                        XSXML_NO_LIMIT);
+}
 
-                    /* The below code is just a test code for debugging purposes.              */
-                    /* printf("\n%*sATTRIBUTE NAME = %s", node_level * INDENTATION, "", word); */
 
-                    reset_word(&word, &word_len);
+size_t xsxml_first_occurrence( Xsxml *xsxml_object, 
+                               char *tag_name, 
+                               char *attribute_name, 
+                               char *attribute_value, 
+                               char *content)
+{
+    size_t *node_indices = xsxml_occurrence_with_limit( xsxml_object, 
+                                                        tag_name, 
+                                                        attribute_name, 
+                                                        attribute_value, 
+                                                        content, 
+                                                        XSXML_DIRECTION_FORWARD, 
+                                                        1);
 
-                    if (file_data_character == '=') XML_EQUAL = 1;
+    const size_t NODE_INDEX = (node_indices[0] > 0) ? node_indices[1] : XSXML_NO_NODE;
 
-                    continue;
-                }
+    free(node_indices);
 
-                if (XML_EQUAL)
-                {
-                    if (file_data_character == '\'')
-                    {
-                        XML_AMPERSAND       = 0;
-                        XML_DOUBLE_QUOTE    = 0;
-                        XML_SINGLE_QUOTE    = 1;
-                        XML_ATTRIBUTE_VALUE = 1;
-                        continue;
-                    }
-                    else if (file_data_character == '\"')
-                    {
-                        XML_AMPERSAND       = 0;
-                        XML_SINGLE_QUOTE    = 0;
-                        XML_DOUBLE_QUOTE    = 1;
-                        XML_ATTRIBUTE_VALUE = 1;
-                        continue;
-                    }
-                    else
-                    {
-                        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    return NODE_INDEX;
+}
 
-                        sprintf( &result_obj->result_message[0], 
-                                 "Attribute assignment (=) must be followed "
-                                 "either by a single quote (') "
-                                 "or a double quote (\").");
 
-                        return result_obj;
-                    }
-                }
+size_t xsxml_last_occurrence( Xsxml *xsxml_object, 
+                              char *tag_name, 
+                              char *attribute_name, 
+                              char *attribute_value, 
+                              char *content)
+{
+    size_t *node_indices = xsxml_occurrence_with_limit( xsxml_object, 
+                                                        tag_name, 
+                                                        attribute_name, 
+                                                        attribute_value, 
+                                                        content, 
+                                                        XSXML_DIRECTION_BACKWARD, 
+                                                        1);
 
-                if (file_data_character != '/')
-                {
-                    if (!XML_ATTRIBUTE_NAME)
-                    {
-                        if (!isalpha(file_data_character) && file_data_character != '_')
-                        {
-                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    const size_t NODE_INDEX = (node_indices[0] > 0) ? node_indices[1] : XSXML_NO_NODE;
 
-                            sprintf( &result_obj->result_message[0], 
-                                     "Attribute names must start with an "
-                                     "alphabetical character [a-zA-Z] or "
-                                     "underscore (_)");
+    free(node_indices);
 
-                            return result_obj;
-                        }
+    return NODE_INDEX;
+}
 
-                        XML_ATTRIBUTE_NAME = 1;
-                    }
 
-                    append_character_to_word(&word, file_data_character, &word_len);
+size_t *xsxml_occurrence_with_limit( Xsxml *xsxml_object, 
+                                     char *tag_name, 
+                                     char *attribute_name, 
+                                     char *attribute_value, 
+                                     char *content, 
+                                     Xsxml_Direction direction, 
+                                     size_t max_results)
+{
+    /* The criteria are matched in their default match modes. */
+    const Xsxml_Occurrence_Query QUERY = { .tag_name        = tag_name, 
+                                           .attribute_name  = attribute_name, 
+                                           .attribute_value = attribute_value, 
+                                           .content         = content, 
+                                           .direction       = direction };
 
-                    continue;
-                }
-            }
+    Xsxml_Match_Iter match_iter;
 
+    start_match_iter(&match_iter, xsxml_object, &QUERY);
 
-/* ########################################################################## */
-/*                             XML TAG ... CONT'D                             */
-/* ########################################################################## */
-            if (file_data_character == '/')
-            {
-                if (XML_FORWARD_SLASH_START)
-                {
-                    result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    size_t *return_node_indices = collect_matches(&match_iter, max_results);
 
-                    sprintf( &result_obj->result_message[0], 
-                             "A tag cannot have more than one forward slash.");
+    finish_match_iter(&match_iter);
 
-                    return result_obj;
-                }
+    return return_node_indices;
+}
 
-                XML_FORWARD_SLASH_END = 1;
 
-                continue;
-            }
+size_t *xsxml_descendant_occurrence( Xsxml *xsxml_object, 
+                                     size_t node_index, 
+                                     char *tag_name, 
+                                     char *attribute_name, 
+                                     char *attribute_value, 
+                                     char *content, 
+                                     Xsxml_Direction direction)
+{
+    xsxml_renumber_nodes(xsxml_object);
 
-            if (file_data_character == ' ')
-            {
-                if (word_len != 0)
-                {
-                    /* Working on tag. */
+    if (node_index >= xsxml_object->number_of_nodes)
+    {
+        size_t *return_node_indices = (size_t *) malloc(sizeof(size_t));
 
-                    word [word_len] = 0;
+        return_node_indices[0] = 0;
 
-                    if (access_mode == XSXML_RAM_MODE)
-                    {
-                        if (!parse_sub_operation_ram_mode( (Xsxml **) object, 
-                                                            XSXML_TAG, 
-                                                            node_level, 
-                                                            word))
-                        {
-                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        xsxml_object->result = XSXML_RESULT_XML_FAILURE;
 
-                            sprintf( &result_obj->result_message[0], 
-                                     "There cannot be more than one outermost tag.");
+        sprintf( &xsxml_object->result_message[0], 
+                 "The node index %zu is out of range.", 
+                 node_index);
 
-                            return result_obj;
-                        }
-                    }
-                    else /* if (access_mode == XSXML_FILE_MODE) */
-                    {
-                        if (!parse_sub_operation_file_mode( (Xsxml_Files **) object, 
-                                                             XSXML_TAG, 
-                                                             node_level, 
-                                                             word))
-                        {
-                            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+        return return_node_indices;
+    }
 
-                            sprintf( &result_obj->result_message[0], 
-                                     "There cannot be more than one outermost tag.");
+    /* The criteria are matched in their default match modes. */
+    const Xsxml_Occurrence_Query QUERY = { .tag_name        = tag_name, 
+                                           .attribute_name  = attribute_name, 
+                                           .attribute_value = attribute_value, 
+                                           .content         = content, 
+                                           .direction       = direction };
 
-                            return result_obj;
-                        }
-                    }
+    Xsxml_Match_Iter match_iter;
 
-                    /* The below code is just a test code for debugging purposes.     */
-                    /* printf("\n\n%*sTAG = %s", node_level * INDENTATION, "", word); */
+    start_match_iter(&match_iter, xsxml_object, &QUERY);
 
-                    reset_word(&word, &word_len);
+    /* The descendants of a node follow it, up to the end of its subtree. */
+    scope_match_iter( &match_iter, 
+                      node_index + 1, 
+                      xsxml_object->node[node_index]->subtree_end, 
+                      direction);
 
-                    XML_ATTRIBUTE      = 1;
-                    XML_ATTRIBUTE_NAME = 0;
-                }
+    size_t *return_node_indices = collect_matches(&match_iter, XSXML_NO_LIMIT);
 
-                continue;
-            }
+    finish_match_iter(&match_iter);
 
-            if (file_data_character == '=')
-            {
-                if (XML_ATTRIBUTE_VALUE)
-                {
-                    append_character_to_word(&word, file_data_character, &word_len);
-                }
+    return return_node_indices;
+}
 
-                if (XML_ATTRIBUTE)
-                {
-                    XML_ATTRIBUTE_VALUE = 1;
-                }
 
-                continue;
-            }
+size_t *xsxml_occurrence_query( Xsxml *xsxml_object, 
+                                const Xsxml_Occurrence_Query *query)
+{
+    Xsxml_Match_Iter match_iter;
 
-            if (!isalnum(file_data_character) && (file_data_character != '-') 
-            && (file_data_character != '_')    && (file_data_character != '.'))
-            {
-                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    const int IS_VALID = start_match_iter(&match_iter, xsxml_object, query);
 
-                sprintf( &result_obj->result_message[0], 
-                         "Tag names may contain letters [a-zA-z], "
-                         "digits [0-9], hyphens (-), underscores (_), "
-                         "and periods (.) only.");
+    size_t *return_node_indices = collect_matches(&match_iter, XSXML_NO_LIMIT);
 
-                return result_obj;
-            }
+    finish_match_iter(&match_iter);
 
-            append_character_to_word(&word, file_data_character, &word_len);
+    if (IS_VALID)
+    {
+        xsxml_object->result = XSXML_RESULT_SUCCESS;
 
-            continue;
-        }
+        sprintf( &xsxml_object->result_message[0], 
+                 "The search has been successfully completed, with %zu matches.", 
+                 return_node_indices[0]);
+    }
+
+    return return_node_indices;
+}
 
 
-/* ########################################################################## */
-/*                                  XML PCDATA                                */
-/* ########################################################################## */
-        if ((file_data_character ==  ' ') || (file_data_character == '\r') 
-        ||  (file_data_character == '\n') || (file_data_character == '\t') 
-        ||  (file_data_character == '\v') || (file_data_character == '\f'))
+void xsxml_occurrence_batch( Xsxml *xsxml_object, 
+                             const Xsxml_Occurrence_Query *queries, 
+                             size_t number_of_queries, 
+                             size_t **results)
+{
+    if (number_of_queries == 0) return;
+
+    Xsxml_Match_Iter *match_iter = 
+    (Xsxml_Match_Iter *) malloc(number_of_queries * sizeof(Xsxml_Match_Iter));
+
+    /* The queries that are left for the single pass over the nodes, */
+    /* along with the capacities of their results.                   */
+    size_t *scan_query = (size_t *) malloc(number_of_queries * sizeof(size_t));
+    size_t *capacity   = (size_t *) malloc(number_of_queries * sizeof(size_t));
+
+    size_t number_of_scan_queries = 0;
+
+    for (size_t q = 0; q < number_of_queries; q++)
+    {
+        start_match_iter(&match_iter[q], xsxml_object, &queries[q]);
+
+        /* The queries that are narrowed down by an index, or that cannot */
+        /* have any match, are searched by themselves.                     */
+        if ((match_iter[q].candidate != NULL) 
+        ||  (match_iter[q].number_of_remaining_candidates == 0))
+        {
+            results[q] = collect_matches(&match_iter[q], XSXML_NO_LIMIT);
+        }
+        else
         {
-            if (XML_AMPERSAND)
-            {
-                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+            scan_query[number_of_scan_queries++] = q;
 
-                sprintf( &result_obj->result_message[0], 
-                         "A tag's PCDATA may contain the ampersand (&) "
-                         "characters only as character entity references.");
+            capacity[q] = 16;
 
-                return result_obj;
-            }
+            /* The plus one (+1) is for the number of matches in front. */
+            results[q] = (size_t *) malloc((capacity[q] + 1) * sizeof(size_t));
 
-            if (!XML_PCDATA_CONTENT) continue;
+            results[q][0] = 0;
+        }
+    }
 
-            if (!XML_WHITESPACE)
+    /* The nodes are passed over in document order, and the results of */
+    /* the backward queries are reversed afterwards.                   */
+    for (size_t i = 0; (i < xsxml_object->number_of_nodes) && (number_of_scan_queries > 0); i++)
+    {
+        for (size_t s = 0; s < number_of_scan_queries; s++)
+        {
+            const size_t q = scan_query[s];
+
+            if (!node_matches(&match_iter[q], i)) continue;
+
+            if (results[q][0] == capacity[q])
             {
-                XML_WHITESPACE = 1;
-                append_character_to_word(&word, ' ', &word_len);
+                capacity[q] = 2 * capacity[q] + 16;
+
+                results[q] = 
+                (size_t *) realloc(results[q], (capacity[q] + 1) * sizeof(size_t));
             }
-            continue;
+
+            results[q][++results[q][0]] = i;
         }
+    }
 
-        XML_WHITESPACE = 0;
+    for (size_t s = 0; s < number_of_scan_queries; s++)
+    {
+        const size_t q = scan_query[s];
 
-        if (file_data_character == '<')
+        const size_t NUMBER_OF_MATCHES = results[q][0];
+
+        if (queries[q].direction == XSXML_DIRECTION_BACKWARD)
         {
-            if (XML_AMPERSAND)
+            for (size_t k = 1; k <= NUMBER_OF_MATCHES / 2; k++)
             {
-                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+                const size_t NODE_INDEX = results[q][k];
 
-                sprintf( &result_obj->result_message[0], 
-                         "1A tag's PCDATA may contain the ampersand (&) "
-                         "characters only as character entity references.");
+                results[q][k] = results[q][NUMBER_OF_MATCHES + 1 - k];
 
-                return result_obj;
+                results[q][NUMBER_OF_MATCHES + 1 - k] = NODE_INDEX;
             }
+        }
 
-            XML_TAG                 = 1;
-            XML_AMPERSAND           = 0;
-            XML_FORWARD_SLASH_START = 0;
-            XML_FORWARD_SLASH_END   = 0;
+        results[q] = 
+        (size_t *) realloc(results[q], (NUMBER_OF_MATCHES + 1) * sizeof(size_t));
+    }
 
-            continue;
-        }
+    for (size_t q = 0; q < number_of_queries; q++) finish_match_iter(&match_iter[q]);
 
-        if (file_data_character == '&')
-        {
-            if (!XML_AMPERSAND)
-            {
-                cer_i = 0;
+    free(match_iter);
+    free(scan_query);
+    free(capacity);
+}
 
-                memset( &character_entry_reference[0], 
-                        0, 
-                        CHARACTER_ENTRY_REFERENCE_MAX_LENGTH);
 
-                character_entry_reference[0] = '&';
+/* An absent string is copied as NULL. */
+static char *copy_optional_string(const char *string)
+{
+    if (string == NULL) return NULL;
 
-                XML_AMPERSAND = 1;
+    const size_t STRING_LEN = strlen(string);
 
-                continue;
-            }
-        }
+    /* The plus one (+1) is for the null terminator. */
+    char *string_copy = (char *) malloc(STRING_LEN + 1);
 
-        if (file_data_character == ';')
-        {
-            if (parse_cer(&character_entry_reference))
-            {
-                append_character_to_word( &word, 
-                                          character_entry_reference[0], 
-                                          &word_len);
-            }
-            else
-            {
-                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    memcpy(string_copy, string, STRING_LEN + 1);
 
-                sprintf( &result_obj->result_message[0], 
-                         "A tag's PCDATA may contain the ampersand (&) "
-                         "characters only as character entity references.");
+    return string_copy;
+}
 
-                return result_obj;
-            }
 
-            XML_AMPERSAND = 0;
-            continue;
-        }
+Xsxml_Prepared_Occurrence *xsxml_prepare_occurrence( const char *tag_name, 
+                                                     const char *attribute_name, 
+                                                     const char *attribute_value, 
+                                                     const char *content, 
+                                                     Xsxml_Direction direction)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml_Prepared_Occurrence *prepared = 
+    (Xsxml_Prepared_Occurrence *) calloc(1, sizeof(Xsxml_Prepared_Occurrence));
 
-        if (XML_AMPERSAND)
-        {
-            if (cer_i == (CHARACTER_ENTRY_REFERENCE_MAX_LENGTH - 1))
-            {
-                const char *MESSAGE_PART_1 = "A tag's PCDATA may contain the "
-                                             "ampersand (&) characters only as "
-                                             "character entity references.";
+    prepared->query.tag_name        = copy_optional_string(tag_name);
+    prepared->query.attribute_name  = copy_optional_string(attribute_name);
+    prepared->query.attribute_value = copy_optional_string(attribute_value);
+    prepared->query.content         = copy_optional_string(content);
+    prepared->query.direction       = direction;
 
-                const char *MESSAGE_PART_2 = "Character entry references "
-                                             "may contain atmost ";
+    return prepared;
+}
 
-                const char *MESSAGE_PART_3 = " number of characters.";
 
-                result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+const size_t *xsxml_prepared_occurrence_run( Xsxml_Prepared_Occurrence *prepared, 
+                                             Xsxml *xsxml_object)
+{
+    const size_t GENERATION = xsxml_generation(xsxml_object);
 
-                sprintf( &result_obj->result_message[0], 
-                         "%s%s%d%s", 
-                         MESSAGE_PART_1, 
-                         MESSAGE_PART_2, 
-                         CHARACTER_ENTRY_REFERENCE_MAX_LENGTH, 
-                         MESSAGE_PART_3);
+    /* The cached results hold for as long as the object is left as it was. */
+    if ((prepared->result != NULL) 
+    &&  (prepared->xsxml_object == xsxml_object) 
+    &&  (prepared->generation   == GENERATION))
+    {
+        return prepared->result;
+    }
 
-                return result_obj;
-            }
+    free(prepared->result);
 
-            character_entry_reference [cer_i++] = file_data_character;
-            continue;
-        }
+    prepared->result = xsxml_occurrence_query(xsxml_object, &prepared->query);
 
-        if (node_level == 0)
-        {
-            result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+    prepared->xsxml_object = xsxml_object;
+    prepared->generation   = GENERATION;
 
-            sprintf( &result_obj->result_message[0], 
-                     "Parsed character data (PCDATA or text data) "
-                     "cannot be placed outside the outermost tag.");
+    return prepared->result;
+}
 
-            return result_obj;
-        }
 
+void xsxml_prepared_occurrence_unset(Xsxml_Prepared_Occurrence **prepared)
+{
+    if (*prepared == NULL) return;
 
-        XML_X                   = 0;    /* X */
-        XML_M                   = 0;    /* M */
-        XML_EQUAL               = 0;    /* = */
-        XML_HYPHEN              = 0;    /* - */
-        XML_QUESTION            = 0;    /* ? */
-        XML_AMPERSAND           = 0;    /* & */
-        XML_SINGLE_QUOTE        = 0;    /* - */
-        XML_DOUBLE_QUOTE        = 0;    /* - */
-        XML_FORWARD_SLASH_END   = 0;    /* / */
-        XML_FORWARD_SLASH_START = 0;    /* / */
-        XML_END_SQUARE_BRACKET  = 0;    /* ] */
+    free((*prepared)->query.tag_name);
+    free((*prepared)->query.attribute_name);
+    free((*prepared)->query.attribute_value);
+    free((*prepared)->query.content);
 
+    free((*prepared)->result);
 
-        XML_PCDATA_CONTENT = 1;
+    free(*prepared);
 
-        append_character_to_word(&word, file_data_character, &word_len);
-    }
+    *prepared = NULL;
+}
 
 
-/* ########################################################################## */
-/*                          XML TAGS COMPLETION CHECK                         */
-/* ########################################################################## */
-    if (node_level != 0)
-    {
-        result_obj->result_code = XSXML_RESULT_XML_FAILURE;
+size_t *xsxml_files_occurrence( Xsxml_Files *xsxml_files_object, 
+                                char *tag_name, 
+                                char *attribute_name, 
+                                char *attribute_value, 
+                                char *content, 
+                                Xsxml_Direction direction)
+{
+    return xsxml_files_occurrence_with_limit( xsxml_files_object, 
+                                              tag_name, 
+                                              attribute_name, 
+                                              attribute_value, 
+                                              content, 
+                                              direction, 
+                                              XSXML_NO_LIMIT);
+}
 
-        if (XML_CDATA_CONTENT)
-        {
-            sprintf( &result_obj->result_message[0], 
-                     "A CDATA entity does not terminate.");
-        }
-        else
-        {
-            sprintf( &result_obj->result_message[0], 
-                     "%d start tag elements do not have their end tag counterparts.", 
-                     node_level);
-        }
 
-        return result_obj;
-    }
+size_t xsxml_files_first_occurrence( Xsxml_Files *xsxml_files_object, 
+                                     char *tag_name, 
+                                     char *attribute_name, 
+                                     char *attribute_value, 
+                                     char *content)
+{
+    size_t *node_indices = xsxml_files_occurrence_with_limit( xsxml_files_object, 
+                                                              tag_name, 
+                                                              attribute_name, 
+                                                              attribute_value, 
+                                                              content, 
+                                                              XSXML_DIRECTION_FORWARD, 
+                                                              1);
 
-    result_obj->result_code = XSXML_RESULT_SUCCESS;
+    const size_t NODE_INDEX = (node_indices[0] > 0) ? node_indices[1] : XSXML_NO_NODE;
 
-    return result_obj;
+    free(node_indices);
+
+    return NODE_INDEX;
 }
 
 
-Xsxml *xsxml_parse(const char *input_file_path)
+size_t xsxml_files_last_occurrence( Xsxml_Files *xsxml_files_object, 
+                                    char *tag_name, 
+                                    char *attribute_name, 
+                                    char *attribute_value, 
+                                    char *content)
 {
-    Xsxml *xsxml_object = (Xsxml *) malloc(sizeof(Xsxml));
+    size_t *node_indices = xsxml_files_occurrence_with_limit( xsxml_files_object, 
+                                                              tag_name, 
+                                                              attribute_name, 
+                                                              attribute_value, 
+                                                              content, 
+                                                              XSXML_DIRECTION_BACKWARD, 
+                                                              1);
 
-    xsxml_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+    const size_t NODE_INDEX = (node_indices[0] > 0) ? node_indices[1] : XSXML_NO_NODE;
 
-    if ((input_file_path == NULL) || (strlen(input_file_path) == 0))
-    {
-        xsxml_object->result = XSXML_RESULT_FILE_FAILURE;
+    free(node_indices);
 
-        sprintf( &xsxml_object->result_message[0], 
-                 "The input file path cannot be empty or NULL.");
+    return NODE_INDEX;
+}
 
-        return xsxml_object;
-    }
 
-    FILE *file_pointer = fopen(input_file_path, "r");
+size_t *xsxml_files_occurrence_with_limit( Xsxml_Files *xsxml_files_object, 
+                                           char *tag_name, 
+                                           char *attribute_name, 
+                                           char *attribute_value, 
+                                           char *content, 
+                                           Xsxml_Direction direction, 
+                                           size_t max_results)
+{
+    /* The criteria are matched in their default match modes. */
+    const Xsxml_Occurrence_Query QUERY = { .tag_name        = tag_name, 
+                                           .attribute_name  = attribute_name, 
+                                           .attribute_value = attribute_value, 
+                                           .content         = content, 
+                                           .direction       = direction };
 
-    if (file_pointer == NULL)
-    {
-        xsxml_object->result = XSXML_RESULT_FILE_FAILURE;
+    Xsxml_Match_Iter match_iter;
 
-        sprintf( &xsxml_object->result_message[0], 
-                 "The file path '%s' does not exist.", 
-                 input_file_path);
+    start_files_match_iter(&match_iter, xsxml_files_object, &QUERY);
 
-        return xsxml_object;
-    }
+    /* No further files are read once the limit is reached. */
+    size_t *return_node_indices = collect_matches(&match_iter, max_results);
 
-    xsxml_object->number_of_nodes = 0;
+    finish_match_iter(&match_iter);
 
-    xsxml_object->node = (Xsxml_Nodes **) malloc(sizeof(Xsxml_Nodes *));
+    return return_node_indices;
+}
 
-    Xsxml_Private_Result *private_result = 
-    parse_operation((void **)&xsxml_object, XSXML_RAM_MODE, file_pointer);
 
-    fclose(file_pointer);
+size_t *xsxml_files_occurrence_query( Xsxml_Files *xsxml_files_object, 
+                                      const Xsxml_Occurrence_Query *query)
+{
+    Xsxml_Match_Iter match_iter;
 
-    xsxml_object->result = private_result->result_code;
+    const int IS_VALID = start_files_match_iter(&match_iter, xsxml_files_object, query);
 
-    if (private_result->result_code == XSXML_RESULT_SUCCESS)
-    {
-        sprintf( &xsxml_object->result_message[0], 
-                 "The file '%s' has been successfully parsed.", 
-                 input_file_path);
-    }
-    else
+    size_t *return_node_indices = collect_matches(&match_iter, XSXML_NO_LIMIT);
+
+    finish_match_iter(&match_iter);
+
+    if (IS_VALID)
     {
-        sprintf( &xsxml_object->result_message[0], 
-                 "%s", 
-                 private_result->result_message);
+        xsxml_files_object->result = XSXML_RESULT_SUCCESS;
+
+        sprintf( &xsxml_files_object->result_message[0], 
+                 "The search has been successfully completed, with %zu matches.", 
+                 return_node_indices[0]);
     }
 
-    free(private_result->result_message);
+    return return_node_indices;
+}
 
-    /*
-    For some unknown, odd reason, the following code produces the 
-    'Double free or corruption' error:
 
-    free(private_result);
-    */
+static int is_query_name_character(char character)
+{
+    return isalnum((unsigned char) character) 
+        || (character == '-') 
+        || (character == '_') 
+        || (character == '.');
+}
 
-    return xsxml_object;
+
+static size_t skip_query_spaces( const char *path, 
+                                 size_t p)
+{
+    while ((path[p] == ' ') || (path[p] == '\t')) p++;
+
+    return p;
 }
 
 
-Xsxml_Files *xsxml_files_parse( const char *input_file_path, 
-                                const char *temporary_directory_path)
+static Xsxml_Query *set_query_error( Xsxml_Query *xsxml_query, 
+                                     size_t p, 
+                                     const char *expected)
 {
-    Xsxml_Files *xsxml_files_object = (Xsxml_Files *) malloc(sizeof(Xsxml_Files));
+    xsxml_query->result = XSXML_RESULT_XML_FAILURE;
 
-    xsxml_files_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
+    snprintf( &xsxml_query->result_message[0], 
+              RESULT_MESSAGE_MAX_LENGTH, 
+              "Expected %s at position %zu of the path.", 
+              expected, 
+              p + 1);
 
-    if ((input_file_path == NULL) || (strlen(input_file_path) == 0))
-    {
-        xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+    return xsxml_query;
+}
 
-        sprintf( &xsxml_files_object->result_message[0], 
-                 "The input file path cannot be empty or NULL.");
 
-        return xsxml_files_object;
-    }
+Xsxml_Query *xsxml_query_compile(const char *path)
+{
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml_Query *xsxml_query = (Xsxml_Query *) calloc(1, sizeof(Xsxml_Query));
 
-    FILE *file_pointer = fopen(input_file_path, "r");
+    xsxml_query->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
 
-    if (file_pointer == NULL)
+    if ((path == NULL) || (path[0] == 0))
     {
-        xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+        xsxml_query->result = XSXML_RESULT_XML_FAILURE;
 
-        sprintf( &xsxml_files_object->result_message[0], 
-                 "The file path '%s' does not exist.", 
-                 input_file_path);
+        sprintf( &xsxml_query->result_message[0], 
+                 "The path cannot be empty or NULL.");
 
-        return xsxml_files_object;
+        return xsxml_query;
     }
 
+    const size_t PATH_LEN = strlen(path);
 
-    /* The plus one (+1) is for the char array's null terminator. */
-    xsxml_files_object->node_file_name = (char *) malloc(NODE_FILE_NAME_SIZE + 1);
+    /* The plus one (+1) is for the null terminator. */
+    xsxml_query->path = (char *) malloc(PATH_LEN + 1);
 
-    xsxml_files_object->node_file_name [NODE_FILE_NAME_SIZE] = 0;
+    memcpy(xsxml_query->path, path, PATH_LEN + 1);
 
-    srand(time(NULL));
+    /* Every step starts with a slash, and every predicate with a bracket, */
+    /* and so their numbers are at most those of the slashes and brackets. */
+    size_t max_steps      = 0;
+    size_t max_predicates = 0;
 
-    for (int i = 0; i < NODE_FILE_NAME_SIZE; i++)
+    for (size_t p = 0; p < PATH_LEN; p++)
     {
-        xsxml_files_object->node_file_name [i] = 
-
-            (rand() % NUMBER_OF_ALPHABETIC_CHARACTERS) 
-          + LOWER_CASE_LETTER_A_ASCII_VALUE;
+        if (path[p] == '/') max_steps++;
+        if (path[p] == '[') max_predicates++;
     }
 
-    if ((temporary_directory_path != NULL) && (temporary_directory_path[0] != 0))
-    {
-        const int TEMPORARY_DIRECTORY_PATH_LEN = strlen(temporary_directory_path);
+    /* The plus one (+1) prevents zero-sized allocations. */
+    xsxml_query->step = 
+    (Xsxml_Query_Step *) malloc((max_steps + 1) * sizeof(Xsxml_Query_Step));
 
-        /* The plus one (+1) is for the char array's null terminator, */
-        /* plus an additional forward slash (/), if required.         */
-        xsxml_files_object->node_directory_path = (char *) malloc(TEMPORARY_DIRECTORY_PATH_LEN + 1);
+    xsxml_query->predicate = 
+    (Xsxml_Query_Predicate *) malloc((max_predicates + 1) * sizeof(Xsxml_Query_Predicate));
 
-        memcpy( &xsxml_files_object->node_directory_path[0], 
-                &temporary_directory_path[0], 
-                TEMPORARY_DIRECTORY_PATH_LEN);
+    const char *PATH = xsxml_query->path;
 
-        if (xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN - 1]
-        != '/')
-        {
-            xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN]
-            = '/';
+    size_t p = 0;
 
-            xsxml_files_object->node_directory_path [TEMPORARY_DIRECTORY_PATH_LEN + 1]
-            = 0;
-        }
-        else
+    if (PATH[p] != '/') return set_query_error(xsxml_query, p, "a slash (/)");
+
+    while (PATH[p] != 0)
+    {
+        if (PATH[p] != '/')
         {
-            xsxml_files_object->node_directory_path[TEMPORARY_DIRECTORY_PATH_LEN]
-            = 0;
+            return set_query_error(xsxml_query, p, "a slash (/), a predicate ([), or the end");
         }
 
-        FILE *dummy_pointer = open_char_file( xsxml_files_object->node_directory_path, 
-                                              xsxml_files_object->node_file_name, 
-                                              "w");
+        Xsxml_Query_Step *step = &xsxml_query->step[xsxml_query->number_of_steps++];
 
-        if (dummy_pointer == NULL)
-        {
-            xsxml_files_object->result = XSXML_RESULT_FILE_FAILURE;
+        step->axis = XSXML_QUERY_AXIS_CHILD;
 
-            sprintf( &xsxml_files_object->result_message[0], 
-                     "The temporary directory path '%s' does not exist.", 
-                     temporary_directory_path);
+        p++;
 
-            return xsxml_files_object;
+        if (PATH[p] == '/')
+        {
+            step->axis = XSXML_QUERY_AXIS_DESCENDANT;
+
+            p++;
         }
 
-        fclose(dummy_pointer);
+        /* Working on tag name. */
 
-        delete_char_file( xsxml_files_object->node_directory_path, 
-                          xsxml_files_object->node_file_name);
-    }
-    else /* if (temporary_directory_path == NULL) */
-    {
-        char *file_path_split = strrchr(input_file_path, '/');
+        const size_t NAME_START = p;
 
-        if (file_path_split == NULL)
+        if (PATH[p] == '*')
         {
-            xsxml_files_object->node_directory_path = (char *) malloc(1);
+            step->tag_name        = NULL;
+            step->tag_name_length = 0;
 
-            xsxml_files_object->node_directory_path[0] = 0;
+            p++;
         }
-        else
+        else /* if (PATH[p] != '*') */
         {
-            /* The plus one (+1) is for the char array's null terminator. */
-            xsxml_files_object->node_directory_path = (char *) malloc(strlen(input_file_path));
+            while (is_query_name_character(PATH[p])) p++;
 
-            memcpy( &xsxml_files_object->node_directory_path[0], 
-                    &input_file_path[0], 
-                    file_path_split - input_file_path);
+            if (p == NAME_START) return set_query_error(xsxml_query, p, "a tag name or an asterisk (*)");
+
+            step->tag_name        = &PATH[NAME_START];
+            step->tag_name_length = p - NAME_START;
         }
-    }
 
-    xsxml_files_object->number_of_nodes = 0;
+        step->predicate_start           = xsxml_query->number_of_predicates;
+        step->number_of_predicates      = 0;
+        step->has_positional_predicates = 0;
 
-    Xsxml_Private_Result *private_result = 
-    parse_operation((void **)&xsxml_files_object, XSXML_FILE_MODE, file_pointer);
+        /* Working on predicates. */
 
-    fclose(file_pointer);
+        while (PATH[p] == '[')
+        {
+            Xsxml_Query_Predicate *predicate = 
+                &xsxml_query->predicate[xsxml_query->number_of_predicates++];
 
-    xsxml_files_object->result = private_result->result_code;
+            step->number_of_predicates++;
 
-    if (private_result->result_code == XSXML_RESULT_SUCCESS)
-    {
-        sprintf( &xsxml_files_object->result_message[0], 
-                 "The file '%s' has been successfully parsed.", 
-                 input_file_path);
-    }
-    else
-    {
-        sprintf( &xsxml_files_object->result_message[0], 
-                 "%s", 
-                 private_result->result_message);
-    }
+            p = skip_query_spaces(PATH, p + 1);
 
-    free(private_result->result_message);
+            if (PATH[p] == '@')
+            {
+                predicate->kind = XSXML_QUERY_PREDICATE_ATTRIBUTE;
 
-    /*
-    For some unknown, odd reason, the following code produces the 
-    'Double free or corruption' error:
+                const size_t ATTRIBUTE_NAME_START = ++p;
 
-    free(private_result);
-    */
+                while (is_query_name_character(PATH[p])) p++;
 
-    return xsxml_files_object;
-}
+                if (p == ATTRIBUTE_NAME_START) return set_query_error(xsxml_query, p, "an attribute name");
 
+                predicate->attribute_name         = &PATH[ATTRIBUTE_NAME_START];
+                predicate->attribute_name_length  = p - ATTRIBUTE_NAME_START;
+                predicate->attribute_value        = NULL;
+                predicate->attribute_value_length = 0;
 
-char *xsxml_files_property( Xsxml_Files *xsxml_files_object, 
-                            size_t node_index, 
-                            Xsxml_Property property_name, 
-                            size_t property_index)
-{
-    Xsxml_Char_File_IO io_obj;
+                p = skip_query_spaces(PATH, p);
 
-    io_obj.temporary_dir_path  = xsxml_files_object->node_directory_path;
-    io_obj.temporary_file_name = xsxml_files_object->node_file_name;
-    io_obj.node_i_value        = node_index;
-    io_obj.property_term       = (char *) PROPERTY_NAMES_LIST [property_name];
-    io_obj.node_j_value        = property_index;
-    io_obj.data_str            = NULL;
+                if (PATH[p] == '=')
+                {
+                    p = skip_query_spaces(PATH, p + 1);
 
-    read_from_char_file(&io_obj);
+                    const char QUOTE = PATH[p];
 
-    return io_obj.data_str;
-}
+                    if ((QUOTE != '\'') && (QUOTE != '"'))
+                    {
+                        return set_query_error(xsxml_query, p, "a quoted attribute value");
+                    }
 
+                    const size_t ATTRIBUTE_VALUE_START = ++p;
 
-size_t *xsxml_occurrence( Xsxml *xsxml_object, 
-                          char *tag_name, 
-                          char *attribute_name, 
-                          char *attribute_value, 
-                          char *content, 
-                          Xsxml_Direction direction)
-{
-    size_t *return_node_indices = (size_t *) malloc(sizeof(size_t));
+                    while ((PATH[p] != 0) && (PATH[p] != QUOTE)) p++;
 
-    return_node_indices[0] = 0;
+                    if (PATH[p] == 0) return set_query_error(xsxml_query, p, "a closing quote");
 
-    if ((tag_name == NULL) && (attribute_name  == NULL) 
-    &&  (content  == NULL) && (attribute_value == NULL))
-    {
-        return return_node_indices;
-    }
+                    predicate->attribute_value        = &PATH[ATTRIBUTE_VALUE_START];
+                    predicate->attribute_value_length = p - ATTRIBUTE_VALUE_START;
 
-    size_t i_start;
-    size_t i_negatory_end_condition;
+                    p = skip_query_spaces(PATH, p + 1);
+                }
+            }
+            else if (isdigit((unsigned char) PATH[p]))
+            {
+                predicate->kind     = XSXML_QUERY_PREDICATE_POSITION;
+                predicate->position = 0;
 
-    if (direction == XSXML_DIRECTION_FORWARD)
-    {
-        i_start = 0;
-        i_negatory_end_condition = xsxml_object->number_of_nodes;
-    }
-    else /* if (direction == XSXML_DIRECTION_BACKWARD) */
-    {
-        i_start = xsxml_object->number_of_nodes - 1;
-        i_negatory_end_condition = (unsigned int)-1;
-        direction = -1;
-    }
+                while (isdigit((unsigned char) PATH[p]))
+                {
+                    const size_t DIGIT = PATH[p] - '0';
 
-    for (unsigned int i = i_start; i != i_negatory_end_condition; i += direction)
-    {
-        int node_i_is_true = 0;
+                    if (predicate->position > (XSXML_NO_NODE - DIGIT) / 10)
+                    {
+                        return set_query_error(xsxml_query, p, "a smaller position");
+                    }
 
-        if (tag_name != NULL)
-        {
-            if (strcmp(xsxml_object->node[i]->node_name, tag_name) == 0)
-                node_i_is_true = 1;
-            else
-                continue;
-        }
+                    predicate->position = 10 * predicate->position + DIGIT;
 
-        for (unsigned j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
-        {
-            if (attribute_name != NULL)
-            {
-                if (strcmp(xsxml_object->node[i]->attribute_name[j], attribute_name) == 0)
-                {
-                    node_i_is_true = 1;
+                    p++;
                 }
-                else
+
+                if (predicate->position == 0)
                 {
-                    node_i_is_true = 0;
-                    continue;
+                    return set_query_error(xsxml_query, p - 1, "a position of one (1) or more");
                 }
+
+                step->has_positional_predicates = 1;
+
+                p = skip_query_spaces(PATH, p);
             }
+            else if (strncmp(&PATH[p], "last()", 6) == 0)
+            {
+                predicate->kind = XSXML_QUERY_PREDICATE_LAST;
+
+                step->has_positional_predicates = 1;
 
-            if (attribute_value != NULL)
+                p = skip_query_spaces(PATH, p + 6);
+            }
+            else
             {
-                if (strcmp(xsxml_object->node[i]->attribute_value[j], attribute_value) == 0)
-                {
-                    node_i_is_true = 1;
-                }
-                else
-                {
-                    node_i_is_true = 0;
-                    continue;
-                }
+                return set_query_error(xsxml_query, p, "an attribute (@), a position, or last()");
             }
 
-            if (node_i_is_true) break;
+            if (PATH[p] != ']') return set_query_error(xsxml_query, p, "a closing bracket (])");
+
+            p++;
         }
+    }
+
+    xsxml_query->result = XSXML_RESULT_SUCCESS;
+
+    sprintf( &xsxml_query->result_message[0], 
+             "The path of %zu steps has been successfully compiled.", 
+             xsxml_query->number_of_steps);
+
+    return xsxml_query;
+}
+
+
+void xsxml_query_unset(Xsxml_Query **xsxml_query)
+{
+    if (*xsxml_query != NULL)
+    {
+        free((*xsxml_query)->result_message);
+        free((*xsxml_query)->path);
+        free((*xsxml_query)->step);
+        free((*xsxml_query)->predicate);
+
+        free(*xsxml_query);
+
+        *xsxml_query = NULL;
+    }
+}
+
+
+static int query_step_matches_name( const Xsxml_Query_Step *step, 
+                                    const Xsxml_Nodes *xsxml_node)
+{
+    return (step->tag_name == NULL) 
+        || strings_equal( xsxml_node->node_name, xsxml_node->node_name_length, 
+                          step->tag_name, step->tag_name_length);
+}
+
+
+/* Applies the predicates of the given step, in order, to the given group */
+/* of nodes, which are in document order, and returns the number of the   */
+/* nodes that are kept at the start of the group.                         */
+static size_t filter_query_group( Xsxml *xsxml_object, 
+                                  const Xsxml_Query *xsxml_query, 
+                                  const Xsxml_Query_Step *step, 
+                                  size_t *group, 
+                                  size_t group_size)
+{
+    for (size_t k = 0; (k < step->number_of_predicates) && (group_size > 0); k++)
+    {
+        const Xsxml_Query_Predicate *predicate = 
+            &xsxml_query->predicate[step->predicate_start + k];
 
-        if (content != NULL)
+        if (predicate->kind == XSXML_QUERY_PREDICATE_ATTRIBUTE)
         {
-            node_i_is_true = 0;
+            size_t kept = 0;
 
-            for (unsigned k = 0; k < xsxml_object->node[i]->number_of_contents; k++)
+            for (size_t g = 0; g < group_size; g++)
             {
-                if (strstr(xsxml_object->node[i]->content[k], content) != NULL)
+                const Xsxml_Nodes *node = xsxml_object->node[group[g]];
+
+                if (attributes_match( node->attribute_name, 
+                                      node->attribute_name_length, 
+                                      node->attribute_value, 
+                                      node->attribute_value_length, 
+                                      node->number_of_attributes, 
+                                      predicate->attribute_name, 
+                                      predicate->attribute_name_length, 
+                                      predicate->attribute_value, 
+                                      predicate->attribute_value_length))
                 {
-                    node_i_is_true = 1;
-                    break;
+                    group[kept++] = group[g];
                 }
             }
+
+            group_size = kept;
         }
+        else if (predicate->kind == XSXML_QUERY_PREDICATE_POSITION)
+        {
+            if (predicate->position <= group_size)
+            {
+                group[0] = group[predicate->position - 1];
 
-        if (node_i_is_true)
+                group_size = 1;
+            }
+            else
+            {
+                group_size = 0;
+            }
+        }
+        else /* if (predicate->kind == XSXML_QUERY_PREDICATE_LAST) */
         {
-            return_node_indices = 
-            (size_t *) realloc( return_node_indices, 
-                                (++return_node_indices[0] + 1) * sizeof(size_t));
+            group[0] = group[group_size - 1];
 
-            return_node_indices [return_node_indices[0]] = i;
+            group_size = 1;
         }
     }
 
-    return return_node_indices;
+    return group_size;
 }
 
 
-size_t *xsxml_files_occurrence( Xsxml_Files *xsxml_files_object, 
-                                char *tag_name, 
-                                char *attribute_name, 
-                                char *attribute_value, 
-                                char *content, 
-                                Xsxml_Direction direction)
+/* The selected nodes of a step, which grow geometrically. */
+typedef struct Xsxml_Query_Selection
 {
-    size_t *return_node_indices = (size_t *) malloc(sizeof(size_t));
+    size_t *node;
+    size_t number_of_nodes;
+    size_t capacity;
 
-    return_node_indices[0] = 0;
+    int is_out_of_order;
+
+} Xsxml_Query_Selection;
 
-    if ((tag_name == NULL) && (attribute_name  == NULL) 
-    &&  (content  == NULL) && (attribute_value == NULL))
+
+static void select_query_node( Xsxml_Query_Selection *selection, 
+                               size_t node_index)
+{
+    if (selection->number_of_nodes == selection->capacity)
     {
-        return return_node_indices;
-    }
+        selection->capacity = 2 * selection->capacity + 16;
 
-    size_t i_start;
-    size_t i_negatory_end_condition;
+        selection->node = 
+        (size_t *) realloc(selection->node, selection->capacity * sizeof(size_t));
+    }
 
-    if (direction == XSXML_DIRECTION_FORWARD)
+    if ((selection->number_of_nodes > 0) 
+    &&  (selection->node[selection->number_of_nodes - 1] > node_index))
     {
-        i_start = 0;
-        i_negatory_end_condition = xsxml_files_object->number_of_nodes;
+        selection->is_out_of_order = 1;
     }
-    else /* if (direction == XSXML_DIRECTION_BACKWARD) */
+
+    selection->node[selection->number_of_nodes++] = node_index;
+}
+
+
+/* Selects the children of the given parent node that pass the step, where */
+/* XSXML_NO_NODE denotes the document, whose only child is the root node.  */
+static void select_query_children( Xsxml *xsxml_object, 
+                                   const Xsxml_Children *children, 
+                                   const Xsxml_Query *xsxml_query, 
+                                   const Xsxml_Query_Step *step, 
+                                   size_t parent_node_index, 
+                                   size_t *group, 
+                                   Xsxml_Query_Selection *selection)
+{
+    const size_t ROOT_NODE_INDEX = 0;
+
+    const size_t *child = (parent_node_index == XSXML_NO_NODE) 
+                        ? &ROOT_NODE_INDEX 
+                        : &children->child[children->child_start[parent_node_index]];
+
+    const size_t NUMBER_OF_CHILDREN = (parent_node_index == XSXML_NO_NODE) 
+                                    ? 1 
+                                    : children->child_start[parent_node_index + 1] 
+                                    - children->child_start[parent_node_index];
+
+    size_t group_size = 0;
+
+    for (size_t k = 0; k < NUMBER_OF_CHILDREN; k++)
     {
-        i_start = xsxml_files_object->number_of_nodes - 1;
-        i_negatory_end_condition = (unsigned int)-1;
-        direction = -1;
+        if (query_step_matches_name(step, xsxml_object->node[child[k]])) group[group_size++] = child[k];
     }
 
-    Xsxml_Char_File_IO io_obj;
+    group_size = filter_query_group(xsxml_object, xsxml_query, step, group, group_size);
 
-    io_obj.temporary_dir_path  = xsxml_files_object->node_directory_path;
-    io_obj.temporary_file_name = xsxml_files_object->node_file_name;
+    for (size_t g = 0; g < group_size; g++) select_query_node(selection, group[g]);
+}
+
+
+size_t *xsxml_query_run( Xsxml_Query *xsxml_query, 
+                         Xsxml *xsxml_object)
+{
+    size_t *return_node_indices = (size_t *) malloc(sizeof(size_t));
+
+    return_node_indices[0] = 0;
 
-    for (unsigned int i = i_start; i != i_negatory_end_condition; i += direction)
+    if ((xsxml_query->result != XSXML_RESULT_SUCCESS) || (xsxml_object->number_of_nodes == 0))
     {
-        io_obj.node_j_value = -1;
-        io_obj.data_str     = NULL;
+        return return_node_indices;
+    }
 
-        int node_i_is_true = 0;
+    /* The nodes are put into document order by the child index. */
+    const Xsxml_Children *children = xsxml_children(xsxml_object);
 
-        io_obj.node_i_value = i;
+    const size_t n = xsxml_object->number_of_nodes;
 
-        if (tag_name != NULL)
-        {
-            io_obj.property_term = "nn";
-            read_from_char_file(&io_obj);
+    /* The nodes of the same parent, as filtered by the predicates. */
+    size_t *group = (size_t *) malloc(n * sizeof(size_t));
 
-            if (strcmp(io_obj.data_str, tag_name) == 0)
-                node_i_is_true = 1;
-            else
-                continue;
-        }
+    /* The context nodes of the first step is the document itself. */
+    Xsxml_Query_Selection context = { NULL, 0, 0, 0 };
 
-        io_obj.property_term = "aN";
-        io_obj.data_str      = "dummy";
-        read_from_char_file(&io_obj);
+    select_query_node(&context, XSXML_NO_NODE);
+
+    for (size_t s = 0; (s < xsxml_query->number_of_steps) && (context.number_of_nodes > 0); s++)
+    {
+        const Xsxml_Query_Step *step = &xsxml_query->step[s];
 
-        for (unsigned j = 0; j < io_obj.data_int; j++)
+        Xsxml_Query_Selection selection = { NULL, 0, 0, 0 };
+
+        if (step->axis == XSXML_QUERY_AXIS_CHILD)
         {
-            if (attribute_name != NULL)
+            for (size_t c = 0; c < context.number_of_nodes; c++)
             {
-                io_obj.node_j_value  =  j;
-                io_obj.property_term = "an";
-                io_obj.data_str      = NULL;
-                read_from_char_file(&io_obj);
-
-                if (strcmp(io_obj.data_str, attribute_name) == 0)
-                {
-                    node_i_is_true = 1;
-                }
-                else
-                {
-                    node_i_is_true = 0;
-                    continue;
-                }
+                select_query_children( xsxml_object, 
+                                       children, 
+                                       xsxml_query, 
+                                       step, 
+                                       context.node[c], 
+                                       group, 
+                                       &selection);
             }
+        }
+        else /* if (step->axis == XSXML_QUERY_AXIS_DESCENDANT) */
+        {
+            /* The descendants of the context nodes are the nodes within */
+            /* their subtrees, of which the nested ones are skipped.     */
+            size_t covered_end = 0;
+            int is_covered = 0;
 
-            if (attribute_value != NULL)
+            for (size_t c = 0; c < context.number_of_nodes; c++)
             {
-                io_obj.node_j_value  =  j;
-                io_obj.property_term = "av";
-                io_obj.data_str      = NULL;
-                read_from_char_file(&io_obj);
+                const size_t C = context.node[c];
+
+                if (is_covered && (C != XSXML_NO_NODE) && (C <= covered_end)) continue;
+
+                const size_t RANGE_START = (C == XSXML_NO_NODE) ? 0     : C + 1;
+                const size_t RANGE_END   = (C == XSXML_NO_NODE) ? n - 1 : xsxml_object->node[C]->subtree_end;
 
-                if (strcmp(io_obj.data_str, attribute_value) != 0)
+                covered_end = RANGE_END;
+                is_covered  = 1;
+
+                if (step->has_positional_predicates)
                 {
-                    node_i_is_true = 1;
+                    /* The positions are counted among the children of */
+                    /* every node, from the context node downwards.    */
+                    select_query_children( xsxml_object, 
+                                           children, 
+                                           xsxml_query, 
+                                           step, 
+                                           C, 
+                                           group, 
+                                           &selection);
+
+                    for (size_t d = RANGE_START; (d <= RANGE_END) && (RANGE_START <= RANGE_END); d++)
+                    {
+                        select_query_children( xsxml_object, 
+                                               children, 
+                                               xsxml_query, 
+                                               step, 
+                                               d, 
+                                               group, 
+                                               &selection);
+                    }
                 }
-                else
+                else if (RANGE_START <= RANGE_END)
                 {
-                    node_i_is_true = 0;
-                    continue;
-                }
-            }
+                    /* Without positions, every node is filtered on its own, */
+                    /* and the nodes of a tag name are found through the    */
+                    /* tag index.                                           */
+                    size_t group_size = 0;
 
-            if (node_i_is_true) break;
-        }
+                    if (step->tag_name != NULL)
+                    {
+                        const Xsxml_Tag_Index *tag_index = xsxml_tag_index(xsxml_object);
 
-        if (content != NULL)
-        {
-            node_i_is_true = 0;
+                        /* The tag index holds null-terminated names alone. */
+                        char tag_name [step->tag_name_length + 1];
 
-            io_obj.property_term = "cN";
-            io_obj.data_str      = "dummy";
-            read_from_char_file(&io_obj);
+                        memcpy(tag_name, step->tag_name, step->tag_name_length);
 
-            for (unsigned k = 0; k < io_obj.data_int; k++)
-            {
-                io_obj.node_j_value  =  k;
-                io_obj.property_term = "c";
-                io_obj.data_str      = NULL;
-                read_from_char_file(&io_obj);
+                        tag_name[step->tag_name_length] = 0;
 
-                if (strstr(io_obj.data_str, content) != NULL)
-                {
-                    node_i_is_true = 1;
-                    break;
+                        const size_t NAME_ID = tag_index_find(xsxml_object, tag_index, tag_name);
+
+                        if (NAME_ID == XSXML_NO_NODE) break;
+
+                        const size_t *NAME_NODE = &tag_index->node[tag_index->node_start[NAME_ID]];
+
+                        const size_t NUMBER_OF_NAME_NODES = tag_index->node_start[NAME_ID + 1] 
+                                                          - tag_index->node_start[NAME_ID];
+
+                        for (size_t k = lower_bound_node_index(NAME_NODE, NUMBER_OF_NAME_NODES, RANGE_START); 
+                             (k < NUMBER_OF_NAME_NODES) && (NAME_NODE[k] <= RANGE_END); 
+                             k++)
+                        {
+                            group[group_size++] = NAME_NODE[k];
+                        }
+                    }
+                    else /* if (step->tag_name == NULL) */
+                    {
+                        for (size_t d = RANGE_START; d <= RANGE_END; d++) group[group_size++] = d;
+                    }
+
+                    group_size = filter_query_group(xsxml_object, xsxml_query, step, group, group_size);
+
+                    for (size_t g = 0; g < group_size; g++) select_query_node(&selection, group[g]);
                 }
             }
         }
 
-        if (node_i_is_true)
+        if (selection.is_out_of_order)
         {
-            return_node_indices = 
-            (size_t *) realloc( return_node_indices, 
-                                (++return_node_indices[0] + 1) * sizeof(size_t));
-
-            return_node_indices [return_node_indices[0]] = i;
+            qsort(selection.node, selection.number_of_nodes, sizeof(size_t), compare_node_indices);
         }
+
+        free(context.node);
+
+        context = selection;
+    }
+
+    return_node_indices = 
+    (size_t *) realloc(return_node_indices, (context.number_of_nodes + 1) * sizeof(size_t));
+
+    return_node_indices[0] = context.number_of_nodes;
+
+    for (size_t k = 0; k < context.number_of_nodes; k++)
+    {
+        return_node_indices[k + 1] = context.node[k];
     }
 
+    free(context.node);
+    free(group);
+
     return return_node_indices;
 }
 
@@ -2520,11 +9888,11 @@ static void write_content_to_file( FILE *save_file_pointer,
 
     char *cdata_value = (char *) malloc(1);
 
-    int cdata_len = 0;
+    size_t cdata_len = 0;
 
     int was_space = 0;
 
-    for (unsigned int i = 0; i < CONTENT_LEN; i++)
+    for (size_t i = 0; i < CONTENT_LEN; i++)
     {
         if ((content[i] ==  ' ') 
         ||  (content[i] == '\r') 
@@ -2601,12 +9969,13 @@ static void write_content_to_file( FILE *save_file_pointer,
 
 
 static void compile_all_nodes( Xsxml_Private_Result *result_obj, 
+                               Xsxml *xsxml_object, 
                                Xsxml_Nodes *xsxml_node_object, 
                                FILE *save_file_pointer, 
                                unsigned int indentation, 
                                unsigned int vertical_spacing, 
                                Xsxml_Non_Alnum_Chars_Conversion content_conversion_mode, 
-                               unsigned int *level)
+                               size_t *level)
 {
     /* Validating tag. */
 
@@ -2650,7 +10019,11 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
         return;
     }
 
-    for (unsigned int i = 0; i < strlen(xsxml_node_object->node_name); i++)
+    /* The node may have been built by hand, and so its stored string */
+    /* lengths are not relied upon. Each length is computed only once. */
+    const size_t NODE_NAME_LEN = strlen(xsxml_node_object->node_name);
+
+    for (size_t i = 0; i < NODE_NAME_LEN; i++)
     {
         if (!isalnum(xsxml_node_object->node_name[i]) 
         &&  (xsxml_node_object->node_name[i] != '-') 
@@ -2675,16 +10048,16 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
 
     fprintf( save_file_pointer, 
              "%*s<%s", 
-             indentation * (*level), "", 
+             (int) (indentation * (*level)), "", 
              xsxml_node_object->node_name);
 
-    const unsigned int n_attributes = xsxml_node_object->number_of_attributes;
+    const size_t n_attributes = xsxml_node_object->number_of_attributes;
 
-    for (unsigned int j = 0; j < n_attributes; j++)
+    for (size_t j = 0; j < n_attributes; j++)
     {
         /* Validating attribute name. */
 
-        for (unsigned int k = 0; k < n_attributes; k++)
+        for (size_t k = 0; k < n_attributes; k++)
         {
             if (k == j) continue;
 
@@ -2727,7 +10100,9 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
             return;
         }
 
-        for (unsigned int i = 0; i < strlen(xsxml_node_object->attribute_name[j]); i++)
+        const size_t ATTRIBUTE_NAME_LEN = strlen(xsxml_node_object->attribute_name[j]);
+
+        for (size_t i = 0; i < ATTRIBUTE_NAME_LEN; i++)
         {
             if (!isalnum(xsxml_node_object->attribute_name[j][i]) 
             &&  (xsxml_node_object->attribute_name[j][i] != '-') 
@@ -2822,17 +10197,20 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
 
     fprintf(save_file_pointer, ">");
 
-    const unsigned int n_contents = xsxml_node_object->number_of_contents;
+    const size_t n_contents = xsxml_node_object->number_of_contents;
 
     if (n_contents > 0)
     {
+        /* Lazily parsed contents are decoded before being validated. */
+        materialise_contents(xsxml_object, xsxml_node_object);
+
         /* Validating PCDATA. */
 
-        for (unsigned int j = 0; j < n_contents; j++)
+        for (size_t j = 0; j < n_contents; j++)
         {
             size_t ret_0 = 0;
 
-            int cdata_tags_n = 0;
+            size_t cdata_tags_n = 0;
 
             size_t *cdata_tag_pos_start = (size_t *) malloc(1 * sizeof(size_t));
             size_t *cdata_tag_pos_end   = (size_t *) malloc(1 * sizeof(size_t));
@@ -2916,7 +10294,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
                 {
                     int char_is_valid = 0;
 
-                    for (int k = 0; k < cdata_tags_n; k++)
+                    for (size_t k = 0; k < cdata_tags_n; k++)
                     {
                         if ((ret_1_pos > cdata_tag_pos_start[k]) 
                         &&  (ret_1_pos < cdata_tag_pos_end[k]))
@@ -2960,7 +10338,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
                 {
                     int char_is_valid = 0;
 
-                    for (int k = 0; k < cdata_tags_n; k++)
+                    for (size_t k = 0; k < cdata_tags_n; k++)
                     {
                         if ((ret_1_pos > cdata_tag_pos_start[k]) 
                         &&  (ret_1_pos < cdata_tag_pos_end[k]))
@@ -3028,7 +10406,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
         }
     }
 
-    unsigned int content_i = 0;
+    size_t content_i = 0;
 
     int last_element_was_tag;
 
@@ -3056,6 +10434,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
         while (xsxml_sub_node_object != NULL)
         {
             compile_all_nodes( result_obj, 
+                               xsxml_object, 
                                xsxml_sub_node_object, 
                                save_file_pointer, 
                                indentation, 
@@ -3092,7 +10471,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
                 fprintf(save_file_pointer, "\n");
             }
 
-            fprintf(save_file_pointer, "%*s", indentation * (*level), "");
+            fprintf(save_file_pointer, "%*s", (int) (indentation * (*level)), "");
         }
 
         fprintf( save_file_pointer, 
@@ -3109,7 +10488,7 @@ static void compile_all_nodes( Xsxml_Private_Result *result_obj,
         }
         else
         {
-            fseek(save_file_pointer, SEEK_CUR, -1);
+            fseek(save_file_pointer, -1, SEEK_CUR);
 
             fputc('/', save_file_pointer);
         }
@@ -3230,7 +10609,7 @@ void xsxml_compile( Xsxml *xsxml_object,
 
     if (vertical_spacing == 0) fputc('\n', save_file_pointer);
 
-    unsigned int level = 0;
+    size_t level = 0;
 
     Xsxml_Private_Result private_result;
 
@@ -3239,6 +10618,7 @@ void xsxml_compile( Xsxml *xsxml_object,
     private_result.result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
 
     compile_all_nodes( &private_result, 
+                       xsxml_object, 
                        xsxml_object->node[0], 
                        save_file_pointer, 
                        indentation, 
@@ -33,10 +33,33 @@ It does not cater to the following features:
 
 Though it can parse CDATA and character entity references.
 
-Also note that all alphabetic input and data are case-sensitive.
+Also note that all alphabetic input and data are case-sensitive, except 
+in the searches of an Xsxml_Occurrence_Query that ignore the case.
 */
 
 
+#include <stddef.h>
+
+
+/*
+Strings shorter than this many bytes (excluding the null terminator) are 
+not given a heap allocation of their own. Tag names are stored inline within 
+their Xsxml_Nodes structure, while short attribute names, attribute values 
+and contents are packed back-to-back into the string arena of their Xsxml 
+object. Longer strings fall back to a separate heap allocation, which is 
+also owned by the string arena.
+*/
+#define XSXML_SHORT_STRING_SIZE 16
+
+
+/* Denotes the absence of a node wherever a node index is expected. */
+#define XSXML_NO_NODE ((size_t) -1)
+
+
+/* Denotes the absence of a limit on the number of occurrences returned. */
+#define XSXML_NO_LIMIT ((size_t) -1)
+
+
 typedef enum Xsxml_Property
 {
     XSXML_PROPERTY_NONE                   = -1, 
@@ -51,7 +74,8 @@ typedef enum Xsxml_Property
     XSXML_PROPERTY_ANCESTOR               = 7, 
     XSXML_PROPERTY_DESCENDANT             = 8, 
     XSXML_PROPERTY_NEXT_SIBLING           = 9, 
-    XSXML_PROPERTY_PREVIOUS_SIBLING       = 10
+    XSXML_PROPERTY_PREVIOUS_SIBLING       = 10, 
+    XSXML_PROPERTY_SUBTREE_END            = 11
 
 } Xsxml_Property;
 
@@ -72,6 +96,67 @@ typedef enum Xsxml_Direction
 } Xsxml_Direction;
 
 
+/*
+The match modes of the criteria of an Xsxml_Occurrence_Query, where the 
+default is the exact match of the tag names, attribute names and values, 
+and the substring match of the contents, as in xsxml_occurrence(). 
+
+XSXML_MATCH_PREFIX matches the strings that start with the criterion. 
+
+XSXML_MATCH_GLOB matches the whole string against a pattern of '*', for 
+any number of bytes, '?', for any one byte, and bracket expressions such 
+as [A-Z], [!0-9], [^0-9] or [[:digit:]], where a backslash (\) escapes 
+any character. The named classes are those of <ctype.h>, over ASCII alone: 
+alnum, alpha, blank, cntrl, digit, graph, lower, print, punct, space, 
+upper and xdigit. 
+
+XSXML_MATCH_REGEX searches the string for a regular expression of the 
+following subset of the POSIX extended syntax: 
+    .                       any byte
+    [...]  [^...]           bracket expressions, with ranges
+    [[:alpha:]]             the ASCII bytes of a named class in brackets
+    \d  \w  \s              digits, word characters, space characters
+    \D  \W  \S              all bytes but those
+    \n  \t  \r              newline, tab, carriage return
+    ^  $                    the start and the end of the string
+    *  +  ?                 zero or more, one or more, zero or one
+    {m}  {m,}  {m,n}        at most 255 repetitions
+    |  ( )                  alternation and grouping
+where a backslash (\) escapes any other character. 
+
+For example, "^[0-9]{6}$" matches the contents of exactly six digits. 
+The patterns are compiled once per search into an automaton, through 
+which every string is matched in a single pass over its bytes. 
+
+Each criterion may also be matched regardless of the case of its ASCII 
+letters, which are then folded as they are compared, without copying 
+the strings. The letters beyond ASCII are always matched as they are. 
+*/
+typedef enum Xsxml_Match_Mode
+{
+    XSXML_MATCH_DEFAULT   = 0, 
+    XSXML_MATCH_EXACT     = 1, 
+    XSXML_MATCH_SUBSTRING = 2, 
+    XSXML_MATCH_PREFIX    = 3, 
+    XSXML_MATCH_GLOB      = 4, 
+    XSXML_MATCH_REGEX     = 5
+
+} Xsxml_Match_Mode;
+
+
+/* The parse options may be combined using the bitwise OR operator (|). */
+typedef enum Xsxml_Parse_Option
+{
+    XSXML_PARSE_OPTION_NONE            = 0, 
+    XSXML_PARSE_OPTION_COLUMNS         = 1, 
+    XSXML_PARSE_OPTION_LAZY_CONTENT    = 2, 
+    XSXML_PARSE_OPTION_TAG_INDEX       = 4, 
+    XSXML_PARSE_OPTION_ATTRIBUTE_INDEX = 8, 
+    XSXML_PARSE_OPTION_CONTENT_INDEX   = 16
+
+} Xsxml_Parse_Option;
+
+
 typedef enum Xsxml_Non_Alnum_Chars_Conversion
 {
     XSXML_NO_CONVERSION               = 0, 
@@ -84,6 +169,29 @@ typedef enum Xsxml_Non_Alnum_Chars_Conversion
 
 typedef struct Xsxml Xsxml;
 typedef struct Xsxml_Nodes Xsxml_Nodes;
+typedef struct Xsxml_String_Arena Xsxml_String_Arena;
+typedef struct Xsxml_Name_Table Xsxml_Name_Table;
+typedef struct Xsxml_Edit_State Xsxml_Edit_State;
+typedef struct Xsxml_Shared_Version Xsxml_Shared_Version;
+typedef struct Xsxml_Parse_Context Xsxml_Parse_Context;
+typedef struct Xsxml_Query_Step Xsxml_Query_Step;
+typedef struct Xsxml_Query_Predicate Xsxml_Query_Predicate;
+typedef struct Xsxml_Match_Iter Xsxml_Match_Iter;
+
+
+/*
+The location of a content within the retained source of a lazily parsed 
+Xsxml object. A content that needs no decoding is copied verbatim, 
+whereas the other contents have their whitespaces collapsed, their 
+character entity references replaced, and their CDATA sections unwrapped.
+*/
+typedef struct Xsxml_Lazy_Content
+{
+    size_t offset;
+    size_t length;
+    int needs_decoding;
+
+} Xsxml_Lazy_Content;
 
 
 typedef struct Xsxml_Nodes
@@ -93,46 +201,404 @@ typedef struct Xsxml_Nodes
     Xsxml_Nodes *next_sibling;
     Xsxml_Nodes *previous_sibling;
 
-    unsigned int depth;
-    unsigned int number_of_contents;
-    unsigned int number_of_attributes;
+    size_t depth;
+    size_t number_of_contents;
+    size_t number_of_attributes;
+    size_t number_of_children;
 
     char  *node_name;
     char **content;
     char **attribute_name;
     char **attribute_value;
 
+    /* The lengths of the above strings, excluding the null terminators. */
+    size_t  node_name_length;
+    size_t *content_length;
+    size_t *attribute_name_length;
+    size_t *attribute_value_length;
+
+    /* Set only for lazily parsed objects, whose contents (and content */
+    /* lengths) remain unset until they are accessed through the       */
+    /* xsxml_content() function.                                        */
+    Xsxml_Lazy_Content *lazy_content;
+
+    char node_name_inline [XSXML_SHORT_STRING_SIZE];
+
+    /* The nodes are numbered in document order (pre-order), and so the */
+    /* subtree of node i consists of the nodes i to subtree_end.        */
+    size_t subtree_end;
+
 } Xsxml_Nodes;
 
 
+/*
+The columnar (structure-of-arrays) form of an Xsxml object's nodes, 
+where every array is indexed by the node index.
+
+The strings are not copied; they point to the strings of the nodes.
+*/
+typedef struct Xsxml_Columns
+{
+    size_t number_of_nodes;
+
+    /* The distinct tag names, indexed by their name identifiers. */
+    size_t number_of_names;
+    char **name;
+
+    size_t *depth;
+    size_t *name_id;
+    size_t *parent;
+
+    /* The attributes of node i are in the range                       */
+    /* [ attribute_start[i], attribute_start[i + 1] ).                 */
+    size_t *attribute_start;
+    char  **attribute_name;
+    char  **attribute_value;
+    size_t *attribute_name_length;
+    size_t *attribute_value_length;
+
+    /* The contents of node i are in the range                         */
+    /* [ content_start[i], content_start[i + 1] ).                     */
+    size_t *content_start;
+    char  **content;
+    size_t *content_length;
+
+    Xsxml_Name_Table *name_table;
+
+} Xsxml_Columns;
+
+
+/*
+The children of every node of an Xsxml object, as node indices, where 
+the children of node i are in the range [ child_start[i], child_start[i + 1] ), 
+in document order.
+*/
+typedef struct Xsxml_Children
+{
+    size_t number_of_nodes;
+
+    size_t *child_start;
+    size_t *child;
+
+} Xsxml_Children;
+
+
+/*
+The nodes of every tag name of an Xsxml object, as node indices, where 
+the nodes whose tag name has the identifier k are in the range 
+[ node_start[k], node_start[k + 1] ), in document order.
+
+The tag names are identified through the name table, which refers to 
+the first node of each tag name, and so holds no strings of its own.
+*/
+typedef struct Xsxml_Tag_Index
+{
+    size_t number_of_nodes;
+    size_t number_of_names;
+
+    size_t *node_start;
+    size_t *node;
+
+    Xsxml_Name_Table *name_table;
+
+} Xsxml_Tag_Index;
+
+
+/*
+The nodes of every distinct pair of attribute name and attribute value 
+of an Xsxml object, as node indices, where the nodes that have the pair 
+of identifier k are in the range [ node_start[k], node_start[k + 1] ), 
+in document order, and without repetitions.
+
+The pair of identifier k is that of the attribute first_attribute[k] 
+of the first node in its range, and so the name table holds no strings 
+of its own.
+*/
+typedef struct Xsxml_Attribute_Index
+{
+    size_t number_of_nodes;
+    size_t number_of_pairs;
+    size_t number_of_entries;
+
+    size_t *node_start;
+    size_t *node;
+    size_t *first_attribute;
+
+    Xsxml_Name_Table *name_table;
+
+} Xsxml_Attribute_Index;
+
+
+/*
+The nodes of every distinct trigram (three consecutive bytes) within the 
+contents of an Xsxml object, as node indices, where the nodes that have 
+the trigram of identifier k are in the range [ node_start[k], 
+node_start[k + 1] ), in document order, and without repetitions.
+
+A node only contains a searched string of three or more bytes if one of 
+its contents holds every trigram of the string, and so the index narrows 
+down the nodes whose contents are then searched.
+*/
+typedef struct Xsxml_Content_Index
+{
+    size_t number_of_nodes;
+    size_t number_of_trigrams;
+    size_t number_of_entries;
+
+    /* The trigram of every identifier, as the value of its three bytes. */
+    size_t *trigram;
+
+    size_t *node_start;
+    size_t *node;
+
+    Xsxml_Name_Table *name_table;
+
+    /* The time taken to build the index, in seconds. */
+    double build_seconds;
+
+} Xsxml_Content_Index;
+
+
+/*
+The memory held by an Xsxml or an Xsxml_Files object, in bytes. 
+The figures are kept up to date as the object is built, and so they 
+are queried in constant time.
+
+Tag names shorter than XSXML_SHORT_STRING_SIZE bytes are stored within 
+their nodes, and are thus counted as node bytes. The overhead bytes are 
+an estimate, which comprises the object itself, the unused space of its 
+string arena, and a fixed amount of allocator bookkeeping per allocation.
+*/
+typedef struct Xsxml_Memory_Usage
+{
+    size_t node_bytes;
+    size_t name_bytes;
+    size_t content_bytes;
+    size_t attribute_bytes;
+    size_t pointer_array_bytes;
+    size_t source_bytes;
+    size_t index_bytes;
+    size_t overhead_bytes;
+
+    size_t number_of_allocations;
+
+    /* The sum of all of the above bytes, which are held in memory. */
+    size_t total_bytes;
+
+    /* The bytes held by the temporary files of an Xsxml_Files object. */
+    size_t disk_bytes;
+
+} Xsxml_Memory_Usage;
+
+
 typedef struct Xsxml
 {
     Xsxml_Result result;
     char *result_message;
 
-    unsigned int number_of_nodes;
+    size_t number_of_nodes;
 
     Xsxml_Nodes **node;
 
+    Xsxml_String_Arena *string_arena;
+
+    Xsxml_Columns *columns;
+
+    /* Built upon the first use of the child access functions, and */
+    /* discarded once nodes are inserted or removed.               */
+    Xsxml_Children *children;
+
+    /* Built upon the first tag name query of the xsxml_occurrence() */
+    /* function, or at parse time, and discarded once nodes are      */
+    /* inserted or removed.                                          */
+    Xsxml_Tag_Index *tag_index;
+
+    /* Built upon the first query of the xsxml_occurrence() function */
+    /* by both an attribute name and value, or at parse time, and    */
+    /* discarded once attributes are set, or nodes are inserted or   */
+    /* removed.                                                      */
+    Xsxml_Attribute_Index *attribute_index;
+
+    /* Built only upon the call to the xsxml_content_index() function,  */
+    /* or at parse time, as it may be as large as the contents, and     */
+    /* discarded once contents are appended, or nodes are inserted or   */
+    /* removed.                                                         */
+    Xsxml_Content_Index *content_index;
+
+    /* The retained source file data of a lazily parsed object. */
+    char  *source_buffer;
+    size_t source_length;
+
+    /* Read through the xsxml_memory_usage() function. */
+    Xsxml_Memory_Usage memory_usage;
+
+    /* Set upon the first use of the RAM mode editing functions. */
+    Xsxml_Edit_State *edit_state;
+
+    /* Set while the nodes are shared with, or are those of, a snapshot. */
+    Xsxml_Shared_Version *shared_version;
+    int is_snapshot;
+
+    /* Set only whilst the object is refilled by xsxml_parse_into(). */
+    Xsxml_Parse_Context *parse_context;
+
+    /* Read through the xsxml_generation() function, as it is zero (0) */
+    /* until first read.                                               */
+    size_t generation;
+
 } Xsxml;
 
 
+/* The criteria of one search of the xsxml_occurrence_query() and */
+/* xsxml_occurrence_batch() functions.                             */
+typedef struct Xsxml_Occurrence_Query
+{
+    char *tag_name;
+    char *attribute_name;
+    char *attribute_value;
+    char *content;
+
+    Xsxml_Direction direction;
+
+    /* Left as XSXML_MATCH_DEFAULT (0) unless set otherwise. */
+    Xsxml_Match_Mode tag_name_match_mode;
+    Xsxml_Match_Mode attribute_name_match_mode;
+    Xsxml_Match_Mode attribute_value_match_mode;
+    Xsxml_Match_Mode content_match_mode;
+
+    /* Set to one (1) for the ASCII letters of the criterion to match */
+    /* either case, in any match mode, or left as zero (0) otherwise. */
+    int is_tag_name_case_insensitive;
+    int is_attribute_name_case_insensitive;
+    int is_attribute_value_case_insensitive;
+    int is_content_case_insensitive;
+
+} Xsxml_Occurrence_Query;
+
+
+/*
+A prepared xsxml_occurrence() search, with its own copies of the strings, 
+and the results of its last run, along with the object and generation 
+they were found in.
+*/
+typedef struct Xsxml_Prepared_Occurrence
+{
+    Xsxml_Occurrence_Query query;
+
+    Xsxml *xsxml_object;
+    size_t generation;
+    size_t *result;
+
+} Xsxml_Prepared_Occurrence;
+
+
+/*
+A compiled path query, which is reusable across Xsxml objects. The steps 
+and predicates point into the query's own copy of the path.
+*/
+typedef struct Xsxml_Query
+{
+    Xsxml_Result result;
+    char *result_message;
+
+    char *path;
+
+    size_t number_of_steps;
+    Xsxml_Query_Step *step;
+
+    size_t number_of_predicates;
+    Xsxml_Query_Predicate *predicate;
+
+} Xsxml_Query;
+
+
 typedef struct Xsxml_Files
 {
     Xsxml_Result result;
     char *result_message;
 
-    unsigned int number_of_nodes;
+    size_t number_of_nodes;
 
     char *node_directory_path;
     char *node_file_name;
 
+    /* Read through the xsxml_files_memory_usage() function. */
+    Xsxml_Memory_Usage memory_usage;
+
 } Xsxml_Files;
 
 
 /* RAM mode functions */
 extern Xsxml *xsxml_parse(const char *input_file_path);
 
+extern Xsxml *xsxml_parse_with_options( const char *input_file_path, 
+                                        unsigned int parse_options);
+
+/*
+Resets the given object, and refills it with the parsed file. The nodes, 
+the node array, the string arena chunks, the long strings, and the source 
+buffer of the previous document are reused in the same order, and only 
+grown where the new document needs more, so that the repeated parsing of 
+similar documents costs next to no allocations. The spares that are left 
+unused are freed. Any edits are discarded, and the memory shared with any 
+snapshots is left to them.
+*/
+extern Xsxml_Result xsxml_parse_into( Xsxml *xsxml_object, 
+                                      const char *input_file_path, 
+                                      unsigned int parse_options);
+
+extern Xsxml_Columns *xsxml_columns(Xsxml *xsxml_object);
+
+/* The child access functions return XSXML_NO_NODE if there is no such child. */
+extern Xsxml_Children *xsxml_children(Xsxml *xsxml_object);
+
+extern size_t xsxml_child( Xsxml *xsxml_object, 
+                           size_t node_index, 
+                           size_t child_position);
+
+extern size_t xsxml_child_by_name( Xsxml *xsxml_object, 
+                                   size_t node_index, 
+                                   const char *tag_name);
+
+extern Xsxml_Tag_Index *xsxml_tag_index(Xsxml *xsxml_object);
+
+extern Xsxml_Attribute_Index *xsxml_attribute_index(Xsxml *xsxml_object);
+
+/* Once built, the content index is used by the xsxml_occurrence() function. */
+extern Xsxml_Content_Index *xsxml_content_index(Xsxml *xsxml_object);
+
+/* The subtree functions return zero (0) if a node index is out of range. */
+extern size_t xsxml_subtree_size( Xsxml *xsxml_object, 
+                                  size_t node_index);
+
+extern int xsxml_is_within_subtree( Xsxml *xsxml_object, 
+                                    size_t subtree_node_index, 
+                                    size_t node_index);
+
+extern Xsxml *xsxml_clone(Xsxml *xsxml_object);
+
+extern Xsxml *xsxml_extract_subtree( Xsxml *xsxml_object, 
+                                     size_t node_index);
+
+extern char *xsxml_content( Xsxml *xsxml_object, 
+                            size_t node_index, 
+                            size_t content_index);
+
+extern size_t xsxml_node_name_length( Xsxml *xsxml_object, 
+                                      size_t node_index);
+
+extern size_t xsxml_content_length( Xsxml *xsxml_object, 
+                                    size_t node_index, 
+                                    size_t content_index);
+
+extern size_t xsxml_attribute_name_length( Xsxml *xsxml_object, 
+                                           size_t node_index, 
+                                           size_t attribute_index);
+
+extern size_t xsxml_attribute_value_length( Xsxml *xsxml_object, 
+                                            size_t node_index, 
+                                            size_t attribute_index);
+
 extern size_t *xsxml_occurrence( Xsxml *xsxml_object, 
                                  char *tag_name, 
                                  char *attribute_name, 
@@ -140,6 +606,96 @@ extern size_t *xsxml_occurrence( Xsxml *xsxml_object,
                                  char *content, 
                                  Xsxml_Direction direction);
 
+/*
+The search of xsxml_occurrence_with_limit() stops as soon as max_results 
+nodes have been found, which are the first ones in the given direction. 
+xsxml_first_occurrence() and xsxml_last_occurrence() return the index of 
+the single first or last node found, or XSXML_NO_NODE if there is none.
+*/
+extern size_t *xsxml_occurrence_with_limit( Xsxml *xsxml_object, 
+                                            char *tag_name, 
+                                            char *attribute_name, 
+                                            char *attribute_value, 
+                                            char *content, 
+                                            Xsxml_Direction direction, 
+                                            size_t max_results);
+
+extern size_t xsxml_first_occurrence( Xsxml *xsxml_object, 
+                                      char *tag_name, 
+                                      char *attribute_name, 
+                                      char *attribute_value, 
+                                      char *content);
+
+extern size_t xsxml_last_occurrence( Xsxml *xsxml_object, 
+                                     char *tag_name, 
+                                     char *attribute_name, 
+                                     char *attribute_value, 
+                                     char *content);
+
+/*
+Searches the descendants of the given node alone, not including the node 
+itself, at a cost in proportion to the size of its subtree rather than 
+that of the document, once the indices of the search have been built. 
+An out-of-range node index yields no matches and an XML failure result.
+*/
+extern size_t *xsxml_descendant_occurrence( Xsxml *xsxml_object, 
+                                            size_t node_index, 
+                                            char *tag_name, 
+                                            char *attribute_name, 
+                                            char *attribute_value, 
+                                            char *content, 
+                                            Xsxml_Direction direction);
+
+/*
+Searches for the nodes of the given criteria, each of which is matched in 
+its own match mode, and sets the result of the object, which is 
+XSXML_RESULT_XML_FAILURE, with no node returned, if a match mode or a 
+pattern is invalid. The other occurrence functions set the result upon 
+failure alone. 
+*/
+extern size_t *xsxml_occurrence_query( Xsxml *xsxml_object, 
+                                       const Xsxml_Occurrence_Query *query);
+
+/*
+Evaluates several searches at once, where the results of each query are 
+set in the same form as those of the xsxml_occurrence() function. The 
+queries that can be narrowed down by an index are searched by themselves, 
+whereas all the others are checked together, during a single pass over 
+the nodes, so that each node is read only once.
+*/
+extern void xsxml_occurrence_batch( Xsxml *xsxml_object, 
+                                    const Xsxml_Occurrence_Query *queries, 
+                                    size_t number_of_queries, 
+                                    size_t **results);
+
+/*
+The generation of an object changes upon every edit, and every parse 
+into it, and no two objects ever have the same generation, and so the 
+results of a search hold for as long as the generation remains the same.
+*/
+extern size_t xsxml_generation(Xsxml *xsxml_object);
+
+/*
+A prepared search returns the results of its last run, without searching 
+again, for as long as it is run on the same object, of the same 
+generation. The results are owned by the prepared search, and remain 
+valid until it is run again, or unset. The match modes of its query, and 
+whether its criteria ignore the case, may be set before it is first run. 
+*/
+extern Xsxml_Prepared_Occurrence *xsxml_prepare_occurrence( const char *tag_name, 
+                                                            const char *attribute_name, 
+                                                            const char *attribute_value, 
+                                                            const char *content, 
+                                                            Xsxml_Direction direction);
+
+extern const size_t *xsxml_prepared_occurrence_run( Xsxml_Prepared_Occurrence *prepared, 
+                                                    Xsxml *xsxml_object);
+
+extern void xsxml_prepared_occurrence_unset(Xsxml_Prepared_Occurrence **prepared);
+
+extern void xsxml_memory_usage( Xsxml *xsxml_object, 
+                                Xsxml_Memory_Usage *memory_usage);
+
 extern void xsxml_compile( Xsxml *xsxml_object, 
                            const char *save_directory, 
                            const char *save_file_name, 
@@ -150,6 +706,177 @@ extern void xsxml_compile( Xsxml *xsxml_object,
 extern void xsxml_unset(Xsxml **xsxml_object);
 
 
+/* RAM mode string storage functions */
+extern char *xsxml_copy_string( Xsxml *xsxml_object, 
+                                const char *data, 
+                                size_t data_length);
+
+extern void xsxml_set_node_name( Xsxml *xsxml_object, 
+                                 Xsxml_Nodes *xsxml_node, 
+                                 const char *node_name, 
+                                 size_t node_name_length);
+
+
+/*
+RAM mode editing functions
+
+The edits are applied to the node links at once, whereas the node array 
+is only put back into document order, and its subtree ends updated, by 
+the xsxml_renumber_nodes() function. The functions that rely on the node 
+order, such as xsxml_occurrence(), call it themselves. Until then, a new 
+node is found at the index returned by xsxml_insert_child(), and removed 
+nodes remain at their indices, but may no longer be edited.
+
+As the nodes are numbered in document order, an edit moves the indices of 
+all the nodes that follow it. The renumbering thus costs as much as the 
+number of nodes from the first edited position onwards, whereas the nodes 
+before it keep their indices, so that the edits towards the end of the 
+document are the cheapest to follow with a search. The indices that the 
+edits discard, as below, are rebuilt in full upon their next use. 
+
+The contents of a node are positional, as they are compiled in between its 
+children, and so every text keeps its place as the children are edited. A 
+removed child's surrounding texts are joined into one, an inserted child 
+is followed by an empty content, if any text follows it, and the appended 
+content is added to the text after the last child. 
+
+The columnar form of an edited object is discarded, to be rebuilt upon 
+the next call to the xsxml_columns() function. The child and tag indices 
+are only discarded once nodes are inserted or removed, the attribute 
+index once attributes are set as well, and the content index once 
+contents are appended as well.
+*/
+extern size_t xsxml_insert_child( Xsxml *xsxml_object, 
+                                  size_t parent_node_index, 
+                                  size_t child_position, 
+                                  const char *tag_name);
+
+extern Xsxml_Result xsxml_remove_subtree( Xsxml *xsxml_object, 
+                                          size_t node_index);
+
+extern Xsxml_Result xsxml_set_attribute( Xsxml *xsxml_object, 
+                                         size_t node_index, 
+                                         const char *attribute_name, 
+                                         const char *attribute_value);
+
+extern Xsxml_Result xsxml_append_content( Xsxml *xsxml_object, 
+                                          size_t node_index, 
+                                          const char *content);
+
+extern void xsxml_renumber_nodes(Xsxml *xsxml_object);
+
+
+/*
+RAM mode snapshot functions
+
+A snapshot is a read-only Xsxml object that shares the nodes and strings 
+of the object it is taken of, as they were at the time. The first edit 
+thereafter copies the nodes for the edited object alone, whilst the 
+strings remain shared, as they are never overwritten. 
+
+That first edit thus costs as much as the number of nodes, rather than 
+the size of the edit, since every node is linked to its parent, children 
+and siblings, none of which could be shared with a copied node. The 
+edits that follow it, until the next snapshot, cost as they would without 
+any snapshot. 
+
+The shared memory is freed along with the last object that refers to it, 
+through the xsxml_unset() function, in whichever order the objects are 
+unset.
+
+A snapshot may be read from another thread than the one editing the 
+object, without any locking. It is handed over by taking a snapshot of 
+the snapshot, which is itself lock-free, so that each thread has its own 
+Xsxml object, through which it alone may build a columnar form.
+*/
+extern Xsxml *xsxml_snapshot(Xsxml *xsxml_object);
+
+
+/*
+Match iterator functions
+
+A match iterator finds the nodes of the same criteria as the occurrence 
+functions lazily, one at a time, in either mode, instead of gathering all 
+of them at once. xsxml_match_iter_next() returns the next matching node, 
+or XSXML_NO_NODE once there are no more. xsxml_match_iter_next_batch() 
+writes up to the given capacity of the next matching nodes into the given 
+array, and returns their number, which is less than the capacity only 
+once there are no more.
+
+The given strings are not copied, and so they, as well as the object, 
+must neither be freed nor edited until the iterator is unset.
+*/
+extern Xsxml_Match_Iter *xsxml_match_iter_start( Xsxml *xsxml_object, 
+                                                 char *tag_name, 
+                                                 char *attribute_name, 
+                                                 char *attribute_value, 
+                                                 char *content, 
+                                                 Xsxml_Direction direction);
+
+extern Xsxml_Match_Iter *xsxml_files_match_iter_start( Xsxml_Files *xsxml_files_object, 
+                                                       char *tag_name, 
+                                                       char *attribute_name, 
+                                                       char *attribute_value, 
+                                                       char *content, 
+                                                       Xsxml_Direction direction);
+
+extern size_t xsxml_match_iter_next(Xsxml_Match_Iter *match_iter);
+
+extern size_t xsxml_match_iter_next_batch( Xsxml_Match_Iter *match_iter, 
+                                           size_t *node_indices, 
+                                           size_t capacity);
+
+/* The number of candidates that remain to be checked, of which every */
+/* match is one, and so it is an upper bound on the remaining matches. */
+extern size_t xsxml_match_iter_number_of_candidates(const Xsxml_Match_Iter *match_iter);
+
+/*
+Returns a new iterator over one of the given number of shares of the 
+remaining candidates of the given iterator, which are numbered in the 
+direction of the search. The shares are independent of each other, and 
+so each may be searched by a thread of its own, whereas the given 
+iterator must not be used or unset until all of them are unset.
+*/
+extern Xsxml_Match_Iter *xsxml_match_iter_share( const Xsxml_Match_Iter *match_iter, 
+                                                 size_t share_index, 
+                                                 size_t number_of_shares);
+
+extern void xsxml_match_iter_unset(Xsxml_Match_Iter **match_iter);
+
+
+/*
+RAM mode path query functions
+
+A path query is a subset of XPath 1.0, which consists of steps, each of 
+which is preceded by either a slash (/), to select the children of the 
+nodes selected so far, or a double slash (//), to select their 
+descendants. The first step is taken from the document, and so 
+'/Collection' selects the root node if it is named 'Collection'.
+
+Every step is a tag name, or an asterisk (*) for any tag name, followed 
+by any number of the following predicates, which are applied in order:
+    [@name]            the node has the attribute
+    [@name='value']    the node has the attribute with the value
+    [n]                the nth of the nodes, counted from one (1)
+    [last()]           the last of the nodes
+
+As in XPath, the positions are counted among the nodes of the same 
+parent, and so '//Book[1]' selects the first Book child of every node. 
+The values may also be enclosed within double quotes (").
+
+For example, "/Collection/Book[@lang='en']/Title".
+
+The selected node indices are returned in document order, in the same 
+form as those of the xsxml_occurrence() function.
+*/
+extern Xsxml_Query *xsxml_query_compile(const char *path);
+
+extern size_t *xsxml_query_run( Xsxml_Query *xsxml_query, 
+                                Xsxml *xsxml_object);
+
+extern void xsxml_query_unset(Xsxml_Query **xsxml_query);
+
+
 /* FILE mode functions */
 extern Xsxml_Files *xsxml_files_parse( const char *input_file_path, 
                                        const char *temporary_directory_path);
@@ -166,6 +893,34 @@ extern size_t *xsxml_files_occurrence( Xsxml_Files *xsxml_files_object,
                                        char *content, 
                                        Xsxml_Direction direction);
 
+extern size_t *xsxml_files_occurrence_query( Xsxml_Files *xsxml_files_object, 
+                                             const Xsxml_Occurrence_Query *query);
+
+/* The limited forms behave as those of RAM mode, where no further temporary */
+/* files are read once the limit is reached.                                 */
+extern size_t *xsxml_files_occurrence_with_limit( Xsxml_Files *xsxml_files_object, 
+                                                  char *tag_name, 
+                                                  char *attribute_name, 
+                                                  char *attribute_value, 
+                                                  char *content, 
+                                                  Xsxml_Direction direction, 
+                                                  size_t max_results);
+
+extern size_t xsxml_files_first_occurrence( Xsxml_Files *xsxml_files_object, 
+                                            char *tag_name, 
+                                            char *attribute_name, 
+                                            char *attribute_value, 
+                                            char *content);
+
+extern size_t xsxml_files_last_occurrence( Xsxml_Files *xsxml_files_object, 
+                                           char *tag_name, 
+                                           char *attribute_name, 
+                                           char *attribute_value, 
+                                           char *content);
+
+extern void xsxml_files_memory_usage( Xsxml_Files *xsxml_files_object, 
+                                      Xsxml_Memory_Usage *memory_usage);
+
 extern void xsxml_files_unset(Xsxml_Files **xsxml_files_object);
 
 
@@ -62,9 +62,60 @@ A 32-bit unsigned integer can deal with a maximum of 4,294,967,296 tag elements
 An 8-bit-based binary file would be smallest in terms of file size, 
 followed by a 16-bit file, 
 followed by a 32-bit file, which would be comparatively larger in file size.
+
+The in-memory model counts nodes, contents, attributes and string lengths 
+with size_t, so an object may hold more than the chosen fixed-size integer 
+can represent. Such an object is refused rather than silently truncated.
 */
 
 
+/* Returns a non-zero value if the given value can be written as a */
+/* fixed-size unsigned integer, else returns zero (0).            */
+static int fits_in_fixed_bytes(size_t value)
+{
+    return (value <= (UINT_FIXED_BYTES) -1);
+}
+
+
+/* Returns a non-zero value if every count and string length of the object */
+/* can be written as a fixed-size unsigned integer, else returns zero (0). */
+static int fits_in_binary_object(Xsxml *xsxml_object)
+{
+    if (!fits_in_fixed_bytes(xsxml_object->number_of_nodes)) return 0;
+
+    for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
+    {
+        const Xsxml_Nodes *node = xsxml_object->node[i];
+
+        if (node == NULL) continue;
+
+        if (!fits_in_fixed_bytes(node->depth)
+        ||  !fits_in_fixed_bytes(node->number_of_contents)
+        ||  !fits_in_fixed_bytes(node->number_of_attributes)
+        ||  !fits_in_fixed_bytes(node->node_name_length))
+        {
+            return 0;
+        }
+
+        for (size_t j = 0; j < node->number_of_contents; j++)
+        {
+            if (!fits_in_fixed_bytes(xsxml_content_length(xsxml_object, i, j))) return 0;
+        }
+
+        for (size_t j = 0; j < node->number_of_attributes; j++)
+        {
+            if (!fits_in_fixed_bytes(node->attribute_name_length [j])
+            ||  !fits_in_fixed_bytes(node->attribute_value_length[j]))
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+
 void create_xsxml_binary_object( Xsxml *xsxml_object, 
                                  const char *save_directory, 
                                  const char *save_file_name)
@@ -130,10 +181,25 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
         return;
     }
 
+    /* The node indices are written, and so they must be in document order. */
+    xsxml_renumber_nodes(xsxml_object);
+
+    if (!fits_in_binary_object(xsxml_object))
+    {
+        xsxml_object->result = XSXML_RESULT_XML_FAILURE;
+
+        sprintf( &xsxml_object->result_message[0], 
+                 "The object is too large for a %zu-bit binary object.", 
+                 sizeof(UINT_FIXED_BYTES) * 8);
+
+        return;
+    }
+
 
     /* Main operation starts here. */
         int      dummy_value;
         UINT_FIXED_BYTES string_len;
+        UINT_FIXED_BYTES fixed_value;
 
         dummy_value = remove(save_file_path);
 
@@ -154,11 +220,12 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
 
 
         /* Write the number of nodes. */
+        fixed_value = xsxml_object->number_of_nodes;
         dummy_value = write( file_descriptor, 
-                             &xsxml_object->number_of_nodes, 
+                             &fixed_value, 
                              sizeof(UINT_FIXED_BYTES));
 
-        for (unsigned int i = 0; i < xsxml_object->number_of_nodes; i++)
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
         {
             if (xsxml_object->node[0] == NULL)
             {
@@ -167,29 +234,32 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                 xsxml_object->result = XSXML_RESULT_XML_FAILURE;
 
                 sprintf( &xsxml_object->result_message[0], 
-                         "Tag %u of %u does not exist.", 
+                         "Tag %zu of %zu does not exist.", 
                          i + 1, xsxml_object->number_of_nodes);
 
                 return;
             }
 
             /* Write the node level. */
+            fixed_value = xsxml_object->node[i]->depth;
             dummy_value = write( file_descriptor, 
-                                 &xsxml_object->node[i]->depth, 
+                                 &fixed_value, 
                                  sizeof(UINT_FIXED_BYTES));
 
             /* Write the number of contents. */
+            fixed_value = xsxml_object->node[i]->number_of_contents;
             dummy_value = write( file_descriptor, 
-                                 &xsxml_object->node[i]->number_of_contents, 
+                                 &fixed_value, 
                                  sizeof(UINT_FIXED_BYTES));
 
             /* Write the number of attributes. */
+            fixed_value = xsxml_object->node[i]->number_of_attributes;
             dummy_value = write( file_descriptor, 
-                                 &xsxml_object->node[i]->number_of_attributes, 
+                                 &fixed_value, 
                                  sizeof(UINT_FIXED_BYTES));
 
             /* Write the node name length. */
-            string_len = strlen(xsxml_object->node[i]->node_name);
+            string_len = xsxml_object->node[i]->node_name_length;
             dummy_value = write( file_descriptor, 
                                  &string_len, 
                                  sizeof(UINT_FIXED_BYTES));
@@ -199,23 +269,24 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                                  xsxml_object->node[i]->node_name, 
                                  string_len);
 
-            for (unsigned int j = 0; j < xsxml_object->node[i]->number_of_contents; j++)
+            for (size_t j = 0; j < xsxml_object->node[i]->number_of_contents; j++)
             {
-                if (xsxml_object->node[i]->content[j] == NULL)
+                /* A lazily parsed content is decoded upon its first access. */
+                if (xsxml_content(xsxml_object, i, j) == NULL)
                 {
                     dummy_value = remove(save_file_path);
 
                     xsxml_object->result = XSXML_RESULT_XML_FAILURE;
 
                     sprintf( &xsxml_object->result_message[0], 
-                             "Content %u of %u does not exist.", 
+                             "Content %zu of %zu does not exist.", 
                              j + 1, xsxml_object->node[i]->number_of_contents);
 
                     return;
                 }
 
                 /* Write the jth content length. */
-                string_len = strlen(xsxml_object->node[i]->content[j]);
+                string_len = xsxml_content_length(xsxml_object, i, j);
                 dummy_value = write( file_descriptor, 
                                      &string_len, 
                                      sizeof(UINT_FIXED_BYTES));
@@ -226,7 +297,7 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                                      string_len);
             }
 
-            for (unsigned int j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
+            for (size_t j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
             {
                 if ((xsxml_object->node[i]->attribute_name [j] == NULL) 
                 ||  (xsxml_object->node[i]->attribute_value[j] == NULL))
@@ -236,14 +307,14 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                     xsxml_object->result = XSXML_RESULT_XML_FAILURE;
 
                     sprintf( &xsxml_object->result_message[0], 
-                             "Attribute %u of %u either does not exist or is incomplete.", 
+                             "Attribute %zu of %zu either does not exist or is incomplete.", 
                              j + 1, xsxml_object->node[i]->number_of_attributes);
 
                     return;
                 }
 
                 /* Write the jth attribute name length. */
-                string_len = strlen(xsxml_object->node[i]->attribute_name[j]);
+                string_len = xsxml_object->node[i]->attribute_name_length[j];
                 dummy_value = write( file_descriptor, 
                                      &string_len, 
                                      sizeof(UINT_FIXED_BYTES));
@@ -254,7 +325,7 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                                      string_len);
 
                 /* Write the jth attribute value length. */
-                string_len = strlen(xsxml_object->node[i]->attribute_value[j]);
+                string_len = xsxml_object->node[i]->attribute_value_length[j];
                 dummy_value = write( file_descriptor, 
                                      &string_len, 
                                      sizeof(UINT_FIXED_BYTES));
@@ -267,12 +338,12 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
         }
 
 
-        for (unsigned int i = 0; i < xsxml_object->number_of_nodes; i++)
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
         {
             /* Write the ancestor, descendant, previous and next siblings nodes. */
                 UINT_FIXED_BYTES node_numbers[4] = { 0, 0, 0, 0 };
 
-                for (unsigned int j = 0; j < xsxml_object->number_of_nodes; j++)
+                for (size_t j = 0; j < xsxml_object->number_of_nodes; j++)
                 {
                     if (!node_numbers[0])
                     {
@@ -324,6 +395,19 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
                                      sizeof(UINT_FIXED_BYTES));
         }
 
+
+        /* Write the subtree ends (the last node within each node's subtree). */
+        /* Binary object files created before this section was introduced    */
+        /* simply end after the above section.                               */
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
+        {
+            UINT_FIXED_BYTES subtree_end = xsxml_object->node[i]->subtree_end;
+
+            dummy_value = write( file_descriptor, 
+                                 &subtree_end, 
+                                 sizeof(UINT_FIXED_BYTES));
+        }
+
         close(file_descriptor);
     /* Main operation ends here. */
 
@@ -342,10 +426,16 @@ void create_xsxml_binary_object( Xsxml *xsxml_object,
 
 Xsxml *decode_xsxml_binary_object(const char *input_file_path)
 {
-    Xsxml *xsxml_object = (Xsxml *) malloc(sizeof(Xsxml));
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml *xsxml_object = (Xsxml *) calloc(1, sizeof(Xsxml));
 
     xsxml_object->result_message = (char *) malloc(RESULT_MESSAGE_MAX_LENGTH);
 
+    /* The object and its result message. */
+    xsxml_object->memory_usage.number_of_allocations = 2;
+
+    xsxml_object->memory_usage.overhead_bytes = sizeof(Xsxml) + RESULT_MESSAGE_MAX_LENGTH;
+
     if ((input_file_path == NULL) || (strlen(input_file_path) == 0))
     {
         xsxml_object->result = XSXML_RESULT_FILE_FAILURE;
@@ -375,89 +465,111 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
         int dummy_value;
 
         UINT_FIXED_BYTES string_len;
+        UINT_FIXED_BYTES fixed_value = 0;
 
 
         /* Read the number of nodes. */
         dummy_value = read( file_descriptor, 
-                            (unsigned int *) &xsxml_object->number_of_nodes, 
+                            &fixed_value, 
                             sizeof(UINT_FIXED_BYTES));
 
+        xsxml_object->number_of_nodes = fixed_value;
+
 
         xsxml_object->node = 
         (Xsxml_Nodes **) malloc(xsxml_object->number_of_nodes * sizeof(Xsxml_Nodes *));
 
+        xsxml_object->memory_usage.number_of_allocations++;
 
-        for (unsigned int i = 0; i < xsxml_object->number_of_nodes; i++)
+
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
         {
-            xsxml_object->node[i] = (Xsxml_Nodes *) malloc(sizeof(Xsxml_Nodes));
+            xsxml_object->node[i] = (Xsxml_Nodes *) calloc(1, sizeof(Xsxml_Nodes));
+
+            /* The node, its slot in the node array, and its six arrays. */
+            xsxml_object->memory_usage.node_bytes += 
+                sizeof(Xsxml_Nodes) + sizeof(Xsxml_Nodes *);
+
+            xsxml_object->memory_usage.number_of_allocations += 7;
 
             /* Read the node level. */
             dummy_value = read( file_descriptor, 
-                                &xsxml_object->node[i]->depth, 
+                                &fixed_value, 
                                 sizeof(UINT_FIXED_BYTES));
 
+            xsxml_object->node[i]->depth = fixed_value;
+
             /* Read the number of contents. */
             dummy_value = read( file_descriptor, 
-                                &xsxml_object->node[i]->number_of_contents, 
+                                &fixed_value, 
                                 sizeof(UINT_FIXED_BYTES));
 
+            xsxml_object->node[i]->number_of_contents = fixed_value;
+
             /* Read the number of attributes. */
             dummy_value = read( file_descriptor, 
-                                &xsxml_object->node[i]->number_of_attributes, 
+                                &fixed_value, 
                                 sizeof(UINT_FIXED_BYTES));
 
+            xsxml_object->node[i]->number_of_attributes = fixed_value;
+
             /* Read the node name length. */
             dummy_value = read( file_descriptor, 
                                 &string_len, 
                                 sizeof(UINT_FIXED_BYTES));
 
-            /* The plus one (+1) is for the null terminator. */
-            xsxml_object->node[i]->node_name = (char *) malloc(string_len + 1);
-
-            xsxml_object->node[i]->node_name [string_len] = 0;
-
             /* The plus one (+1) is for the null terminator. */
             char temp_string_1 [string_len + 1];
 
             /* Read the node name. */
             dummy_value = read(file_descriptor, temp_string_1, string_len);
 
-            memcpy( &xsxml_object->node[i]->node_name[0], 
-                    &temp_string_1[0], 
-                    string_len);
+            xsxml_set_node_name( xsxml_object, 
+                                 xsxml_object->node[i], 
+                                 temp_string_1, 
+                                 string_len);
 
             if (xsxml_object->node[i]->number_of_contents == 0)
             {
                 xsxml_object->node[i]->content = 
                 (char **) malloc(sizeof(char *));
+
+                xsxml_object->node[i]->content_length = 
+                (size_t *) malloc(sizeof(size_t));
             }
             else
             {
                 xsxml_object->node[i]->content = 
                 (char **) malloc(xsxml_object->node[i]->number_of_contents * sizeof(char *));
+
+                xsxml_object->node[i]->content_length = 
+                (size_t *) malloc(xsxml_object->node[i]->number_of_contents * sizeof(size_t));
             }
 
-            for (unsigned int j = 0; j < xsxml_object->node[i]->number_of_contents; j++)
+            xsxml_object->memory_usage.pointer_array_bytes += 
+                (sizeof(char *) + sizeof(size_t)) 
+              * (xsxml_object->node[i]->number_of_contents == 0 ? 
+                 1 : xsxml_object->node[i]->number_of_contents);
+
+            for (size_t j = 0; j < xsxml_object->node[i]->number_of_contents; j++)
             {
                 /* Read the jth content length. */
                 dummy_value = read( file_descriptor, 
                                     &string_len, 
                                     sizeof(UINT_FIXED_BYTES));
 
-                /* The plus one (+1) is for the null terminator. */
-                xsxml_object->node[i]->content[j] = (char *) malloc(string_len + 1);
-
-                xsxml_object->node[i]->content[j] [string_len] = 0;
-
                 /* The plus one (+1) is for the null terminator. */
                 char temp_string_2 [string_len + 1];
 
                 /* Read the jth content. */
                 dummy_value = read(file_descriptor, temp_string_2, string_len);
 
-                memcpy( &xsxml_object->node[i]->content[j][0], 
-                        &temp_string_2[0], 
-                        string_len);
+                xsxml_object->node[i]->content[j] = 
+                xsxml_copy_string(xsxml_object, temp_string_2, string_len);
+
+                xsxml_object->node[i]->content_length[j] = string_len;
+
+                xsxml_object->memory_usage.content_bytes += string_len + 1;
             }
 
             if (xsxml_object->node[i]->number_of_attributes == 0)
@@ -467,6 +579,12 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
 
                 xsxml_object->node[i]->attribute_value = 
                 (char **) malloc(sizeof(char *));
+
+                xsxml_object->node[i]->attribute_name_length  = 
+                (size_t *) malloc(sizeof(size_t));
+
+                xsxml_object->node[i]->attribute_value_length = 
+                (size_t *) malloc(sizeof(size_t));
             }
             else
             {
@@ -475,54 +593,69 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
 
                 xsxml_object->node[i]->attribute_value = 
                 (char **) malloc(xsxml_object->node[i]->number_of_attributes * sizeof(char *));
+
+                xsxml_object->node[i]->attribute_name_length  = 
+                (size_t *) malloc(xsxml_object->node[i]->number_of_attributes * sizeof(size_t));
+
+                xsxml_object->node[i]->attribute_value_length = 
+                (size_t *) malloc(xsxml_object->node[i]->number_of_attributes * sizeof(size_t));
             }
 
-            for (unsigned int j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
+            xsxml_object->memory_usage.pointer_array_bytes += 
+                2 * (sizeof(char *) + sizeof(size_t)) 
+              * (xsxml_object->node[i]->number_of_attributes == 0 ? 
+                 1 : xsxml_object->node[i]->number_of_attributes);
+
+            for (size_t j = 0; j < xsxml_object->node[i]->number_of_attributes; j++)
             {
                 /* Read the jth attribute name length. */
                 dummy_value = read( file_descriptor, 
                                     &string_len, 
                                     sizeof(UINT_FIXED_BYTES));
 
-                /* The plus one (+1) is for the null terminator. */
-                xsxml_object->node[i]->attribute_name[j] = (char *) malloc(string_len + 1);
-
-                xsxml_object->node[i]->attribute_name[j] [string_len] = 0;
-
                 /* The plus one (+1) is for the null terminator. */
                 char temp_string_3 [string_len + 1];
 
                 /* Read the jth attribute name. */
                 dummy_value = read(file_descriptor, temp_string_3, string_len);
 
-                memcpy( &xsxml_object->node[i]->attribute_name[j][0], 
-                        &temp_string_3[0], 
-                        string_len);
+                xsxml_object->node[i]->attribute_name[j] = 
+                xsxml_copy_string(xsxml_object, temp_string_3, string_len);
+
+                xsxml_object->node[i]->attribute_name_length[j] = string_len;
+
+                xsxml_object->memory_usage.attribute_bytes += string_len + 1;
 
                 /* Read the jth attribute value length. */
                 dummy_value = read( file_descriptor, 
                                     &string_len, 
                                     sizeof(UINT_FIXED_BYTES));
 
-                /* The plus one (+1) is for the null terminator. */
-                xsxml_object->node[i]->attribute_value[j] = (char *) malloc(string_len + 1);
-
-                xsxml_object->node[i]->attribute_value[j] [string_len] = 0;
-
                 /* The plus one (+1) is for the null terminator. */
                 char temp_string_4 [string_len + 1];
 
                 /* Read the jth attribute name. */
                 dummy_value = read(file_descriptor, temp_string_4, string_len);
 
-                memcpy( &xsxml_object->node[i]->attribute_value[j][0], 
-                        &temp_string_4[0], 
-                        string_len);
+                xsxml_object->node[i]->attribute_value[j] = 
+                xsxml_copy_string(xsxml_object, temp_string_4, string_len);
+
+                xsxml_object->node[i]->attribute_value_length[j] = string_len;
+
+                xsxml_object->memory_usage.attribute_bytes += string_len + 1;
             }
         }
 
 
-        for (unsigned int i = 0; i < xsxml_object->number_of_nodes; i++)
+        /* The node numbers of the ancestor and next sibling nodes are kept */
+        /* in case the subtree ends have to be derived from them.           */
+        UINT_FIXED_BYTES *ancestor_numbers     = 
+        (UINT_FIXED_BYTES *) malloc((xsxml_object->number_of_nodes + 1) * sizeof(UINT_FIXED_BYTES));
+
+        UINT_FIXED_BYTES *next_sibling_numbers = 
+        (UINT_FIXED_BYTES *) malloc((xsxml_object->number_of_nodes + 1) * sizeof(UINT_FIXED_BYTES));
+
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
         {
             UINT_FIXED_BYTES node_number;
 
@@ -531,11 +664,19 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
                                     &node_number, 
                                     sizeof(UINT_FIXED_BYTES));
 
+                ancestor_numbers[i] = node_number;
+
                 if (node_number == 0)
+                {
                     xsxml_object->node[i]->ancestor = NULL;
+                }
                 else
+                {
                     xsxml_object->node[i]->ancestor = xsxml_object->node[node_number - 1];
 
+                    xsxml_object->node[node_number - 1]->number_of_children++;
+                }
+
             /* Read the descendant nodes. */
                 dummy_value = read( file_descriptor, 
                                     &node_number, 
@@ -561,6 +702,8 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
                                     &node_number, 
                                     sizeof(UINT_FIXED_BYTES));
 
+                next_sibling_numbers[i] = node_number;
+
                 if (node_number == 0)
                     xsxml_object->node[i]->next_sibling = NULL;
                 else
@@ -568,6 +711,47 @@ Xsxml *decode_xsxml_binary_object(const char *input_file_path)
         }
 
 
+        for (size_t i = 0; i < xsxml_object->number_of_nodes; i++)
+        {
+            UINT_FIXED_BYTES subtree_end;
+
+            /* Read the subtree ends. */
+            if (read(file_descriptor, &subtree_end, sizeof(UINT_FIXED_BYTES)) 
+            ==  sizeof(UINT_FIXED_BYTES))
+            {
+                xsxml_object->node[i]->subtree_end = subtree_end;
+
+                continue;
+            }
+
+            /* Older binary object files do not have the subtree ends, in   */
+            /* which case they are derived in document order. A node's      */
+            /* subtree ends right before its next sibling, if any, or else  */
+            /* where its ancestor's subtree ends.                           */
+            for (size_t k = 0; k < xsxml_object->number_of_nodes; k++)
+            {
+                if (next_sibling_numbers[k] != 0)
+                {
+                    xsxml_object->node[k]->subtree_end = next_sibling_numbers[k] - 2;
+                }
+                else if (ancestor_numbers[k] != 0)
+                {
+                    xsxml_object->node[k]->subtree_end = 
+                    xsxml_object->node[ancestor_numbers[k] - 1]->subtree_end;
+                }
+                else
+                {
+                    xsxml_object->node[k]->subtree_end = xsxml_object->number_of_nodes - 1;
+                }
+            }
+
+            break;
+        }
+
+        free(ancestor_numbers);
+        free(next_sibling_numbers);
+
+
         close(file_descriptor);
     /* Main operation ends here. */
 
@@ -0,0 +1,215 @@
+/*
+Copyright 2021 Melwyn Francis Carlo <carlo.melwyn@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "xsxml.h"
+
+#include "xsxml_parallel.h"
+
+
+/*
+The multi-threaded occurrence searches, built on the match iterator of 
+xsxml.c; each thread takes one contiguous share of the candidate nodes. 
+Kept apart from xsxml.c so that only its users need POSIX threads.
+*/
+
+
+/* Fewer candidates per thread than these are not worth a thread of their own. */
+#define MIN_CANDIDATES_PER_THREAD 4096
+
+
+typedef struct Xsxml_Occurrence_Thread
+{
+    pthread_t thread;
+    int is_started;
+
+    Xsxml_Match_Iter *match_iter;
+
+    size_t *node_indices;
+    size_t number_of_matches;
+
+} Xsxml_Occurrence_Thread;
+
+
+/* Gathers the matches of the share of the thread, in batches. */
+static void *search_share(void *argument)
+{
+    Xsxml_Occurrence_Thread *occurrence_thread = (Xsxml_Occurrence_Thread *) argument;
+
+    size_t capacity = 0;
+
+    while (1)
+    {
+        if (occurrence_thread->number_of_matches == capacity)
+        {
+            capacity = 2 * capacity + 16;
+
+            occurrence_thread->node_indices = 
+            (size_t *) realloc( occurrence_thread->node_indices, 
+                                capacity * sizeof(size_t));
+        }
+
+        const size_t NUMBER_WANTED = capacity - occurrence_thread->number_of_matches;
+
+        const size_t NUMBER_FOUND = 
+            xsxml_match_iter_next_batch( occurrence_thread->match_iter, 
+                                         &occurrence_thread->node_indices
+                                                 [occurrence_thread->number_of_matches], 
+                                         NUMBER_WANTED);
+
+        occurrence_thread->number_of_matches += NUMBER_FOUND;
+
+        if (NUMBER_FOUND < NUMBER_WANTED) break;
+    }
+
+    return NULL;
+}
+
+
+static size_t *search_in_parallel( Xsxml_Match_Iter *match_iter, 
+                                   size_t number_of_threads)
+{
+    if (number_of_threads == 0)
+    {
+        const long NUMBER_OF_PROCESSORS = sysconf(_SC_NPROCESSORS_ONLN);
+
+        number_of_threads = (NUMBER_OF_PROCESSORS > 0) ? (size_t) NUMBER_OF_PROCESSORS : 1;
+    }
+
+    const size_t NUMBER_OF_CANDIDATES = xsxml_match_iter_number_of_candidates(match_iter);
+
+    const size_t MAX_THREADS = (NUMBER_OF_CANDIDATES / MIN_CANDIDATES_PER_THREAD) + 1;
+
+    if (number_of_threads > MAX_THREADS) number_of_threads = MAX_THREADS;
+
+    /* All the optional members are initialised to zero (0) or NULL. */
+    Xsxml_Occurrence_Thread *occurrence_thread = 
+    (Xsxml_Occurrence_Thread *) calloc(number_of_threads, sizeof(Xsxml_Occurrence_Thread));
+
+    /* The shares are made beforehand, by the calling thread alone. */
+    for (size_t t = 0; t < number_of_threads; t++)
+    {
+        occurrence_thread[t].match_iter = 
+        xsxml_match_iter_share(match_iter, t, number_of_threads);
+    }
+
+    /* The first share is searched by the calling thread itself, as is */
+    /* any share whose thread could not be created.                    */
+    for (size_t t = 1; t < number_of_threads; t++)
+    {
+        occurrence_thread[t].is_started = 
+            (pthread_create( &occurrence_thread[t].thread, 
+                             NULL, 
+                             search_share, 
+                             &occurrence_thread[t]) == 0);
+    }
+
+    for (size_t t = 0; t < number_of_threads; t++)
+    {
+        if (!occurrence_thread[t].is_started) search_share(&occurrence_thread[t]);
+    }
+
+    size_t number_of_matches = 0;
+
+    for (size_t t = 0; t < number_of_threads; t++)
+    {
+        if (occurrence_thread[t].is_started) pthread_join(occurrence_thread[t].thread, NULL);
+
+        number_of_matches += occurrence_thread[t].number_of_matches;
+    }
+
+    /* The shares are in the order of the direction, and so are merged */
+    /* by being placed one after the other.                            */
+    size_t *return_node_indices = 
+    (size_t *) malloc((number_of_matches + 1) * sizeof(size_t));
+
+    return_node_indices[0] = number_of_matches;
+
+    size_t next_position = 1;
+
+    for (size_t t = 0; t < number_of_threads; t++)
+    {
+        if (occurrence_thread[t].number_of_matches > 0)
+        {
+            memcpy( &return_node_indices[next_position], 
+                    occurrence_thread[t].node_indices, 
+                    occurrence_thread[t].number_of_matches * sizeof(size_t));
+        }
+
+        next_position += occurrence_thread[t].number_of_matches;
+
+        free(occurrence_thread[t].node_indices);
+
+        xsxml_match_iter_unset(&occurrence_thread[t].match_iter);
+    }
+
+    free(occurrence_thread);
+
+    return return_node_indices;
+}
+
+
+size_t *xsxml_occurrence_parallel( Xsxml *xsxml_object, 
+                                   char *tag_name, 
+                                   char *attribute_name, 
+                                   char *attribute_value, 
+                                   char *content, 
+                                   Xsxml_Direction direction, 
+                                   size_t number_of_threads)
+{
+    /* The indices of the search are built here, before any thread starts. */
+    Xsxml_Match_Iter *match_iter = xsxml_match_iter_start( xsxml_object, 
+                                                           tag_name, 
+                                                           attribute_name, 
+                                                           attribute_value, 
+                                                           content, 
+                                                           direction);
+
+    size_t *return_node_indices = search_in_parallel(match_iter, number_of_threads);
+
+    xsxml_match_iter_unset(&match_iter);
+
+    return return_node_indices;
+}
+
+
+size_t *xsxml_files_occurrence_parallel( Xsxml_Files *xsxml_files_object, 
+                                         char *tag_name, 
+                                         char *attribute_name, 
+                                         char *attribute_value, 
+                                         char *content, 
+                                         Xsxml_Direction direction, 
+                                         size_t number_of_threads)
+{
+    Xsxml_Match_Iter *match_iter = xsxml_files_match_iter_start( xsxml_files_object, 
+                                                                 tag_name, 
+                                                                 attribute_name, 
+                                                                 attribute_value, 
+                                                                 content, 
+                                                                 direction);
+
+    size_t *return_node_indices = search_in_parallel(match_iter, number_of_threads);
+
+    xsxml_match_iter_unset(&match_iter);
+
+    return return_node_indices;
+}
@@ -0,0 +1,56 @@
+/*
+Copyright 2021 Melwyn Francis Carlo <carlo.melwyn@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+
+#ifndef XSXML_PARALLEL_H
+#define XSXML_PARALLEL_H
+
+
+#include "xsxml.h"
+
+
+/*
+Multi-threaded occurrence functions (POSIX threads only)
+
+The candidate nodes of the search are split into contiguous ranges, one 
+per thread, whose matches are merged in the order of the given direction. 
+The results are the same as those of the xsxml_occurrence() and 
+xsxml_files_occurrence() functions, of which they are a drop-in 
+replacement. A number of threads of zero (0) uses one thread per online 
+processor, whereas small searches use fewer threads than given.
+
+The object must neither be edited nor searched by another thread in the 
+meanwhile, as the indices of the search are built beforehand.
+*/
+extern size_t *xsxml_occurrence_parallel( Xsxml *xsxml_object, 
+                                          char *tag_name, 
+                                          char *attribute_name, 
+                                          char *attribute_value, 
+                                          char *content, 
+                                          Xsxml_Direction direction, 
+                                          size_t number_of_threads);
+
+extern size_t *xsxml_files_occurrence_parallel( Xsxml_Files *xsxml_files_object, 
+                                                char *tag_name, 
+                                                char *attribute_name, 
+                                                char *attribute_value, 
+                                                char *content, 
+                                                Xsxml_Direction direction, 
+                                                size_t number_of_threads);
+
+
+#endif /* XSXML_PARALLEL_H */
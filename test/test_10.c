@@ -0,0 +1,170 @@
+/*
+Copyright 2021 Melwyn Francis Carlo <carlo.melwyn@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "xsxml.h"
+
+
+/*
+To compile:
+gcc -O3 -Wall -std=c17 -Wextra -Wpedantic -pedantic-errors xsxml.c test_10.c -o test_10 -lm
+
+To run:
+./test_10
+
+Output:
+Result Message : The file 'test_10_data.xml' has been successfully parsed.
+
+Result Message : The content of node 0 has been successfully appended.
+
+Node number of 'Three' : 2
+
+Number of nodes (edited)   : 5
+Number of nodes (snapshot) : 5
+
+Outermost node's content (snapshot) : Books:
+
+Result Message : The XSXML object's information has been successfully compiled into file 'test_10_output.xml'.
+
+<?xml version="1.0" encoding="UTF-8"?>
+
+<Shelf>Books:and
+<Book id="b3">
+<Title>Three</Title>
+</Book>
+<Book id="b2">
+<Title>Two</Title>
+</Book>end!</Shelf>
+
+
+Contents of the outermost node (compiled) : 'Books:and' 'end!'
+
+Extracted subtree : 2 nodes, outermost node name : Book
+Clone             : 5 nodes, outermost node name : Shelf
+*/
+
+
+static void print_file(const char *file_name)
+{
+    FILE *xml_file = fopen(file_name, "r");
+
+    int character;
+
+    while ((character = fgetc(xml_file)) != EOF) putchar(character);
+
+    fclose(xml_file);
+}
+
+
+int main()
+{
+    /* The below code is just a test code for debugging purposes. */
+    /* setvbuf(stdout, NULL, _IONBF, 0);                          */
+
+    const char *xml_file_name      = "test_10_data.xml";
+    const char *compiled_file_name = "test_10_output.xml";
+
+    FILE *xml_file = fopen(xml_file_name, "w");
+
+    fprintf( xml_file, 
+             "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<Shelf>Books:"
+             "<Book id=\"b1\"><Title>One</Title></Book>and"
+             "<Book id=\"b2\"><Title>Two</Title></Book>end"
+             "</Shelf>\n");
+
+    fclose(xml_file);
+
+    Xsxml *xml_data = xsxml_parse(xml_file_name);
+
+    printf("\n\nResult Message : %s\n\n", xml_data->result_message);
+
+    /* The snapshot keeps the document as it was before the edits. */
+    Xsxml *snapshot = xsxml_snapshot(xml_data);
+
+    /* A new book in between the two, after the text 'and'. */
+    const size_t BOOK = xsxml_insert_child(xml_data, 0, 1, "Book");
+
+    xsxml_set_attribute(xml_data, BOOK, "id", "b3");
+
+    const size_t TITLE = xsxml_insert_child(xml_data, BOOK, 0, "Title");
+
+    xsxml_append_content(xml_data, TITLE, "Three");
+
+    /* The texts around the first book are joined once it is removed. */
+    xsxml_remove_subtree(xml_data, 1);
+
+    xsxml_append_content(xml_data, 0, "!");
+
+    printf("Result Message : %s\n\n", xml_data->result_message);
+
+    /* The nodes are put back into document order by any search. */
+    const size_t FOUND = xsxml_first_occurrence(xml_data, NULL, NULL, NULL, "Three");
+
+    printf("Node number of 'Three' : %zu\n\n", FOUND);
+
+    printf("Number of nodes (edited)   : %zu\n", xml_data->number_of_nodes);
+    printf("Number of nodes (snapshot) : %zu\n\n", snapshot->number_of_nodes);
+
+    printf("Outermost node's content (snapshot) : %s\n\n", xsxml_content(snapshot, 0, 0));
+
+    xsxml_unset(&snapshot);
+
+    xsxml_compile(xml_data, NULL, compiled_file_name, 0, 0, XSXML_NO_CONVERSION);
+
+    printf("Result Message : %s\n\n", xml_data->result_message);
+
+    print_file(compiled_file_name);
+
+    Xsxml *compiled_data = xsxml_parse(compiled_file_name);
+
+    printf("\nContents of the outermost node (compiled) :");
+
+    for (size_t i = 0; i < compiled_data->node[0]->number_of_contents; i++)
+    {
+        printf(" '%s'", xsxml_content(compiled_data, 0, i));
+    }
+
+    printf("\n\n");
+
+    /* The extracted subtree is an object of its own, with its own indices. */
+    Xsxml *subtree_data = xsxml_extract_subtree(compiled_data, 3);
+
+    Xsxml *clone_data = xsxml_clone(compiled_data);
+
+    printf( "Extracted subtree : %zu nodes, outermost node name : %s\n", 
+            subtree_data->number_of_nodes, 
+            subtree_data->node[0]->node_name);
+
+    printf( "Clone             : %zu nodes, outermost node name : %s\n", 
+            clone_data->number_of_nodes, 
+            clone_data->node[0]->node_name);
+
+    printf("\n\n");
+
+    xsxml_unset(&clone_data);
+    xsxml_unset(&subtree_data);
+    xsxml_unset(&compiled_data);
+    xsxml_unset(&xml_data);
+
+    remove(compiled_file_name);
+    remove(xml_file_name);
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+Copyright 2021 Melwyn Francis Carlo <carlo.melwyn@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "xsxml.h"
+
+
+/*
+To compile:
+gcc -O3 -Wall -std=c17 -Wextra -Wpedantic -pedantic-errors xsxml.c test_11.c -o test_11 -lm
+
+To run:
+./test_11
+
+Output:
+Result Message : The file 'test_11_data_1.xml' has been successfully parsed.
+
+/Shelf/Book[@lang='en']/Title  : 2 6
+//Book[last()]                 : 5
+Batch, Title (backward)        : 6 4 2
+Batch, lang='fr'               : 3
+Prepared, Book                 : 1 3 5
+Prepared, run again            : no
+
+Result Message : The file 'test_11_data_2.xml' has been successfully parsed.
+
+Parsed into                    : yes
+Number of nodes                : 3
+Prepared, Book                 : 1
+//Book[last()]                 : 1
+*/
+
+
+static void write_file( const char *file_name, 
+                        const char *data)
+{
+    FILE *xml_file = fopen(file_name, "w");
+
+    fputs(data, xml_file);
+
+    fclose(xml_file);
+}
+
+
+static void print_nodes( const char *label, 
+                         const size_t *o)
+{
+    printf("%-30s :", label);
+
+    for (size_t i = 1; i <= o[0]; i++) printf(" %zu", o[i]);
+
+    printf("\n");
+}
+
+
+int main()
+{
+    /* The below code is just a test code for debugging purposes. */
+    /* setvbuf(stdout, NULL, _IONBF, 0);                          */
+
+    const char *first_file_name  = "test_11_data_1.xml";
+    const char *second_file_name = "test_11_data_2.xml";
+
+    write_file( first_file_name, 
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<Shelf>\n"
+                "    <Book lang=\"en\"><Title>One</Title></Book>\n"
+                "    <Book lang=\"fr\"><Title>Deux</Title></Book>\n"
+                "    <Book lang=\"en\"><Title>Three</Title></Book>\n"
+                "</Shelf>\n");
+
+    write_file( second_file_name, 
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<Shelf>\n"
+                "    <Book lang=\"fr\"><Title>Quatre</Title></Book>\n"
+                "</Shelf>\n");
+
+    Xsxml *xml_data = xsxml_parse(first_file_name);
+
+    printf("\n\nResult Message : %s\n\n", xml_data->result_message);
+
+    /* A compiled path query may be run on any number of objects. */
+    Xsxml_Query *query = xsxml_query_compile("/Shelf/Book[@lang='en']/Title");
+
+    size_t *o = xsxml_query_run(query, xml_data);
+
+    print_nodes("/Shelf/Book[@lang='en']/Title", o);
+
+    free(o);
+
+    xsxml_query_unset(&query);
+
+    query = xsxml_query_compile("//Book[last()]");
+
+    o = xsxml_query_run(query, xml_data);
+
+    print_nodes("//Book[last()]", o);
+
+    free(o);
+
+    /* Several searches of the same object, at once. */
+    const Xsxml_Occurrence_Query QUERIES[2] = 
+    {
+        { .tag_name = "Title", .direction = XSXML_DIRECTION_BACKWARD }, 
+        { .attribute_name = "lang", .attribute_value = "fr", .direction = XSXML_DIRECTION_FORWARD }
+    };
+
+    size_t *results[2];
+
+    xsxml_occurrence_batch(xml_data, QUERIES, 2, results);
+
+    print_nodes("Batch, Title (backward)", results[0]);
+    print_nodes("Batch, lang='fr'", results[1]);
+
+    free(results[0]);
+    free(results[1]);
+
+    /* A prepared search is only run again once the object has changed. */
+    Xsxml_Prepared_Occurrence *prepared = 
+        xsxml_prepare_occurrence("Book", NULL, NULL, NULL, XSXML_DIRECTION_FORWARD);
+
+    const size_t *first_run  = xsxml_prepared_occurrence_run(prepared, xml_data);
+    const size_t *second_run = xsxml_prepared_occurrence_run(prepared, xml_data);
+
+    print_nodes("Prepared, Book", second_run);
+
+    printf("%-30s : %s\n", "Prepared, run again", (first_run == second_run) ? "no" : "yes");
+
+    /* The object is refilled in place, which changes its generation. */
+    const Xsxml_Result RESULT = xsxml_parse_into(xml_data, second_file_name, 0);
+
+    printf("\nResult Message : %s\n\n", xml_data->result_message);
+
+    printf("%-30s : %s\n", "Parsed into", (RESULT == XSXML_RESULT_SUCCESS) ? "yes" : "no");
+
+    printf("%-30s : %zu\n", "Number of nodes", xml_data->number_of_nodes);
+
+    print_nodes("Prepared, Book", xsxml_prepared_occurrence_run(prepared, xml_data));
+
+    o = xsxml_query_run(query, xml_data);
+
+    print_nodes("//Book[last()]", o);
+
+    free(o);
+
+    printf("\n\n");
+
+    xsxml_prepared_occurrence_unset(&prepared);
+
+    xsxml_query_unset(&query);
+
+    xsxml_unset(&xml_data);
+
+    remove(second_file_name);
+    remove(first_file_name);
+
+    return 0;
+}
@@ -49,7 +49,7 @@ int main()
 
     printf("\n\nThe Xsxml *xml_data structure pointer has been created.\n\n");
 
-    printf("Number of nodes : %d\n\n", xml_data->number_of_nodes);
+    printf("Number of nodes : %zu\n\n", xml_data->number_of_nodes);
 
     printf("Outermost node name : %s\n\n", xml_data->node[0]->node_name);
 
@@ -0,0 +1,156 @@
+/*
+Copyright 2021 Melwyn Francis Carlo <carlo.melwyn@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "xsxml.h"
+
+
+/*
+To compile:
+gcc -O3 -Wall -std=c17 -Wextra -Wpedantic -pedantic-errors xsxml.c test_9.c -o test_9 -lm
+
+To run:
+./test_9
+
+Output:
+Result Message : The file 'test_9_data.xml' has been successfully parsed.
+
+Prefix "Ti"                : Title Title Title
+Glob "*-[0-9][0-9]"        : AB-12 cd-34
+Regex "^[0-9]{6}$"         : 123456
+Regex "^[a-z]+-[0-9]+$"    : cd-34
+Same, case-insensitive     : AB-12 cd-34
+Glob "[[:upper:]]*"        : AB-12 Xyz
+Regex "^[[:alpha:]]+$"     : Xyz abc
+Regex "[^[:alnum:]-]"      : a_b
+Regex "[[:foo:]]"          : The content pattern is invalid at position 2.
+*/
+
+
+static void print_matches( Xsxml *xml_data, 
+                           const char *label, 
+                           Xsxml_Occurrence_Query *query)
+{
+    size_t *o = xsxml_occurrence_query(xml_data, query);
+
+    printf("%-26s :", label);
+
+    if (xml_data->result != XSXML_RESULT_SUCCESS)
+    {
+        printf(" %s", xml_data->result_message);
+    }
+
+    for (size_t i = 1; i <= o[0]; i++)
+    {
+        /* The tag name criteria are reported by their tag names. */
+        if (query->tag_name != NULL)
+        {
+            printf(" %s", xml_data->node[o[i]]->node_name);
+        }
+        else /* if (query->content != NULL) */
+        {
+            printf(" %s", xsxml_content(xml_data, o[i], 0));
+        }
+    }
+
+    printf("\n");
+
+    free(o);
+}
+
+
+int main()
+{
+    /* The below code is just a test code for debugging purposes. */
+    /* setvbuf(stdout, NULL, _IONBF, 0);                          */
+
+    const char *xml_file_name = "test_9_data.xml";
+
+    FILE *xml_file = fopen(xml_file_name, "w");
+
+    fprintf( xml_file, 
+             "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<Shelf>\n"
+             "    <Book><Title>AB-12</Title><Price>123456</Price></Book>\n"
+             "    <Book><Title>cd-34</Title><Price>1234567</Price></Book>\n"
+             "    <Book><Title>Xyz</Title><Tag>abc</Tag><Tag>a_b</Tag></Book>\n"
+             "</Shelf>\n");
+
+    fclose(xml_file);
+
+    Xsxml *xml_data = xsxml_parse(xml_file_name);
+
+    printf("\n\nResult Message : %s\n\n", xml_data->result_message);
+
+    /* The members left out are zero (0), as is XSXML_MATCH_DEFAULT. */
+    Xsxml_Occurrence_Query query = { .tag_name            = "Ti", 
+                                     .tag_name_match_mode = XSXML_MATCH_PREFIX, 
+                                     .direction           = XSXML_DIRECTION_FORWARD };
+
+    print_matches(xml_data, "Prefix \"Ti\"", &query);
+
+    query = (Xsxml_Occurrence_Query) { .content            = "*-[0-9][0-9]", 
+                                       .content_match_mode = XSXML_MATCH_GLOB, 
+                                       .direction          = XSXML_DIRECTION_FORWARD };
+
+    print_matches(xml_data, "Glob \"*-[0-9][0-9]\"", &query);
+
+    query.content            = "^[0-9]{6}$";
+    query.content_match_mode = XSXML_MATCH_REGEX;
+
+    print_matches(xml_data, "Regex \"^[0-9]{6}$\"", &query);
+
+    query.content = "^[a-z]+-[0-9]+$";
+
+    print_matches(xml_data, "Regex \"^[a-z]+-[0-9]+$\"", &query);
+
+    query.is_content_case_insensitive = 1;
+
+    print_matches(xml_data, "Same, case-insensitive", &query);
+
+    query.is_content_case_insensitive = 0;
+
+    /* The named classes of bracket expressions hold ASCII bytes alone. */
+    query.content            = "[[:upper:]]*";
+    query.content_match_mode = XSXML_MATCH_GLOB;
+
+    print_matches(xml_data, "Glob \"[[:upper:]]*\"", &query);
+
+    query.content            = "^[[:alpha:]]+$";
+    query.content_match_mode = XSXML_MATCH_REGEX;
+
+    print_matches(xml_data, "Regex \"^[[:alpha:]]+$\"", &query);
+
+    query.content = "[^[:alnum:]-]";
+
+    print_matches(xml_data, "Regex \"[^[:alnum:]-]\"", &query);
+
+    /* An unknown class name makes the pattern invalid. */
+    query.content = "[[:foo:]]";
+
+    print_matches(xml_data, "Regex \"[[:foo:]]\"", &query);
+
+    printf("\n\n");
+
+    xsxml_unset(&xml_data);
+
+    remove(xml_file_name);
+
+    return 0;
+}